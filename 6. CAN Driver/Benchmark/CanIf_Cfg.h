@@ -0,0 +1,32 @@
+/****************************************************************************************
+*                               CANIF_CFG.H (BENCHMARK)                                *
+****************************************************************************************
+* File Name   : CanIf_Cfg.h
+* Module      : CAN Interface (CanIf)
+* Description : Host benchmark configuration, shadows Config/CanIf/CanIf_Cfg.h
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+***************************************************************************************/
+#ifndef CANIF_BENCH_CFG_H
+#define CANIF_BENCH_CFG_H
+
+/* Project configuration, only the table sizes are enlarged for the benchmark */
+#include "../Config/CanIf/CanIf_Cfg.h"
+
+#undef CANIF_CFG_MAX_CONTROLLERS
+#undef CANIF_CFG_MAX_RX_HRHS
+#undef CANIF_CFG_MAX_RX_PDUS
+#undef CANIF_RX_HASH_TABLE_SIZE
+
+#define CANIF_CFG_MAX_CONTROLLERS              (2U)
+#define CANIF_CFG_MAX_RX_HRHS                  (4U)
+#define CANIF_CFG_MAX_RX_PDUS                  (1024U)
+#define CANIF_RX_HASH_TABLE_SIZE               (2048U)
+
+/* The host has no DWT to time the Tx latency with */
+#undef CANIF_STATISTICS_API
+#define CANIF_STATISTICS_API                   STD_OFF
+
+#endif /* CANIF_BENCH_CFG_H */
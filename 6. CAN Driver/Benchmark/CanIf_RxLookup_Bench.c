@@ -0,0 +1,298 @@
+/****************************************************************************************
+*                               CANIF_RXLOOKUP_BENCH.C                                 *
+****************************************************************************************
+* File Name   : CanIf_RxLookup_Bench.c
+* Module      : CAN Interface (CanIf)
+* Description : Host benchmark of the CanIf Rx PDU lookup (linear scan vs. index)
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+*
+* Build and run on the host from "6. CAN Driver":
+*   gcc -O2 -std=gnu99 -DSTM32F10X_MD -include Benchmark/Host/BxCanSim_Cmsis.h \
+*       -IBenchmark -IMCAL/CanIf -IMCAL/Can -IConfig/CanIf \
+*       -IConfig/Det -IMCAL -ISPL/inc -I"../4. PWM Driver/SPL/inc" -ICMSIS \
+*       Benchmark/CanIf_RxLookup_Bench.c -o CanIf_RxLookup_Bench
+*   ./CanIf_RxLookup_Bench
+*
+* CanIf.c is compiled into this file so the static lookup can be timed directly. The
+* configuration is generated at runtime for 16, 128 and 1024 Rx PDUs, half standard and half
+* extended IDs spread over two controllers, and looked up with 10 % unknown IDs.
+* BxCanSim_Cmsis.h replaces the Cortex-M intrinsics of the CanIf critical sections.
+***************************************************************************************/
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include <stdio.h>
+#include <time.h>
+
+#include "../MCAL/CanIf/CanIf.c"
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+#define BENCH_QUERY_COUNT       (4096U)
+#define BENCH_ROUNDS            (200U)
+#define BENCH_HRH_STD(Ctrl)     ((uint8)((Ctrl) * 2U))
+#define BENCH_HRH_EXT(Ctrl)     ((uint8)((Ctrl) * 2U + 1U))
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+static CanIf_CtrlConfigType Bench_CtrlConfig[CANIF_CFG_MAX_CONTROLLERS];
+static CanIf_HrhConfigType Bench_HrhConfig[CANIF_CFG_MAX_RX_HRHS];
+static CanIf_RxPduConfigType Bench_RxPduConfig[CANIF_CFG_MAX_RX_PDUS];
+static CanIf_ConfigType Bench_Config;
+
+static Can_IdType Bench_QueryId[BENCH_QUERY_COUNT];
+static uint8 Bench_QueryCtrl[BENCH_QUERY_COUNT];
+
+static uint32 Bench_Seed = 0x2545F491UL;
+
+/*==================================================================================================
+*                                   CAN DRIVER STUBS
+==================================================================================================*/
+/* PRIMASK of BxCanSim_Cmsis.h; there is no simulated controller to deliver interrupts from */
+unsigned int BxCanSim_PriMask = 0U;
+
+void BxCanSim_DeliverIrqs(void)
+{
+}
+
+Std_ReturnType Can_SetRxFilter(uint8 Controller, const Can_FilterIdType* IdList, uint16 IdCount)
+{
+    (void)Controller; (void)IdList; (void)IdCount;
+    return E_NOT_OK;
+}
+
+Std_ReturnType Can_GetRxFilterElement(uint8 Controller, Can_HwHandleType Hrh, uint8 FilterMatchIndex,
+                                      Can_FilterIdType* ElementPtr)
+{
+    (void)Controller; (void)Hrh; (void)FilterMatchIndex; (void)ElementPtr;
+    return E_NOT_OK;
+}
+
+Std_ReturnType Can_SetControllerMode(uint8 Controller, Can_ControllerStateType Transition)
+{
+    (void)Controller; (void)Transition;
+    return E_OK;
+}
+
+Std_ReturnType Can_GetControllerErrorState(uint8 ControllerId, Can_ErrorStateType* ErrorStatePtr)
+{
+    (void)ControllerId; (void)ErrorStatePtr;
+    return E_OK;
+}
+
+Std_ReturnType Can_SetBaudrate(uint8 Controller, uint16 BaudRateConfigID)
+{
+    (void)Controller; (void)BaudRateConfigID;
+    return E_OK;
+}
+
+Std_ReturnType Can_Write(Can_HwHandleType Hth, const Can_PduType* PduInfo)
+{
+    (void)Hth; (void)PduInfo;
+    return E_OK;
+}
+
+Std_ReturnType Can_WriteDlc8(Can_HwHandleType Hth, const Can_PduType* PduInfo)
+{
+    (void)Hth; (void)PduInfo;
+    return E_OK;
+}
+
+Std_ReturnType Can_CancelTx(Can_HwHandleType Hth, PduIdType PduId)
+{
+    (void)Hth; (void)PduId;
+    return E_NOT_OK;
+}
+
+void Can_SelectIngressFrame(uint8 Index)
+{
+    (void)Index;
+}
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+static uint32 Bench_Random(void)
+{
+    Bench_Seed ^= Bench_Seed << 13U;
+    Bench_Seed ^= Bench_Seed >> 17U;
+    Bench_Seed ^= Bench_Seed << 5U;
+    return Bench_Seed;
+}
+
+static double Bench_Now(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+/* Linear scan as used before the index, kept as reference */
+static PduIdType Bench_LinearLookup(Can_IdType CanId, uint8 ControllerId)
+{
+    const CanIf_RxPduConfigType* RxPduConfig;
+    PduIdType PduIndex;
+
+    for (PduIndex = 0U; PduIndex <= Bench_Config.CanIfMaxRxPduId; PduIndex++)
+    {
+        RxPduConfig = &Bench_Config.CanIfRxPduConfig[PduIndex];
+        if (((RxPduConfig->RxPduCanId | ((RxPduConfig->RxPduCanIdType == CANIF_EXTENDED) ? CAN_ID_EXTENDED_FLAG : 0U)) == CanId) &&
+            (Bench_Config.CanIfHrhConfig[RxPduConfig->RxPduHrhId].ControllerId == ControllerId))
+        {
+            return PduIndex;
+        }
+    }
+
+    return CANIF_INVALID_PDU_ID;
+}
+
+static boolean Bench_IsUsed(uint16 PduCount, Can_IdType CanId, CanIf_CanIdTypeType IdType, uint8 HrhId)
+{
+    uint16 Index;
+
+    for (Index = 0U; Index < PduCount; Index++)
+    {
+        if ((Bench_RxPduConfig[Index].RxPduCanId == CanId) &&
+            (Bench_RxPduConfig[Index].RxPduCanIdType == IdType) &&
+            (Bench_RxPduConfig[Index].RxPduHrhId == HrhId))
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+static void Bench_Configure(uint16 PduCount)
+{
+    CanIf_RxPduConfigType* RxPdu;
+    uint16 Index;
+    uint8 Ctrl;
+
+    for (Ctrl = 0U; Ctrl < CANIF_CFG_MAX_CONTROLLERS; Ctrl++)
+    {
+        Bench_CtrlConfig[Ctrl].ControllerId = Ctrl;
+        Bench_CtrlConfig[Ctrl].CanControllerId = Ctrl;
+        Bench_CtrlConfig[Ctrl].FirstHrhIndex = BENCH_HRH_STD(Ctrl);
+        Bench_CtrlConfig[Ctrl].HrhCount = 2U;
+
+        Bench_HrhConfig[BENCH_HRH_STD(Ctrl)].ControllerId = Ctrl;
+        Bench_HrhConfig[BENCH_HRH_STD(Ctrl)].HrhId = BENCH_HRH_STD(Ctrl);
+        Bench_HrhConfig[BENCH_HRH_STD(Ctrl)].HohId = CAN_HRH_0;
+        Bench_HrhConfig[BENCH_HRH_STD(Ctrl)].HrhSoftwareFilter = STD_ON;
+        Bench_HrhConfig[BENCH_HRH_EXT(Ctrl)].ControllerId = Ctrl;
+        Bench_HrhConfig[BENCH_HRH_EXT(Ctrl)].HrhId = BENCH_HRH_EXT(Ctrl);
+        Bench_HrhConfig[BENCH_HRH_EXT(Ctrl)].HohId = CAN_HRH_1;
+        Bench_HrhConfig[BENCH_HRH_EXT(Ctrl)].HrhSoftwareFilter = STD_ON;
+    }
+
+    for (Index = 0U; Index < PduCount; Index++)
+    {
+        RxPdu = &Bench_RxPduConfig[Index];
+        Ctrl = (uint8)(Index % CANIF_CFG_MAX_CONTROLLERS);
+        RxPdu->RxPduId = Index;
+        RxPdu->RxPduDlc = 8U;
+        RxPdu->RxPduUserRxIndicationUL = NULL_PTR;
+        RxPdu->RxPduReadNotifyStatus = STD_OFF;
+        RxPdu->RxPduReadData = STD_OFF;
+        RxPdu->RxPduCanIdType = (((Index / CANIF_CFG_MAX_CONTROLLERS) & 1U) != 0U) ? CANIF_EXTENDED : CANIF_STANDARD;
+        RxPdu->RxPduHrhId = (RxPdu->RxPduCanIdType == CANIF_EXTENDED) ? BENCH_HRH_EXT(Ctrl) : BENCH_HRH_STD(Ctrl);
+        do
+        {
+            RxPdu->RxPduCanId = Bench_Random() & ((RxPdu->RxPduCanIdType == CANIF_EXTENDED) ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK);
+        } while (Bench_IsUsed(Index, RxPdu->RxPduCanId, RxPdu->RxPduCanIdType, RxPdu->RxPduHrhId) == TRUE);
+    }
+
+    Bench_Config.CanIfCtrlConfig = Bench_CtrlConfig;
+    Bench_Config.CanIfMaxCtrlId = CANIF_CFG_MAX_CONTROLLERS - 1U;
+    Bench_Config.CanIfHrhConfig = Bench_HrhConfig;
+    Bench_Config.CanIfMaxHrhId = CANIF_CFG_MAX_RX_HRHS - 1U;
+    Bench_Config.CanIfHthConfig = NULL_PTR;
+    Bench_Config.CanIfMaxHthId = 0U;
+    Bench_Config.CanIfRxPduConfig = Bench_RxPduConfig;
+    Bench_Config.CanIfMaxRxPduId = PduCount - 1U;
+    Bench_Config.CanIfTxPduConfig = NULL_PTR;
+    Bench_Config.CanIfMaxTxPduId = 0U;
+
+    /* Received frames: configured PDUs plus 10 % unknown IDs */
+    for (Index = 0U; Index < BENCH_QUERY_COUNT; Index++)
+    {
+        RxPdu = &Bench_RxPduConfig[Bench_Random() % PduCount];
+        Bench_QueryCtrl[Index] = Bench_HrhConfig[RxPdu->RxPduHrhId].ControllerId;
+        Bench_QueryId[Index] = RxPdu->RxPduCanId |
+                               ((RxPdu->RxPduCanIdType == CANIF_EXTENDED) ? CAN_ID_EXTENDED_FLAG : 0U);
+        if ((Bench_Random() % 10U) == 0U)
+        {
+            Bench_QueryId[Index] ^= 0x0400U;
+        }
+    }
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+int main(void)
+{
+    static const uint16 PduCounts[] = { 16U, 128U, 1024U };
+    volatile uint32 Sink = 0U;
+    double Start;
+    double LinearNs;
+    double IndexNs;
+    uint32 Mismatch;
+    uint32 Round;
+    uint16 Query;
+    uint8 Run;
+
+    (void)printf("%8s %14s %14s %10s\n", "Rx PDUs", "linear [ns]", "index [ns]", "speed-up");
+
+    for (Run = 0U; Run < (sizeof(PduCounts) / sizeof(PduCounts[0])); Run++)
+    {
+        Bench_Configure(PduCounts[Run]);
+        CanIf_ModuleState = CANIF_UNINIT;
+        CanIf_Init(&Bench_Config);
+
+        Mismatch = 0U;
+        for (Query = 0U; Query < BENCH_QUERY_COUNT; Query++)
+        {
+            if (Bench_LinearLookup(Bench_QueryId[Query], Bench_QueryCtrl[Query]) !=
+                CanIf_FindRxPduByCanId(Bench_QueryId[Query], Bench_QueryCtrl[Query]))
+            {
+                Mismatch++;
+            }
+        }
+
+        Start = Bench_Now();
+        for (Round = 0U; Round < BENCH_ROUNDS; Round++)
+        {
+            for (Query = 0U; Query < BENCH_QUERY_COUNT; Query++)
+            {
+                Sink += Bench_LinearLookup(Bench_QueryId[Query], Bench_QueryCtrl[Query]);
+            }
+        }
+        LinearNs = (Bench_Now() - Start) / ((double)BENCH_ROUNDS * BENCH_QUERY_COUNT);
+
+        Start = Bench_Now();
+        for (Round = 0U; Round < BENCH_ROUNDS; Round++)
+        {
+            for (Query = 0U; Query < BENCH_QUERY_COUNT; Query++)
+            {
+                Sink += CanIf_FindRxPduByCanId(Bench_QueryId[Query], Bench_QueryCtrl[Query]);
+            }
+        }
+        IndexNs = (Bench_Now() - Start) / ((double)BENCH_ROUNDS * BENCH_QUERY_COUNT);
+
+        (void)printf("%8u %14.1f %14.1f %9.1fx%s\n", PduCounts[Run], LinearNs, IndexNs, LinearNs / IndexNs,
+                     (Mismatch != 0U) ? "  RESULT MISMATCH" : "");
+    }
+
+    return (int)(Sink & 0U);
+}
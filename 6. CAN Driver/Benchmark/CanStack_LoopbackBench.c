@@ -0,0 +1,294 @@
+/****************************************************************************************
+*                               CANSTACK_LOOPBACKBENCH.C                               *
+****************************************************************************************
+* File Name   : CanStack_LoopbackBench.c
+* Module      : CAN Interface (CanIf)
+* Description : Round-trip latency self-test of CanIf and the CAN driver in loopback
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+*
+* Target: link this file with the driver instead of the application CanIf configuration and
+* call CanStack_LoopbackBench_Run from main before anything else uses the stack. The release
+* numbers are the ones measured on the target.
+*
+* Host: Benchmark/Host builds the same file against a register model of the bxCAN, see
+* CanStack_LoopbackBench_Host.c. Host numbers are host cycles of the software path and only
+* serve to catch regressions between commits.
+***************************************************************************************/
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "CanStack_LoopbackBench.h"
+#include "Can.h"
+#include "CanIf.h"
+#include "stm32f10x.h"
+
+#if (CAN_SET_CONTROLLER_TEST_MODE_API == STD_OFF)
+    #error "CanStack_LoopbackBench requires CAN_SET_CONTROLLER_TEST_MODE_API"
+#endif
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+#define BENCH_CONTROLLER            (0U)
+#define BENCH_PDU                   (0U)
+#define BENCH_CAN_ID                (0x123U)
+#define BENCH_DLC                   (8U)
+
+/* Main function calls before a frame or a mode change counts as lost */
+#define BENCH_POLL_LIMIT            (10000U)
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+static CanIf_CtrlConfigType Bench_CtrlConfig[CANIF_CFG_MAX_CONTROLLERS];
+static CanIf_HrhConfigType Bench_HrhConfig[CANIF_CFG_MAX_RX_HRHS];
+static CanIf_HthConfigType Bench_HthConfig[CANIF_CFG_MAX_TX_HTHS];
+static CanIf_RxPduConfigType Bench_RxPduConfig[CANIF_CFG_MAX_RX_PDUS];
+static CanIf_TxPduConfigType Bench_TxPduConfig[CANIF_CFG_MAX_TX_PDUS];
+static CanIf_ConfigType Bench_Config;
+
+static boolean Bench_Initialized = FALSE;
+
+/* Written by the callbacks, possibly from interrupt context */
+static volatile uint32 Bench_RxCycles;
+static volatile uint32 Bench_RxSequence;
+static volatile boolean Bench_Received;
+static volatile boolean Bench_Confirmed;
+
+static uint32 Bench_Sample[CANSTACK_BENCH_MAX_FRAMES];
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+static void Bench_RxIndication(PduIdType RxPduId, const PduInfoType* PduInfoPtr);
+static void Bench_TxConfirmation(PduIdType TxPduId);
+static void Bench_BuildConfig(void);
+static boolean Bench_WaitMode(CanIf_ControllerModeType Mode);
+static void Bench_Sort(uint32* Sample, uint32 Count);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+static void Bench_RxIndication(PduIdType RxPduId, const PduInfoType* PduInfoPtr)
+{
+    (void)RxPduId;
+
+    Bench_RxCycles = DWT->CYCCNT;
+    Bench_RxSequence = (uint32)PduInfoPtr->SduDataPtr[0] |
+                       ((uint32)PduInfoPtr->SduDataPtr[1] << 8U) |
+                       ((uint32)PduInfoPtr->SduDataPtr[2] << 16U) |
+                       ((uint32)PduInfoPtr->SduDataPtr[3] << 24U);
+    Bench_Received = TRUE;
+}
+
+static void Bench_TxConfirmation(PduIdType TxPduId)
+{
+    (void)TxPduId;
+
+    Bench_Confirmed = TRUE;
+}
+
+/**
+ * @brief   One Tx PDU on BasicCAN CAN_HTH_0 and the Rx PDU with the same ID on CAN_HRH_0
+ */
+static void Bench_BuildConfig(void)
+{
+    Bench_CtrlConfig[0].ControllerId = BENCH_CONTROLLER;
+    Bench_CtrlConfig[0].CanControllerId = CAN_CONTROLLER_0_ID;
+    Bench_CtrlConfig[0].WakeupSupport = STD_OFF;
+    Bench_CtrlConfig[0].FirstHthIndex = 0U;
+    Bench_CtrlConfig[0].HthCount = 1U;
+    Bench_CtrlConfig[0].FirstHrhIndex = 0U;
+    Bench_CtrlConfig[0].HrhCount = 1U;
+
+    Bench_HthConfig[0].ControllerId = BENCH_CONTROLLER;
+    Bench_HthConfig[0].HthId = 0U;
+    Bench_HthConfig[0].HohId = CAN_HTH_0;
+    Bench_HthConfig[0].HthCanIdType = CANIF_STANDARD;
+
+    Bench_HrhConfig[0].ControllerId = BENCH_CONTROLLER;
+    Bench_HrhConfig[0].HrhId = 0U;
+    Bench_HrhConfig[0].HohId = CAN_HRH_0;
+    Bench_HrhConfig[0].HrhRangeConfig.HrhRangeBaseId = 0x000U;
+    Bench_HrhConfig[0].HrhRangeConfig.HrhRangeMask = 0x7FFU;
+    Bench_HrhConfig[0].HrhRangeConfig.HrhRangeType = CANIF_STANDARD;
+    Bench_HrhConfig[0].HrhSoftwareFilter = STD_ON;
+
+    Bench_TxPduConfig[0].TxPduId = BENCH_PDU;
+    Bench_TxPduConfig[0].TxPduCanId = BENCH_CAN_ID;
+    Bench_TxPduConfig[0].TxPduCanIdType = CANIF_STANDARD;
+    Bench_TxPduConfig[0].TxPduDlc = BENCH_DLC;
+    Bench_TxPduConfig[0].TxPduHthId = 0U;
+    Bench_TxPduConfig[0].TxPduUserTxConfirmationUL = Bench_TxConfirmation;
+    Bench_TxPduConfig[0].TxPduUserTxConfirmationName = "Bench_TxConfirmation";
+    Bench_TxPduConfig[0].TxPduTxConfirmation = STD_ON;
+    Bench_TxPduConfig[0].TxPduType = CANIF_STATIC;
+
+    Bench_RxPduConfig[0].RxPduId = BENCH_PDU;
+    Bench_RxPduConfig[0].RxPduCanId = BENCH_CAN_ID;
+    Bench_RxPduConfig[0].RxPduCanIdType = CANIF_STANDARD;
+    Bench_RxPduConfig[0].RxPduDlc = BENCH_DLC;
+    Bench_RxPduConfig[0].RxPduHrhId = 0U;
+    Bench_RxPduConfig[0].RxPduUserRxIndicationUL = Bench_RxIndication;
+    Bench_RxPduConfig[0].RxPduUserRxIndicationName = "Bench_RxIndication";
+    /* Indicated from Can_MainFunction_Read, not deferred to CanIf_MainFunction */
+    Bench_RxPduConfig[0].RxPduPriority = CANIF_RX_PRIORITY_HIGH;
+
+    Bench_Config.CanIfCtrlConfig = Bench_CtrlConfig;
+    Bench_Config.CanIfMaxCtrlId = 0U;
+    Bench_Config.CanIfHrhConfig = Bench_HrhConfig;
+    Bench_Config.CanIfMaxHrhId = 0U;
+    Bench_Config.CanIfHthConfig = Bench_HthConfig;
+    Bench_Config.CanIfMaxHthId = 0U;
+    Bench_Config.CanIfRxPduConfig = Bench_RxPduConfig;
+    Bench_Config.CanIfMaxRxPduId = 0U;
+    Bench_Config.CanIfTxPduConfig = Bench_TxPduConfig;
+    Bench_Config.CanIfMaxTxPduId = 0U;
+}
+
+static boolean Bench_WaitMode(CanIf_ControllerModeType Mode)
+{
+    CanIf_ControllerModeType Current = CANIF_CS_UNINIT;
+    uint32 Poll;
+
+    for (Poll = 0U; Poll < BENCH_POLL_LIMIT; Poll++)
+    {
+        Can_MainFunction_Mode();
+        if ((CanIf_GetControllerMode(BENCH_CONTROLLER, &Current) == E_OK) && (Current == Mode))
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/* Insertion sort: the samples arrive nearly sorted and the target has no qsort budget */
+static void Bench_Sort(uint32* Sample, uint32 Count)
+{
+    uint32 Index;
+    uint32 Hole;
+    uint32 Value;
+
+    for (Index = 1U; Index < Count; Index++)
+    {
+        Value = Sample[Index];
+        for (Hole = Index; (Hole > 0U) && (Sample[Hole - 1U] > Value); Hole--)
+        {
+            Sample[Hole] = Sample[Hole - 1U];
+        }
+        Sample[Hole] = Value;
+    }
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+Std_ReturnType CanStack_LoopbackBench_Run(uint8 TestMode, uint32 FrameCount,
+                                          CanStack_LoopbackBenchResultType* ResultPtr)
+{
+    uint8 Data[BENCH_DLC] = { 0U };
+    PduInfoType PduInfo;
+    uint64 Sum = 0U;
+    uint32 Sequence;
+    uint32 Start;
+    uint32 Poll;
+    uint32 Count = 0U;
+
+    if ((ResultPtr == NULL_PTR) || (FrameCount == 0U) || (FrameCount > CANSTACK_BENCH_MAX_FRAMES) ||
+        ((TestMode != CAN_TEST_MODE_LOOPBACK) && (TestMode != CAN_TEST_MODE_SILENT_LOOPBACK)))
+    {
+        return E_NOT_OK;
+    }
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    if (Bench_Initialized == FALSE)
+    {
+        Bench_BuildConfig();
+        Can_Init(&Can_Config);
+        CanIf_Init(&Bench_Config);
+        Bench_Initialized = TRUE;
+    }
+
+    /* Can_Init and every previous run leave the controller stopped */
+    if ((Can_SetControllerTestMode(CAN_CONTROLLER_0_ID, TestMode) != E_OK) ||
+        (CanIf_SetControllerMode(BENCH_CONTROLLER, CANIF_CS_STARTED) != E_OK) ||
+        (Bench_WaitMode(CANIF_CS_STARTED) == FALSE))
+    {
+        return E_NOT_OK;
+    }
+
+    PduInfo.SduDataPtr = Data;
+    PduInfo.MetaDataPtr = NULL_PTR;
+    PduInfo.SduLength = BENCH_DLC;
+
+    ResultPtr->Lost = 0U;
+    for (Sequence = 0U; Sequence < FrameCount; Sequence++)
+    {
+        Data[0] = (uint8)Sequence;
+        Data[1] = (uint8)(Sequence >> 8U);
+        Data[2] = (uint8)(Sequence >> 16U);
+        Data[3] = (uint8)(Sequence >> 24U);
+        Bench_Received = FALSE;
+        Bench_Confirmed = FALSE;
+
+        Start = DWT->CYCCNT;
+        if (CanIf_Transmit(BENCH_PDU, &PduInfo) != E_OK)
+        {
+            ResultPtr->Lost++;
+            continue;
+        }
+
+        for (Poll = 0U; (Bench_Received == FALSE) && (Poll < BENCH_POLL_LIMIT); Poll++)
+        {
+            Can_MainFunction_Read();
+        }
+
+        if ((Bench_Received == TRUE) && (Bench_RxSequence == Sequence))
+        {
+            /* Modulo 2^32 like DWT_CYCCNT, also where uint32 is wider than the counter */
+            Bench_Sample[Count] = (Bench_RxCycles - Start) & 0xFFFFFFFFUL;
+            Sum += Bench_Sample[Count];
+            Count++;
+        }
+        else
+        {
+            ResultPtr->Lost++;
+        }
+
+#if (CAN_TX_PROCESSING == POLLING)
+        /* Release the mailbox before the next frame, outside the measurement */
+        for (Poll = 0U; (Bench_Confirmed == FALSE) && (Poll < BENCH_POLL_LIMIT); Poll++)
+        {
+            Can_MainFunction_Write();
+        }
+#endif
+    }
+
+    (void)CanIf_SetControllerMode(BENCH_CONTROLLER, CANIF_CS_STOPPED);
+    (void)Bench_WaitMode(CANIF_CS_STOPPED);
+
+    ResultPtr->FrameCount = Count;
+    ResultPtr->Min = 0U;
+    ResultPtr->Avg = 0U;
+    ResultPtr->Max = 0U;
+    ResultPtr->P99 = 0U;
+    if (Count != 0U)
+    {
+        Bench_Sort(Bench_Sample, Count);
+        ResultPtr->Min = Bench_Sample[0];
+        ResultPtr->Avg = (uint32)(Sum / Count);
+        ResultPtr->Max = Bench_Sample[Count - 1U];
+        ResultPtr->P99 = Bench_Sample[(((Count * 99U) + 99U) / 100U) - 1U];
+    }
+
+    return E_OK;
+}
@@ -0,0 +1,86 @@
+/****************************************************************************************
+*                               CANSTACK_LOOPBACKBENCH.H                               *
+****************************************************************************************
+* File Name   : CanStack_LoopbackBench.h
+* Module      : CAN Interface (CanIf)
+* Description : Round-trip latency self-test of CanIf and the CAN driver in loopback
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+***************************************************************************************/
+#ifndef CANSTACK_LOOPBACKBENCH_H
+#define CANSTACK_LOOPBACKBENCH_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Std_Types.h"
+#include "Can_Cfg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/**
+ * @brief   Largest Run
+ * @details Every round trip is kept for the percentile, one uint32 per frame.
+ */
+#define CANSTACK_BENCH_MAX_FRAMES           (1000U)
+
+/*==================================================================================================
+*                          GLOBAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/**
+ * @brief   Round-trip Statistics
+ * @details Core clock cycles (DWT_CYCCNT) from CanIf_Transmit to the Rx indication of the same
+ *          frame looped back by the controller.
+ */
+typedef struct
+{
+    uint32  FrameCount;         /**< Round trips measured */
+    uint32  Lost;               /**< Frames refused by CanIf_Transmit or not received back */
+    uint32  Min;                /**< Shortest round trip */
+    uint32  Avg;                /**< Mean round trip */
+    uint32  Max;                /**< Longest round trip */
+    uint32  P99;                /**< 99th percentile (nearest rank) */
+} CanStack_LoopbackBenchResultType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief   Measure the round trip through the full stack
+ * @details Takes over the stack: the first call initializes the CAN driver with Can_Config and
+ *          CanIf with a one-PDU configuration of its own, so neither may have been initialized
+ *          before. Controller CAN_CONTROLLER_0_ID is stopped, switched to TestMode and started,
+ *          then FrameCount frames go out one at a time through CanIf_Transmit on BasicCAN
+ *          CAN_HTH_0 and come back through the receive path of the driver into CanIf_RxIndication
+ *          and the upper layer callback. The main functions are polled between frames, so the
+ *          result holds for every CAN_RX_PROCESSING and CAN_TX_PROCESSING setting. The
+ *          controller is stopped again on return.
+ *
+ *          On the target the round trip includes the frame time on the bus; on the host model
+ *          the bus takes no time and the result is the software path only.
+ *
+ * @param[in]   TestMode        CAN_TEST_MODE_LOOPBACK or CAN_TEST_MODE_SILENT_LOOPBACK
+ * @param[in]   FrameCount      1 .. CANSTACK_BENCH_MAX_FRAMES
+ * @param[out]  ResultPtr       Round-trip statistics
+ *
+ * @return      Std_ReturnType  E_OK: Result valid (Lost may be non-zero)
+ *                              E_NOT_OK: Invalid parameter or the controller did not start
+ */
+Std_ReturnType CanStack_LoopbackBench_Run(uint8 TestMode, uint32 FrameCount,
+                                          CanStack_LoopbackBenchResultType* ResultPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CANSTACK_LOOPBACKBENCH_H */
@@ -0,0 +1,813 @@
+/****************************************************************************************
+*                               BXCANSIM.C                                             *
+****************************************************************************************
+* File Name   : BxCanSim.c
+* Module      : Controller Area Network (CAN)
+* Description : Host register model of the STM32F10x bxCAN (CAN1) for x86-64 Linux
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+*
+* After BxCanSim_Init the program runs with the trap flag set: every instruction traps (SIGTRAP)
+* and is counted, and the count is DWT_CYCCNT. The CAN1 page is read-only and the DWT page
+* inaccessible, so a write to CAN1 or any access to the DWT faults (SIGSEGV) first. The fault
+* handler opens the page and remembers the old value of the word; the instruction then runs once,
+* and the trap after it applies the register semantics to the written value and closes the page
+* again. The model keeps its own state (FIFO contents, request order) in ordinary variables.
+* Signal handlers run with the trap flag cleared, so the model itself is never counted.
+***************************************************************************************/
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+#include "BxCanSim.h"
+#include "stm32f10x.h"
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+#define BXCANSIM_PAGE_SIZE                  (0x1000UL)
+#define BXCANSIM_PAGE(Address)              ((uintptr_t)(Address) & ~(uintptr_t)(BXCANSIM_PAGE_SIZE - 1U))
+
+/* Mapped regions: APB1, APB2 and the AHB up to RCC; the private peripheral bus */
+#define BXCANSIM_APB_BASE                   (0x40000000UL)
+#define BXCANSIM_APB_SIZE                   (0x00024000UL)
+#define BXCANSIM_PPB_BASE                   (0xE0000000UL)
+#define BXCANSIM_PPB_SIZE                   (0x00010000UL)
+
+#define BXCANSIM_CAN_PAGE                   BXCANSIM_PAGE(CAN1_BASE)
+#define BXCANSIM_DWT_PAGE                   BXCANSIM_PAGE(DWT_BASE)
+
+/* x86 page fault error code: write access; EFLAGS trap flag */
+#define BXCANSIM_PF_WRITE                   (0x2UL)
+#define BXCANSIM_EFLAGS_TF                  (0x100UL)
+
+/* 72 MHz from an 8 MHz HSE: SW = SWS = PLL, PLLSRC = HSE, PLLMUL = 9, PPRE1 = /2 */
+#define BXCANSIM_RCC_CFGR_72MHZ             (0x001D040AUL)
+
+#define BXCANSIM_FIFO_DEPTH                 (3U)
+#define BXCANSIM_MAILBOX_COUNT              (3U)
+#if defined(STM32F10X_CL)
+#define BXCANSIM_CAN1_FILTER_BANKS()        ((uint8)((CAN1->FMR >> 8U) & 0x3FU))
+#else
+#define BXCANSIM_CAN1_FILTER_BANKS()        (14U)
+#endif
+
+/* Handlers are called until no line is pending; a line that never clears is a driver bug */
+#define BXCANSIM_IRQ_LIMIT                  (1000U)
+
+/* Interrupt lines in NVIC order, all CAN interrupts share one priority */
+#define BXCANSIM_IRQ_TX                     (0x1U)
+#define BXCANSIM_IRQ_RX0                    (0x2U)
+#define BXCANSIM_IRQ_RX1                    (0x4U)
+#define BXCANSIM_IRQ_SCE                    (0x8U)
+
+/* bxCAN register reset values (RM0008) */
+#define BXCANSIM_MCR_RESET                  (0x00010002UL)
+#define BXCANSIM_MSR_RESET                  (0x00000C02UL)
+#define BXCANSIM_TSR_RESET                  (0x1C000000UL)
+#define BXCANSIM_BTR_RESET                  (0x01230000UL)
+#define BXCANSIM_FMR_RESET                  (0x2A1C0E01UL)
+
+#if defined(STM32F10X_CL)
+#define BXCANSIM_TX_IRQ_HANDLER             CAN1_TX_IRQHandler
+#define BXCANSIM_RX0_IRQ_HANDLER            CAN1_RX0_IRQHandler
+#else
+#define BXCANSIM_TX_IRQ_HANDLER             USB_HP_CAN1_TX_IRQHandler
+#define BXCANSIM_RX0_IRQ_HANDLER            USB_LP_CAN1_RX0_IRQHandler
+#endif
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/**
+ * @brief   Access in Flight
+ * @details Set by the fault handler, consumed by the single-step handler.
+ */
+typedef struct
+{
+    uintptr_t   Page;           /**< Page opened for the access */
+    uint32_t*   Register;       /**< Accessed word */
+    uint32_t    Old;            /**< Value before the access */
+    boolean     Write;          /**< The instruction writes */
+    boolean     Active;         /**< Between fault and single-step */
+} BxCanSim_AccessType;
+
+/**
+ * @brief   Received Frame
+ */
+typedef struct
+{
+    uint32  Rir;
+    uint32  Rdtr;
+    uint32  Rdlr;
+    uint32  Rdhr;
+} BxCanSim_FrameType;
+
+/**
+ * @brief   Receive FIFO
+ */
+typedef struct
+{
+    BxCanSim_FrameType  Frame[BXCANSIM_FIFO_DEPTH];
+    uint8               Count;
+    boolean             Full;
+    boolean             Overrun;
+} BxCanSim_FifoType;
+
+/**
+ * @brief   Best Filter Match
+ * @details Rank orders matches as RM0008: 32-bit before 16-bit scale, list before mask mode,
+ *          then the lower filter number; a lower Rank wins.
+ */
+typedef struct
+{
+    uint32  Rank;
+    uint8   Fifo;
+    uint8   Fmi;
+    boolean Found;
+} BxCanSim_MatchType;
+
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+unsigned int BxCanSim_PriMask = 0U;
+
+/* system_stm32f10x.c is not part of the host build */
+uint32_t SystemCoreClock = 72000000UL;
+
+/* Interrupt handlers of the driver; lines without a handler are never delivered */
+extern void BXCANSIM_TX_IRQ_HANDLER(void) __attribute__((weak));
+extern void BXCANSIM_RX0_IRQ_HANDLER(void) __attribute__((weak));
+extern void CAN1_RX1_IRQHandler(void) __attribute__((weak));
+extern void CAN1_SCE_IRQHandler(void) __attribute__((weak));
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+static volatile BxCanSim_AccessType BxCanSim_Access;
+
+/* DWT_CYCCNT: instructions retired since BxCanSim_Init, less the base a CYCCNT write sets */
+static volatile uint64 BxCanSim_Instructions = 0U;
+static uint64 BxCanSim_CycleBase = 0U;
+
+static BxCanSim_FifoType BxCanSim_Fifo[2];
+static uint32 BxCanSim_RequestOrder[BXCANSIM_MAILBOX_COUNT];
+static uint32 BxCanSim_RequestCount = 0U;
+
+/* Interrupt lines pending after the last register write */
+static volatile uint32 BxCanSim_IrqPending = 0U;
+static boolean BxCanSim_InHandler = FALSE;
+
+static BxCanSim_StatsType BxCanSim_Stats;
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+static uint32 BxCanSim_Now(void);
+static uint16 BxCanSim_BitTime(void);
+static void BxCanSim_Reset(void);
+static void BxCanSim_FifoLoad(uint8 Fifo);
+static void BxCanSim_FifoRelease(uint8 Fifo);
+static void BxCanSim_Match(uint32 Rir, BxCanSim_MatchType* MatchPtr);
+static void BxCanSim_Receive(const BxCanSim_FrameType* Frame);
+static uint32 BxCanSim_Arbitration(uint8 Mailbox);
+static void BxCanSim_Transmit(uint8 Mailbox);
+static void BxCanSim_Service(void);
+static void BxCanSim_UpdateTsr(void);
+static void BxCanSim_UpdateIrqs(void);
+static void BxCanSim_CanWrite(uint32 Offset, uint32 Value, uint32 Old);
+static void BxCanSim_OnFault(int Signal, siginfo_t* Info, void* Context);
+static void BxCanSim_OnStep(int Signal, siginfo_t* Info, void* Context);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+/**
+ * @brief   DWT_CYCCNT: one instruction is one cycle
+ */
+static uint32 BxCanSim_Now(void)
+{
+    return (uint32)(BxCanSim_Instructions - BxCanSim_CycleBase);
+}
+
+/**
+ * @brief   TTCM counter value
+ * @details The counter counts bit times of the BTR setting; one bit time is the number of core
+ *          clock cycles the driver derives from CAN_BTR, with DWT_CYCCNT as core clock.
+ */
+static uint16 BxCanSim_BitTime(void)
+{
+    uint32 Btr = CAN1->BTR;
+    uint32 BitCycles = 2U * ((Btr & CAN_BTR_BRP) + 1U) *
+                       (3U + ((Btr & CAN_BTR_TS1) >> 16U) + ((Btr & CAN_BTR_TS2) >> 20U));
+
+    return (uint16)(BxCanSim_Now() / BitCycles);
+}
+
+static void BxCanSim_Reset(void)
+{
+    CAN1->MCR = BXCANSIM_MCR_RESET;
+    CAN1->MSR = BXCANSIM_MSR_RESET;
+    CAN1->TSR = BXCANSIM_TSR_RESET;
+    CAN1->BTR = BXCANSIM_BTR_RESET;
+    CAN1->FMR = BXCANSIM_FMR_RESET;
+
+    (void)memset(BxCanSim_Fifo, 0, sizeof(BxCanSim_Fifo));
+    BxCanSim_RequestCount = 0U;
+}
+
+/**
+ * @brief   Show the oldest frame of a FIFO in its output mailbox
+ */
+static void BxCanSim_FifoLoad(uint8 Fifo)
+{
+    BxCanSim_FifoType* Queue = &BxCanSim_Fifo[Fifo];
+    volatile uint32_t* Rfr = (Fifo == 0U) ? &CAN1->RF0R : &CAN1->RF1R;
+
+    if (Queue->Count != 0U)
+    {
+        CAN1->sFIFOMailBox[Fifo].RIR = Queue->Frame[0].Rir;
+        CAN1->sFIFOMailBox[Fifo].RDTR = Queue->Frame[0].Rdtr;
+        CAN1->sFIFOMailBox[Fifo].RDLR = Queue->Frame[0].Rdlr;
+        CAN1->sFIFOMailBox[Fifo].RDHR = Queue->Frame[0].Rdhr;
+    }
+
+    *Rfr = (uint32)Queue->Count |
+           ((Queue->Full == TRUE) ? CAN_RF0R_FULL0 : 0U) |
+           ((Queue->Overrun == TRUE) ? CAN_RF0R_FOVR0 : 0U);
+}
+
+static void BxCanSim_FifoRelease(uint8 Fifo)
+{
+    BxCanSim_FifoType* Queue = &BxCanSim_Fifo[Fifo];
+    uint8 Index;
+
+    if (Queue->Count == 0U)
+    {
+        return;
+    }
+
+    for (Index = 1U; Index < Queue->Count; Index++)
+    {
+        Queue->Frame[Index - 1U] = Queue->Frame[Index];
+    }
+    Queue->Count--;
+    Queue->Full = FALSE;
+}
+
+/**
+ * @brief   Run a frame through the acceptance filters of CAN1
+ * @details Filter numbers count the elements of all banks assigned to a FIFO in bank order,
+ *          active or not: one for a 32-bit mask bank, two for a 32-bit list or 16-bit mask bank,
+ *          four for a 16-bit list bank.
+ */
+static void BxCanSim_Match(uint32 Rir, BxCanSim_MatchType* MatchPtr)
+{
+    uint32 Image32 = Rir & ~(uint32)1U;
+    uint32 Image16 = ((Rir >> 21U) << 5U) | (((Rir >> 1U) & 1U) << 4U) |
+                     (((Rir >> 2U) & 1U) << 3U) | ((Rir >> 18U) & 7U);
+    uint8 Number[2] = { 0U, 0U };
+    uint8 Banks = BXCANSIM_CAN1_FILTER_BANKS();
+    uint8 Bank;
+    uint8 Element;
+
+    MatchPtr->Found = FALSE;
+    MatchPtr->Rank = 0U;
+    MatchPtr->Fifo = 0U;
+    MatchPtr->Fmi = 0U;
+
+    for (Bank = 0U; Bank < Banks; Bank++)
+    {
+        uint32 Bit = (uint32)1U << Bank;
+        uint8 Fifo = ((CAN1->FFA1R & Bit) != 0U) ? 1U : 0U;
+        boolean Scale32 = ((CAN1->FS1R & Bit) != 0U) ? TRUE : FALSE;
+        boolean List = ((CAN1->FM1R & Bit) != 0U) ? TRUE : FALSE;
+        uint32 Fr1 = CAN1->sFilterRegister[Bank].FR1;
+        uint32 Fr2 = CAN1->sFilterRegister[Bank].FR2;
+        uint32 Id[4];
+        uint32 Mask[4];
+        uint8 Elements;
+
+        if (Scale32 == TRUE)
+        {
+            Elements = (List == TRUE) ? 2U : 1U;
+            Id[0] = Fr1;
+            Mask[0] = (List == TRUE) ? 0xFFFFFFFFUL : Fr2;
+            Id[1] = Fr2;
+            Mask[1] = 0xFFFFFFFFUL;
+        }
+        else
+        {
+            Elements = (List == TRUE) ? 4U : 2U;
+            if (List == TRUE)
+            {
+                Id[0] = Fr1 & 0xFFFFU;
+                Id[1] = Fr1 >> 16U;
+                Id[2] = Fr2 & 0xFFFFU;
+                Id[3] = Fr2 >> 16U;
+                Mask[0] = Mask[1] = Mask[2] = Mask[3] = 0xFFFFU;
+            }
+            else
+            {
+                Id[0] = Fr1 & 0xFFFFU;
+                Mask[0] = Fr1 >> 16U;
+                Id[1] = Fr2 & 0xFFFFU;
+                Mask[1] = Fr2 >> 16U;
+            }
+        }
+
+        for (Element = 0U; Element < Elements; Element++)
+        {
+            uint8 Fmi = Number[Fifo]++;
+            uint32 Image = (Scale32 == TRUE) ? Image32 : Image16;
+            uint32 Care = (Scale32 == TRUE) ? (Mask[Element] & ~(uint32)1U) : Mask[Element];
+            uint32 Rank = ((Scale32 == TRUE) ? 0U : 0x20000U) + ((List == TRUE) ? 0U : 0x10000U) +
+                          ((uint32)Fifo << 8U) + Fmi;
+
+            if (((CAN1->FA1R & Bit) == 0U) || (((Image ^ Id[Element]) & Care) != 0U))
+            {
+                continue;
+            }
+
+            if ((MatchPtr->Found == FALSE) || (Rank < MatchPtr->Rank))
+            {
+                MatchPtr->Found = TRUE;
+                MatchPtr->Rank = Rank;
+                MatchPtr->Fifo = Fifo;
+                MatchPtr->Fmi = Fmi;
+            }
+        }
+    }
+}
+
+static void BxCanSim_Receive(const BxCanSim_FrameType* Frame)
+{
+    BxCanSim_MatchType Match;
+    BxCanSim_FifoType* Queue;
+    BxCanSim_FrameType Received = *Frame;
+
+    /* Reception through the filters is suspended while they are initialized */
+    if ((CAN1->FMR & CAN_FMR_FINIT) != 0U)
+    {
+        BxCanSim_Stats.FramesFiltered++;
+        return;
+    }
+
+    BxCanSim_Match(Frame->Rir, &Match);
+    if (Match.Found == FALSE)
+    {
+        BxCanSim_Stats.FramesFiltered++;
+        return;
+    }
+
+    Queue = &BxCanSim_Fifo[Match.Fifo];
+    Received.Rdtr = (Received.Rdtr & ~(uint32)CAN_RDT0R_FMI) | ((uint32)Match.Fmi << 8U);
+
+    if (Queue->Count == BXCANSIM_FIFO_DEPTH)
+    {
+        Queue->Overrun = TRUE;
+        BxCanSim_Stats.FifoOverruns++;
+        if ((CAN1->MCR & CAN_MCR_RFLM) != 0U)
+        {
+            /* Locked: the new frame is discarded */
+            return;
+        }
+        /* Not locked: the last frame is overwritten */
+        Queue->Count--;
+    }
+
+    Queue->Frame[Queue->Count] = Received;
+    Queue->Count++;
+    Queue->Full = (Queue->Count == BXCANSIM_FIFO_DEPTH) ? TRUE : FALSE;
+    BxCanSim_Stats.FramesReceived++;
+
+    BxCanSim_FifoLoad(Match.Fifo);
+}
+
+/**
+ * @brief   Arbitration field of a mailbox as sent on the bus, a lower value wins
+ * @details STID, RTR or SRR, IDE, EXID[17:0], RTR of an extended frame.
+ */
+static uint32 BxCanSim_Arbitration(uint8 Mailbox)
+{
+    uint32 Tir = CAN1->sTxMailBox[Mailbox].TIR;
+    uint32 Extended = (Tir >> 2U) & 1U;
+    uint32 Remote = (Tir >> 1U) & 1U;
+
+    return ((Tir >> 21U) << 21U) |
+           (((Extended != 0U) ? 1U : Remote) << 20U) |
+           (Extended << 19U) |
+           ((Extended != 0U) ? ((((Tir >> 3U) & 0x3FFFFU) << 1U) | Remote) : 0U);
+}
+
+static void BxCanSim_Transmit(uint8 Mailbox)
+{
+    CAN_TxMailBox_TypeDef* Tx = &CAN1->sTxMailBox[Mailbox];
+    BxCanSim_FrameType Frame;
+    uint32 Shift = 8U * Mailbox;
+
+    if ((CAN1->MCR & CAN_MCR_TTCM) != 0U)
+    {
+        Tx->TDTR = (Tx->TDTR & 0x0000FFFFUL) | ((uint32)BxCanSim_BitTime() << 16U);
+        if (((Tx->TDTR & CAN_TDT0R_TGT) != 0U) && ((Tx->TDTR & CAN_TDT0R_DLC) == 8U))
+        {
+            Tx->TDHR = (Tx->TDHR & 0x0000FFFFUL) | (Tx->TDTR & 0xFFFF0000UL);
+        }
+    }
+
+    Tx->TIR &= ~(uint32)CAN_TI0R_TXRQ;
+    CAN1->TSR |= ((uint32)(CAN_TSR_RQCP0 | CAN_TSR_TXOK0) << Shift) | ((uint32)CAN_TSR_TME0 << Mailbox);
+    BxCanSim_Stats.FramesSent++;
+
+    /* Loopback: the controller receives its own frame */
+    Frame.Rir = Tx->TIR & ~(uint32)CAN_TI0R_TXRQ;
+    Frame.Rdtr = Tx->TDTR & (CAN_TDT0R_DLC | CAN_TDT0R_TIME);
+    Frame.Rdlr = Tx->TDLR;
+    Frame.Rdhr = Tx->TDHR;
+    BxCanSim_Receive(&Frame);
+}
+
+/**
+ * @brief   Send the pending mailboxes the controller can send now
+ * @details Only in loopback modes, where the controller acknowledges its own frames. Mailboxes
+ *          go out by identifier, or by request order with TXFP.
+ */
+static void BxCanSim_Service(void)
+{
+    uint8 Mailbox;
+    uint8 Best;
+    uint32 Key;
+    uint32 BestKey;
+
+    if (((CAN1->MSR & (CAN_MSR_INAK | CAN_MSR_SLAK)) != 0U) || ((CAN1->BTR & CAN_BTR_LBKM) == 0U))
+    {
+        return;
+    }
+
+    for (;;)
+    {
+        Best = BXCANSIM_MAILBOX_COUNT;
+        BestKey = 0xFFFFFFFFUL;
+        for (Mailbox = 0U; Mailbox < BXCANSIM_MAILBOX_COUNT; Mailbox++)
+        {
+            if ((CAN1->TSR & ((uint32)CAN_TSR_TME0 << Mailbox)) != 0U)
+            {
+                continue;
+            }
+            Key = ((CAN1->MCR & CAN_MCR_TXFP) != 0U) ? BxCanSim_RequestOrder[Mailbox]
+                                                     : BxCanSim_Arbitration(Mailbox);
+            if ((Best == BXCANSIM_MAILBOX_COUNT) || (Key < BestKey))
+            {
+                Best = Mailbox;
+                BestKey = Key;
+            }
+        }
+
+        if (Best == BXCANSIM_MAILBOX_COUNT)
+        {
+            break;
+        }
+        BxCanSim_Transmit(Best);
+    }
+}
+
+/**
+ * @brief   CODE field: the empty mailbox the next frame goes to
+ */
+static void BxCanSim_UpdateTsr(void)
+{
+    uint32 Tsr = CAN1->TSR & ~(uint32)CAN_TSR_CODE;
+    uint32 Code = 0U;
+    uint8 Mailbox;
+
+    for (Mailbox = 0U; Mailbox < BXCANSIM_MAILBOX_COUNT; Mailbox++)
+    {
+        if ((Tsr & ((uint32)CAN_TSR_TME0 << Mailbox)) != 0U)
+        {
+            Code = Mailbox;
+            break;
+        }
+    }
+    CAN1->TSR = Tsr | (Code << 24U);
+}
+
+static void BxCanSim_UpdateIrqs(void)
+{
+    uint32 Ier = CAN1->IER;
+    uint32 Pending = 0U;
+
+    if (((Ier & CAN_IER_TMEIE) != 0U) &&
+        ((CAN1->TSR & (CAN_TSR_RQCP0 | CAN_TSR_RQCP1 | CAN_TSR_RQCP2)) != 0U))
+    {
+        Pending |= BXCANSIM_IRQ_TX;
+    }
+    if ((((Ier & CAN_IER_FMPIE0) != 0U) && (BxCanSim_Fifo[0].Count != 0U)) ||
+        (((Ier & CAN_IER_FFIE0) != 0U) && (BxCanSim_Fifo[0].Full == TRUE)) ||
+        (((Ier & CAN_IER_FOVIE0) != 0U) && (BxCanSim_Fifo[0].Overrun == TRUE)))
+    {
+        Pending |= BXCANSIM_IRQ_RX0;
+    }
+    if ((((Ier & CAN_IER_FMPIE1) != 0U) && (BxCanSim_Fifo[1].Count != 0U)) ||
+        (((Ier & CAN_IER_FFIE1) != 0U) && (BxCanSim_Fifo[1].Full == TRUE)) ||
+        (((Ier & CAN_IER_FOVIE1) != 0U) && (BxCanSim_Fifo[1].Overrun == TRUE)))
+    {
+        Pending |= BXCANSIM_IRQ_RX1;
+    }
+    if ((((Ier & CAN_IER_ERRIE) != 0U) && ((CAN1->MSR & CAN_MSR_ERRI) != 0U)) ||
+        (((Ier & CAN_IER_WKUIE) != 0U) && ((CAN1->MSR & CAN_MSR_WKUI) != 0U)) ||
+        (((Ier & CAN_IER_SLKIE) != 0U) && ((CAN1->MSR & CAN_MSR_SLAKI) != 0U)))
+    {
+        Pending |= BXCANSIM_IRQ_SCE;
+    }
+
+    BxCanSim_IrqPending = Pending;
+}
+
+/**
+ * @brief   Apply a write to a CAN1 register
+ * @details The register still holds Old; Value is what the instruction wrote.
+ */
+static void BxCanSim_CanWrite(uint32 Offset, uint32 Value, uint32 Old)
+{
+    volatile uint32_t* Register = (volatile uint32_t*)(CAN1_BASE + Offset);
+    uint32 Msr;
+    uint8 Mailbox;
+    uint8 Fifo;
+
+    if (Offset == offsetof(CAN_TypeDef, MCR))
+    {
+        if ((Value & CAN_MCR_RESET) != 0U)
+        {
+            BxCanSim_Reset();
+            return;
+        }
+        CAN1->MCR = Value & ~(uint32)CAN_MCR_RESET;
+
+        /* Requests are acknowledged at once: INRQ before SLEEP */
+        Msr = CAN1->MSR & ~(uint32)(CAN_MSR_INAK | CAN_MSR_SLAK);
+        if ((Value & CAN_MCR_INRQ) != 0U)
+        {
+            Msr |= CAN_MSR_INAK;
+        }
+        else if ((Value & CAN_MCR_SLEEP) != 0U)
+        {
+            Msr |= CAN_MSR_SLAK;
+            if ((CAN1->MSR & CAN_MSR_SLAK) == 0U)
+            {
+                Msr |= CAN_MSR_SLAKI;
+            }
+        }
+        CAN1->MSR = Msr;
+        BxCanSim_Service();
+    }
+    else if (Offset == offsetof(CAN_TypeDef, MSR))
+    {
+        CAN1->MSR = Old & ~(Value & (CAN_MSR_ERRI | CAN_MSR_WKUI | CAN_MSR_SLAKI));
+    }
+    else if (Offset == offsetof(CAN_TypeDef, TSR))
+    {
+        CAN1->TSR = Old;
+        for (Mailbox = 0U; Mailbox < BXCANSIM_MAILBOX_COUNT; Mailbox++)
+        {
+            uint32 Shift = 8U * Mailbox;
+            uint32 Tme = (uint32)CAN_TSR_TME0 << Mailbox;
+
+            if ((Value & ((uint32)CAN_TSR_RQCP0 << Shift)) != 0U)
+            {
+                CAN1->TSR &= ~((uint32)(CAN_TSR_RQCP0 | CAN_TSR_TXOK0 | CAN_TSR_ALST0 | CAN_TSR_TERR0) << Shift);
+            }
+            if (((Value & ((uint32)CAN_TSR_ABRQ0 << Shift)) != 0U) && ((CAN1->TSR & Tme) == 0U))
+            {
+                CAN1->sTxMailBox[Mailbox].TIR &= ~(uint32)CAN_TI0R_TXRQ;
+                CAN1->TSR = (CAN1->TSR & ~((uint32)CAN_TSR_TXOK0 << Shift)) |
+                            ((uint32)CAN_TSR_RQCP0 << Shift) | Tme;
+            }
+        }
+    }
+    else if ((Offset == offsetof(CAN_TypeDef, RF0R)) || (Offset == offsetof(CAN_TypeDef, RF1R)))
+    {
+        Fifo = (Offset == offsetof(CAN_TypeDef, RF0R)) ? 0U : 1U;
+        if ((Value & CAN_RF0R_FULL0) != 0U)
+        {
+            BxCanSim_Fifo[Fifo].Full = FALSE;
+        }
+        if ((Value & CAN_RF0R_FOVR0) != 0U)
+        {
+            BxCanSim_Fifo[Fifo].Overrun = FALSE;
+        }
+        if ((Value & CAN_RF0R_RFOM0) != 0U)
+        {
+            BxCanSim_FifoRelease(Fifo);
+        }
+        BxCanSim_FifoLoad(Fifo);
+    }
+    else if (Offset == offsetof(CAN_TypeDef, ESR))
+    {
+        /* Only LEC is writable */
+        CAN1->ESR = (Old & ~(uint32)CAN_ESR_LEC) | (Value & CAN_ESR_LEC);
+    }
+    else if (Offset == offsetof(CAN_TypeDef, BTR))
+    {
+        /* Writable in initialization mode only */
+        if ((CAN1->MSR & CAN_MSR_INAK) == 0U)
+        {
+            CAN1->BTR = Old;
+        }
+    }
+    else if ((Offset >= offsetof(CAN_TypeDef, sTxMailBox)) && (Offset < offsetof(CAN_TypeDef, sFIFOMailBox)))
+    {
+        Mailbox = (uint8)((Offset - offsetof(CAN_TypeDef, sTxMailBox)) / sizeof(CAN_TxMailBox_TypeDef));
+
+        /* A mailbox is writable while empty only */
+        if ((CAN1->TSR & ((uint32)CAN_TSR_TME0 << Mailbox)) == 0U)
+        {
+            *Register = Old;
+        }
+        else if ((Register == &CAN1->sTxMailBox[Mailbox].TIR) && ((Value & CAN_TI0R_TXRQ) != 0U))
+        {
+            CAN1->TSR &= ~((uint32)CAN_TSR_TME0 << Mailbox);
+            BxCanSim_RequestOrder[Mailbox] = BxCanSim_RequestCount++;
+            BxCanSim_Service();
+        }
+    }
+    else if ((Offset >= offsetof(CAN_TypeDef, sFIFOMailBox)) && (Offset < offsetof(CAN_TypeDef, FMR)))
+    {
+        /* FIFO output mailboxes are read-only */
+        *Register = Old;
+    }
+    else
+    {
+        /* IER, filter registers: plain read/write, Value stays */
+    }
+
+    BxCanSim_UpdateTsr();
+}
+
+static void BxCanSim_OnFault(int Signal, siginfo_t* Info, void* Context)
+{
+    ucontext_t* Uc = (ucontext_t*)Context;
+    uintptr_t Address = (uintptr_t)Info->si_addr;
+    uintptr_t Page = BXCANSIM_PAGE(Address);
+    uint32_t* Register = (uint32_t*)(Address & ~(uintptr_t)3U);
+
+    (void)Signal;
+
+    if (((Page != BXCANSIM_CAN_PAGE) && (Page != BXCANSIM_DWT_PAGE)) || (BxCanSim_Access.Active == TRUE))
+    {
+        /* A real fault: let it crash */
+        (void)signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+
+    (void)mprotect((void*)Page, BXCANSIM_PAGE_SIZE, PROT_READ | PROT_WRITE);
+
+    if (Register == (uint32_t*)&DWT->CYCCNT)
+    {
+        *Register = BxCanSim_Now();
+    }
+
+    BxCanSim_Access.Page = Page;
+    BxCanSim_Access.Register = Register;
+    BxCanSim_Access.Old = *Register;
+    BxCanSim_Access.Write = ((Uc->uc_mcontext.gregs[REG_ERR] & BXCANSIM_PF_WRITE) != 0) ? TRUE : FALSE;
+    BxCanSim_Access.Active = TRUE;
+
+    /* Execute the access and come back (already set once BxCanSim_Init returned) */
+    Uc->uc_mcontext.gregs[REG_EFL] |= (greg_t)BXCANSIM_EFLAGS_TF;
+}
+
+static void BxCanSim_OnStep(int Signal, siginfo_t* Info, void* Context)
+{
+    uint32_t* Register = BxCanSim_Access.Register;
+
+    (void)Signal;
+    (void)Info;
+    (void)Context;
+
+    BxCanSim_Instructions++;
+    if (BxCanSim_Access.Active == FALSE)
+    {
+        return;
+    }
+
+    if ((BxCanSim_Access.Write == TRUE) && (BxCanSim_Access.Page == BXCANSIM_CAN_PAGE) &&
+        ((uintptr_t)Register >= CAN1_BASE) && ((uintptr_t)Register < (CAN1_BASE + sizeof(CAN_TypeDef))))
+    {
+        BxCanSim_CanWrite((uint32)((uintptr_t)Register - CAN1_BASE), *Register, BxCanSim_Access.Old);
+        BxCanSim_UpdateIrqs();
+    }
+    else if ((BxCanSim_Access.Write == TRUE) && (Register == (uint32_t*)&DWT->CYCCNT))
+    {
+        /* Writing CYCCNT restarts the count from the written value */
+        BxCanSim_CycleBase = BxCanSim_Instructions - *Register;
+    }
+    else
+    {
+        /* Read of the DWT, or write to a plain register of the page */
+    }
+
+    (void)mprotect((void*)BxCanSim_Access.Page, BXCANSIM_PAGE_SIZE,
+                   (BxCanSim_Access.Page == BXCANSIM_CAN_PAGE) ? PROT_READ : PROT_NONE);
+    BxCanSim_Access.Active = FALSE;
+    BxCanSim_Stats.Traps++;
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+void BxCanSim_Init(void)
+{
+    struct sigaction Action;
+
+    if ((mmap((void*)BXCANSIM_APB_BASE, BXCANSIM_APB_SIZE, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) != (void*)BXCANSIM_APB_BASE) ||
+        (mmap((void*)BXCANSIM_PPB_BASE, BXCANSIM_PPB_SIZE, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) != (void*)BXCANSIM_PPB_BASE))
+    {
+        perror("BxCanSim: cannot map the peripheral address space");
+        exit(EXIT_FAILURE);
+    }
+
+    RCC->CFGR = BXCANSIM_RCC_CFGR_72MHZ;
+    BxCanSim_Reset();
+    (void)memset(&BxCanSim_Stats, 0, sizeof(BxCanSim_Stats));
+
+    (void)memset(&Action, 0, sizeof(Action));
+    Action.sa_flags = SA_SIGINFO;
+    (void)sigemptyset(&Action.sa_mask);
+    Action.sa_sigaction = BxCanSim_OnFault;
+    (void)sigaction(SIGSEGV, &Action, NULL);
+    Action.sa_sigaction = BxCanSim_OnStep;
+    (void)sigaction(SIGTRAP, &Action, NULL);
+
+    (void)mprotect((void*)BXCANSIM_CAN_PAGE, BXCANSIM_PAGE_SIZE, PROT_READ);
+    (void)mprotect((void*)BXCANSIM_DWT_PAGE, BXCANSIM_PAGE_SIZE, PROT_NONE);
+
+    /* Set the trap flag: from the next instruction on, every instruction is counted */
+    __asm__ volatile("pushfq\n\torq %0, (%%rsp)\n\tpopfq" : : "i"(BXCANSIM_EFLAGS_TF) : "memory", "cc");
+}
+
+void BxCanSim_GetStats(BxCanSim_StatsType* StatsPtr)
+{
+    *StatsPtr = BxCanSim_Stats;
+    StatsPtr->Instructions = BxCanSim_Instructions;
+}
+
+void BxCanSim_DeliverIrqs(void)
+{
+    uint32 Pending;
+    uint32 Count;
+
+    if ((BxCanSim_PriMask != 0U) || (BxCanSim_InHandler == TRUE))
+    {
+        return;
+    }
+
+    BxCanSim_InHandler = TRUE;
+    for (Count = 0U; (Pending = BxCanSim_IrqPending) != 0U; Count++)
+    {
+        if (Count == BXCANSIM_IRQ_LIMIT)
+        {
+            (void)fprintf(stderr, "BxCanSim: interrupt 0x%x is never cleared\n", (unsigned)Pending);
+            exit(EXIT_FAILURE);
+        }
+
+        /* Same priority: the lowest vector number first */
+        if (((Pending & BXCANSIM_IRQ_TX) != 0U) && (BXCANSIM_TX_IRQ_HANDLER != NULL))
+        {
+            BXCANSIM_TX_IRQ_HANDLER();
+        }
+        else if (((Pending & BXCANSIM_IRQ_RX0) != 0U) && (BXCANSIM_RX0_IRQ_HANDLER != NULL))
+        {
+            BXCANSIM_RX0_IRQ_HANDLER();
+        }
+        else if (((Pending & BXCANSIM_IRQ_RX1) != 0U) && (CAN1_RX1_IRQHandler != NULL))
+        {
+            CAN1_RX1_IRQHandler();
+        }
+        else if (((Pending & BXCANSIM_IRQ_SCE) != 0U) && (CAN1_SCE_IRQHandler != NULL))
+        {
+            CAN1_SCE_IRQHandler();
+        }
+        else
+        {
+            /* Lines without a handler stay pending */
+            break;
+        }
+    }
+    BxCanSim_InHandler = FALSE;
+}
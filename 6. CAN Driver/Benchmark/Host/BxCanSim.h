@@ -0,0 +1,77 @@
+/****************************************************************************************
+*                               BXCANSIM.H                                             *
+****************************************************************************************
+* File Name   : BxCanSim.h
+* Module      : Controller Area Network (CAN)
+* Description : Host register model of the STM32F10x bxCAN (CAN1) for x86-64 Linux
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+***************************************************************************************/
+#ifndef BXCANSIM_H
+#define BXCANSIM_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Std_Types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+*                          GLOBAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/**
+ * @brief   Model Counters
+ */
+typedef struct
+{
+    uint64  Instructions;       /**< Instructions retired outside the model */
+    uint64  Traps;              /**< Trapped writes to CAN1 and accesses to the DWT */
+    uint32  FramesSent;         /**< Frames transmitted (loopback modes only) */
+    uint32  FramesReceived;     /**< Transmitted frames that passed the filters into a FIFO */
+    uint32  FramesFiltered;     /**< Transmitted frames no active filter accepted */
+    uint32  FifoOverruns;       /**< Frames lost to a full FIFO */
+} BxCanSim_StatsType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief   Map the peripheral address space and start the model
+ * @details Maps the APB peripherals (0x40000000) and the Cortex-M private peripheral bus
+ *          (0xE0000000) at their target addresses, so the driver and the SPL run unmodified.
+ *          All registers are plain memory with their reset values, except the pages of CAN1 and
+ *          of the DWT: a write to CAN1 is turned into the bxCAN write semantics before the next
+ *          instruction runs, and DWT_CYCCNT counts the instructions retired since this call, one
+ *          cycle each. The count is exact and repeatable, independent of the host load, and the
+ *          model does not add to it. Every instruction traps, so the program runs about ten
+ *          thousand times slower from here on. RCC is preset to 72 MHz from an 8 MHz HSE.
+ *
+ *          What is modelled: initialization and sleep requests, the TX mailboxes with
+ *          identifier or request order priority and abort, both RX FIFOs with overrun, the
+ *          acceptance filters with match index and priority as in RM0008, TTCM time stamps and
+ *          the four CAN1 interrupt lines. In loopback and silent loopback a transmit request
+ *          completes at once, the frame takes no bus time. Without loopback no node acknowledges,
+ *          so transmit requests stay pending. Bus errors, bus-off, wakeup from the bus, CAN2,
+ *          the NVIC and the RCC peripheral reset are not modelled.
+ *
+ *          Exits the process if the address space cannot be mapped.
+ */
+void BxCanSim_Init(void);
+
+/**
+ * @brief   Model counters since BxCanSim_Init
+ */
+void BxCanSim_GetStats(BxCanSim_StatsType* StatsPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BXCANSIM_H */
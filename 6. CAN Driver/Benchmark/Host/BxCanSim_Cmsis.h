@@ -0,0 +1,120 @@
+/****************************************************************************************
+*                               BXCANSIM_CMSIS.H                                       *
+****************************************************************************************
+* File Name   : BxCanSim_Cmsis.h
+* Module      : Controller Area Network (CAN)
+* Description : Host replacement of cmsis_gcc.h for the simulated bxCAN
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+*
+* Force-included (gcc -include) ahead of every translation unit of the host build. It takes the
+* include guard of cmsis_gcc.h, so core_cm3.h compiles unchanged for x86-64, and replaces the
+* Cortex-M intrinsics: PRIMASK is a variable of the model and clearing it delivers the pending
+* bxCAN interrupts, barriers become compiler barriers.
+***************************************************************************************/
+#ifndef BXCANSIM_CMSIS_H
+#define BXCANSIM_CMSIS_H
+
+/* cmsis_gcc.h is replaced by this file. No system header is included here, so that the
+   translation units still choose their own feature test macros (_GNU_SOURCE). */
+#define __CMSIS_GCC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* CMSIS compiler specific defines, as in cmsis_gcc.h */
+#define __ASM                                  __asm
+#define __INLINE                               inline
+#define __STATIC_INLINE                        static inline
+#define __STATIC_FORCEINLINE                   __attribute__((always_inline)) static inline
+#define __NO_RETURN                            __attribute__((__noreturn__))
+#define __USED                                 __attribute__((used))
+#define __WEAK                                 __attribute__((weak))
+#define __PACKED                               __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT                        struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION                         union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)                           __attribute__((aligned(x)))
+#define __RESTRICT                             __restrict
+#define __COMPILER_BARRIER()                   __ASM volatile("" ::: "memory")
+
+/* x86-64 has no alignment restrictions; int is 32 and short 16 bits wide */
+#define __UNALIGNED_UINT32(x)                  (*(unsigned int*)(void*)(x))
+#define __UNALIGNED_UINT16_WRITE(addr, val)    (void)(*(unsigned short*)(void*)(addr) = (val))
+#define __UNALIGNED_UINT16_READ(addr)          (*(const unsigned short*)(const void*)(addr))
+#define __UNALIGNED_UINT32_WRITE(addr, val)    (void)(*(unsigned int*)(void*)(addr) = (val))
+#define __UNALIGNED_UINT32_READ(addr)          (*(const unsigned int*)(const void*)(addr))
+
+/* Register accesses are trapped one by one and complete in program order */
+#define __NOP()                                __COMPILER_BARRIER()
+#define __DMB()                                __COMPILER_BARRIER()
+#define __DSB()                                __COMPILER_BARRIER()
+#define __ISB()                                __COMPILER_BARRIER()
+#define __WFI()                                __COMPILER_BARRIER()
+
+/* Count leading zeros, as in cmsis_gcc.h */
+#define __CLZ                                  (unsigned char)__builtin_clz
+
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+
+/**
+ * @brief   Simulated PRIMASK, 1 masks the bxCAN interrupts
+ */
+extern unsigned int BxCanSim_PriMask;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief   Run the handlers of the pending bxCAN interrupts
+ * @details Does nothing while PRIMASK is set or a handler is already running.
+ */
+void BxCanSim_DeliverIrqs(void);
+
+/*==================================================================================================
+*                                      INLINE FUNCTIONS
+==================================================================================================*/
+
+__STATIC_FORCEINLINE unsigned int __get_PRIMASK(void)
+{
+    __COMPILER_BARRIER();
+    return BxCanSim_PriMask;
+}
+
+__STATIC_FORCEINLINE void __set_PRIMASK(unsigned int priMask)
+{
+    __COMPILER_BARRIER();
+    BxCanSim_PriMask = priMask & 1U;
+    if (BxCanSim_PriMask == 0U)
+    {
+        BxCanSim_DeliverIrqs();
+    }
+    __COMPILER_BARRIER();
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void)
+{
+    __COMPILER_BARRIER();
+    BxCanSim_PriMask = 1U;
+    __COMPILER_BARRIER();
+}
+
+__STATIC_FORCEINLINE void __enable_irq(void)
+{
+    __set_PRIMASK(0U);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BXCANSIM_CMSIS_H */
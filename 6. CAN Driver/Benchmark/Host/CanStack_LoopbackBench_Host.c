@@ -0,0 +1,91 @@
+/****************************************************************************************
+*                               CANSTACK_LOOPBACKBENCH_HOST.C                          *
+****************************************************************************************
+* File Name   : CanStack_LoopbackBench_Host.c
+* Module      : CAN Interface (CanIf)
+* Description : Host run of the loopback round-trip benchmark on the bxCAN register model
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+*
+* Build and run on an x86-64 Linux host from "6. CAN Driver":
+*   gcc -O2 -std=gnu99 -DSTM32F10X_MD -DUSE_STDPERIPH_DRIVER -include Benchmark/Host/BxCanSim_Cmsis.h \
+*       -IMCAL/Can -IMCAL/CanIf -IConfig/CanIf -IConfig/Det -IMCAL -ISPL/inc \
+*       -I"../4. PWM Driver/SPL/inc" -ICMSIS \
+*       Benchmark/Host/CanStack_LoopbackBench_Host.c Benchmark/Host/BxCanSim.c \
+*       Benchmark/CanStack_LoopbackBench.c MCAL/Can/Can.c MCAL/Can/Can_Cfg.c MCAL/Can/Can_Filter.c \
+*       MCAL/Can/Can_Stats.c MCAL/Can/Can_Time.c MCAL/Can/Can_Gw.c MCAL/CanIf/CanIf.c \
+*       "../4. PWM Driver/SPL/src/stm32f10x_can.c" "../4. PWM Driver/SPL/src/misc.c" \
+*       SPL/src/stm32f10x_rcc.c SPL/src/stm32f10x_gpio.c \
+*       -ffunction-sections -Wl,--gc-sections -o CanStack_LoopbackBench
+*   ./CanStack_LoopbackBench
+*
+* The driver, CanIf and the SPL run unmodified; only cmsis_gcc.h is replaced. A cycle is one
+* x86-64 instruction retired outside the register model, and the bus takes no time, so the
+* counts repeat exactly from run to run and on any machine with the same compiler. Compare them
+* between commits to see what a change costs; they are not target cycles. The run takes a few
+* seconds, every instruction being trapped.
+***************************************************************************************/
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include <stdio.h>
+
+#include "BxCanSim.h"
+#include "../CanStack_LoopbackBench.h"
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+/* The count is exact, a hundred round trips show every path the frames take */
+#define BENCH_FRAMES            (100U)
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+int main(void)
+{
+    static const struct
+    {
+        uint8       TestMode;
+        const char* Name;
+    } Mode[] =
+    {
+        { CAN_TEST_MODE_LOOPBACK,           "loopback" },
+        { CAN_TEST_MODE_SILENT_LOOPBACK,    "silent loopback" }
+    };
+    CanStack_LoopbackBenchResultType Result;
+    BxCanSim_StatsType Stats;
+    uint64 Traps = 0U;
+    uint32 Index;
+
+    BxCanSim_Init();
+
+    (void)printf("CanIf_Transmit -> Rx indication round trip, %u frames, host instructions\n", BENCH_FRAMES);
+    (void)printf("%-16s %8s %8s %8s %8s %8s %10s\n", "mode", "min", "avg", "p99", "max", "lost", "writes/rt");
+
+    for (Index = 0U; Index < (sizeof(Mode) / sizeof(Mode[0])); Index++)
+    {
+        if (CanStack_LoopbackBench_Run(Mode[Index].TestMode, BENCH_FRAMES, &Result) != E_OK)
+        {
+            (void)printf("%-16s failed to start\n", Mode[Index].Name);
+            return 1;
+        }
+
+        BxCanSim_GetStats(&Stats);
+        (void)printf("%-16s %8u %8u %8u %8u %8u %10.1f\n", Mode[Index].Name,
+                     (unsigned)Result.Min, (unsigned)Result.Avg, (unsigned)Result.P99,
+                     (unsigned)Result.Max, (unsigned)Result.Lost,
+                     (double)(Stats.Traps - Traps) / (double)BENCH_FRAMES);
+        Traps = Stats.Traps;
+    }
+
+    (void)printf("model: %u frames sent, %u received, %u filtered, %u overruns, %llu instructions\n",
+                 (unsigned)Stats.FramesSent, (unsigned)Stats.FramesReceived, (unsigned)Stats.FramesFiltered,
+                 (unsigned)Stats.FifoOverruns, (unsigned long long)Stats.Instructions);
+
+    return 0;
+}
@@ -76,14 +76,14 @@
 /* Rx HRH Configuration for CAN1 Controller */
 static const CanIf_HrhConfigType CanIf_HrhConfigData[CANIF_CFG_MAX_RX_HRHS] = 
 {
-    /* HRH 0: Standard messages reception for CAN1 */
+    /* HRH 0: Standard messages reception for CAN1, bulk lane (FIFO 0) */
     {
         /* Controller reference */
         .ControllerId = 0U,
         /* HRH ID */
         .HrhId = 0U,
         /* HOH ID from CAN driver */
-        .HohId = 0U,
+        .HohId = CAN_HRH_0,
         /* CAN ID Range - Standard frames (0x000 - 0x7FF) */
         .HrhRangeConfig = 
         {
@@ -92,17 +92,19 @@ static const CanIf_HrhConfigType CanIf_HrhConfigData[CANIF_CFG_MAX_RX_HRHS] =
             .HrhRangeType = CANIF_STANDARD
         },
         /* Software filtering enabled */
-        .HrhSoftwareFilter = STD_ON
+        .HrhSoftwareFilter = STD_ON,
+        /* Reception lane */
+        .HrhPriority = CANIF_RX_PRIORITY_BULK
     },
     
-    /* HRH 1: Extended messages reception for CAN1 */
+    /* HRH 1: Extended messages and high priority reception for CAN1 (FIFO 1) */
     {
         /* Controller reference */
         .ControllerId = 0U,
         /* HRH ID */
         .HrhId = 1U,
         /* HOH ID from CAN driver */
-        .HohId = 1U,
+        .HohId = CAN_HRH_1,
         /* CAN ID Range - Extended frames (0x00000000 - 0x1FFFFFFF) */
         .HrhRangeConfig = 
         {
@@ -111,7 +113,9 @@ static const CanIf_HrhConfigType CanIf_HrhConfigData[CANIF_CFG_MAX_RX_HRHS] =
             .HrhRangeType = CANIF_EXTENDED
         },
         /* Software filtering enabled */
-        .HrhSoftwareFilter = STD_ON
+        .HrhSoftwareFilter = STD_ON,
+        /* Reception lane */
+        .HrhPriority = CANIF_RX_PRIORITY_HIGH
     }
 };
 
@@ -127,9 +131,12 @@ static const CanIf_HthConfigType CanIf_HthConfigData[CANIF_CFG_MAX_TX_HTHS] =
         /* HTH ID */
         .HthId = 0U,
         /* HOH ID from CAN driver */
-        .HohId = 2U,
+        .HohId = CAN_HTH_0,
         /* CAN ID type */
-        .HthCanIdType = CANIF_STANDARD
+        .HthCanIdType = CANIF_STANDARD,
+        /* Tx buffer */
+        .TxBufferSize = CANIF_TX_BUFFER_HTH_0_SIZE,
+        .TxBufferMode = CANIF_TX_BUFFER_SINGLE
     },
     
     /* HTH 1: Extended messages transmission for CAN1 */
@@ -139,9 +146,27 @@ static const CanIf_HthConfigType CanIf_HthConfigData[CANIF_CFG_MAX_TX_HTHS] =
         /* HTH ID */
         .HthId = 1U,
         /* HOH ID from CAN driver */
-        .HohId = 3U,
+        .HohId = CAN_HTH_1,
         /* CAN ID type */
-        .HthCanIdType = CANIF_EXTENDED
+        .HthCanIdType = CANIF_EXTENDED,
+        /* Tx buffer */
+        .TxBufferSize = CANIF_TX_BUFFER_HTH_1_SIZE,
+        .TxBufferMode = CANIF_TX_BUFFER_SINGLE
+    },
+
+    /* HTH 2: FullCAN object for the safety-critical cyclic PDU of CAN1 */
+    {
+        /* Controller reference */
+        .ControllerId = 0U,
+        /* HTH ID */
+        .HthId = 2U,
+        /* HOH ID from CAN driver */
+        .HohId = CAN_HTH_2,
+        /* CAN ID type */
+        .HthCanIdType = CANIF_STANDARD,
+        /* Tx buffer */
+        .TxBufferSize = CANIF_TX_BUFFER_HTH_2_SIZE,
+        .TxBufferMode = CANIF_TX_BUFFER_SINGLE
     }
 };
 
@@ -165,12 +190,36 @@ static const CanIf_CtrlConfigType CanIf_CtrlConfigData[CANIF_CFG_MAX_CONTROLLERS
         /* Reference to first HTH */
         .FirstHthIndex = 0U,
         /* Number of HTHs */
-        .HthCount = 2U,
+        .HthCount = 3U,
         /* Reference to first HRH */
         .FirstHrhIndex = 0U,
         /* Number of HRHs */
         .HrhCount = 2U
     }
+#if defined(STM32F10X_CL)
+    ,
+    /* Controller 1: CAN2, gateway traffic only; no L-PDUs, started and stopped through CanIf */
+    {
+        /* Controller ID */
+        .ControllerId = 1U,
+        /* CAN driver controller ID */
+        .CanControllerId = 1U,
+        /* Wakeup support */
+        .WakeupSupport = STD_OFF,
+        /* Wakeup source */
+        .WakeupSource = 0U,
+        /* Number of Tx buffers */
+        .TxBufferCount = 0U,
+        /* Reference to first HTH */
+        .FirstHthIndex = CANIF_CFG_MAX_TX_HTHS,
+        /* Number of HTHs */
+        .HthCount = 0U,
+        /* Reference to first HRH */
+        .FirstHrhIndex = CANIF_CFG_MAX_RX_HRHS,
+        /* Number of HRHs */
+        .HrhCount = 0U
+    }
+#endif
 };
 
 /*============================ Rx PDU Configuration ===========================*/
@@ -197,7 +246,9 @@ static const CanIf_RxPduConfigType CanIf_RxPduConfigData[CANIF_CFG_MAX_RX_PDUS]
         /* Read notification status API */
         .RxPduReadNotifyStatus = STD_ON,
         /* Read data API */
-        .RxPduReadData = STD_ON
+        .RxPduReadData = STD_ON,
+        /* Reception lane */
+        .RxPduPriority = CANIF_RX_PRIORITY_HIGH
     },
     
     /* Rx PDU 1: Vehicle Speed */
@@ -219,7 +270,9 @@ static const CanIf_RxPduConfigType CanIf_RxPduConfigData[CANIF_CFG_MAX_RX_PDUS]
         /* Read notification status API */
         .RxPduReadNotifyStatus = STD_ON,
         /* Read data API */
-        .RxPduReadData = STD_ON
+        .RxPduReadData = STD_ON,
+        /* Reception lane */
+        .RxPduPriority = CANIF_RX_PRIORITY_HIGH
     },
     
     /* Rx PDU 2: Diagnostic Request */
@@ -241,7 +294,9 @@ static const CanIf_RxPduConfigType CanIf_RxPduConfigData[CANIF_CFG_MAX_RX_PDUS]
         /* Read notification status API */
         .RxPduReadNotifyStatus = STD_OFF,
         /* Read data API */
-        .RxPduReadData = STD_OFF
+        .RxPduReadData = STD_OFF,
+        /* Reception lane; indicated from CanIf_MainFunction */
+        .RxPduPriority = CANIF_RX_PRIORITY_BULK
     }
 };
 
@@ -272,6 +327,14 @@ static const CanIf_TxPduConfigType CanIf_TxPduConfigData[CANIF_CFG_MAX_TX_PDUS]
         .TxPduReadNotifyStatus = STD_ON,
         /* Trigger transmit */
         .TxPduTriggerTransmit = STD_OFF,
+        /* User TriggerTransmit function */
+        .TxPduUserTriggerTransmitUL = NULL_PTR,
+        /* User TriggerTransmit name for linking */
+        .TxPduUserTriggerTransmitName = NULL_PTR,
+        /* User CancelTxConfirmation function */
+        .TxPduUserCancelTxConfirmationUL = NULL_PTR,
+        /* User CancelTxConfirmation name for linking */
+        .TxPduUserCancelTxConfirmationName = "PduR_CanIfCancelTxConfirmation",
         /* Truncation enabled */
         .TxPduTruncation = STD_OFF,
         /* Tx PDU type */
@@ -289,7 +352,7 @@ static const CanIf_TxPduConfigType CanIf_TxPduConfigData[CANIF_CFG_MAX_TX_PDUS]
         /* DLC */
         .TxPduDlc = 8U,
         /* HTH reference */
-        .TxPduHthId = 0U,
+        .TxPduHthId = 2U,
         /* User TxConfirmation function */
         .TxPduUserTxConfirmationUL = NULL_PTR,
         /* User TxConfirmation name for linking */
@@ -298,8 +361,16 @@ static const CanIf_TxPduConfigType CanIf_TxPduConfigData[CANIF_CFG_MAX_TX_PDUS]
         .TxPduTxConfirmation = STD_ON,
         /* Read notification status API */
         .TxPduReadNotifyStatus = STD_ON,
-        /* Trigger transmit */
+        /* Trigger transmit: STD_ON once TxPduUserTriggerTransmitUL is linked, else every frame is dropped */
         .TxPduTriggerTransmit = STD_OFF,
+        /* User TriggerTransmit function */
+        .TxPduUserTriggerTransmitUL = NULL_PTR,
+        /* User TriggerTransmit name for linking */
+        .TxPduUserTriggerTransmitName = "PduR_CanIfTriggerTransmit",
+        /* User CancelTxConfirmation function */
+        .TxPduUserCancelTxConfirmationUL = NULL_PTR,
+        /* User CancelTxConfirmation name for linking */
+        .TxPduUserCancelTxConfirmationName = "PduR_CanIfCancelTxConfirmation",
         /* Truncation enabled */
         .TxPduTruncation = STD_OFF,
         /* Tx PDU type */
@@ -328,6 +399,14 @@ static const CanIf_TxPduConfigType CanIf_TxPduConfigData[CANIF_CFG_MAX_TX_PDUS]
         .TxPduReadNotifyStatus = STD_OFF,
         /* Trigger transmit */
         .TxPduTriggerTransmit = STD_OFF,
+        /* User TriggerTransmit function */
+        .TxPduUserTriggerTransmitUL = NULL_PTR,
+        /* User TriggerTransmit name for linking */
+        .TxPduUserTriggerTransmitName = NULL_PTR,
+        /* User CancelTxConfirmation function */
+        .TxPduUserCancelTxConfirmationUL = NULL_PTR,
+        /* User CancelTxConfirmation name for linking */
+        .TxPduUserCancelTxConfirmationName = NULL_PTR,
         /* Truncation enabled */
         .TxPduTruncation = STD_OFF,
         /* Tx PDU type */
@@ -356,6 +435,14 @@ static const CanIf_TxPduConfigType CanIf_TxPduConfigData[CANIF_CFG_MAX_TX_PDUS]
         .TxPduReadNotifyStatus = STD_OFF,
         /* Trigger transmit */
         .TxPduTriggerTransmit = STD_OFF,
+        /* User TriggerTransmit function */
+        .TxPduUserTriggerTransmitUL = NULL_PTR,
+        /* User TriggerTransmit name for linking */
+        .TxPduUserTriggerTransmitName = NULL_PTR,
+        /* User CancelTxConfirmation function */
+        .TxPduUserCancelTxConfirmationUL = NULL_PTR,
+        /* User CancelTxConfirmation name for linking */
+        .TxPduUserCancelTxConfirmationName = "PduR_CanIfCancelTxConfirmation",
         /* Truncation enabled */
         .TxPduTruncation = STD_OFF,
         /* Tx PDU type */
@@ -132,7 +132,7 @@ extern "C" {
  *          true: Enabled, false: Disabled
  * SWS_CANIF_00010
  */
-#define CANIF_CANCEL_TX_SUPPORT_API             STD_OFF
+#define CANIF_CANCEL_TX_SUPPORT_API             STD_ON
 
 /**
  * @brief   Set Baudrate API
@@ -148,7 +148,7 @@ extern "C" {
  *          true: Enabled, false: Disabled
  * SWS_CANIF_00012
  */
-#define CANIF_TRIGGER_TRANSMIT_SUPPORT          STD_OFF
+#define CANIF_TRIGGER_TRANSMIT_SUPPORT          STD_ON
 
 /**
  * @brief   TX Buffering Support
@@ -198,6 +198,20 @@ extern "C" {
  */
 #define CANIF_PRIVATE_SOFTWARE_FILTER           STD_ON
 
+/**
+ * @brief   Software Filter Direct Table
+ * @details Look up 11-bit CAN IDs in a 2048-entry table per controller (4 KB each) instead
+ *          of the hash table. Only used with CANIF_PRIVATE_SOFTWARE_FILTER.
+ */
+#define CANIF_RX_DIRECT_TABLE_SUPPORT           STD_ON
+
+/**
+ * @brief   Software Filter Hash Table Size
+ * @details Open-addressing slots for the Rx PDUs not held in the direct table.
+ *          Power of two, at least twice the number of hashed Rx PDUs.
+ */
+#define CANIF_RX_HASH_TABLE_SIZE                (16U)
+
 /**
  * @brief   Range Reception Support
  * @details Switches the range reception support on or off.
@@ -206,6 +220,37 @@ extern "C" {
  */
 #define CANIF_RANGE_RECEPTION_SUPPORT           STD_ON
 
+/**
+ * @brief   Deferred Rx Indication Support
+ * @details Rx PDUs of the CANIF_RX_PRIORITY_BULK lane are indicated to the upper layer from
+ *          CanIf_MainFunction instead of Can_MainFunction_Read, within
+ *          CANIF_RX_DEFERRED_FRAME_BUDGET and CANIF_RX_DEFERRED_CYCLE_BUDGET per call.
+ *          true: Enabled, false: Disabled
+ */
+#define CANIF_RX_DEFERRED_SUPPORT               STD_ON
+
+/**
+ * @brief   Statistics API
+ * @details Counts the requests, confirmations, indications and drops of every L-PDU and the
+ *          Tx request-to-confirmation latency, read with CanIf_GetStatisticsSnapshot.
+ *          true: Enabled, false: Disabled
+ */
+#define CANIF_STATISTICS_API                    STD_ON
+
+/**
+ * @brief   Latency Histogram Buckets
+ * @details log2 buckets per Tx PDU. Bucket 0 counts latencies below 2^CANIF_STATISTICS_LATENCY_SHIFT
+ *          cycles, bucket k those in [2^(SHIFT+k-1), 2^(SHIFT+k)), the last one everything above.
+ */
+#define CANIF_STATISTICS_LATENCY_BUCKETS        (16U)
+
+/**
+ * @brief   Latency Histogram Resolution
+ * @details log2 of the core clock cycles of bucket 0: 10 gives 14 us at 72 MHz and a last
+ *          bucket from 233 ms on with 16 buckets.
+ */
+#define CANIF_STATISTICS_LATENCY_SHIFT          (10U)
+
 /*=============================== Hardware Configuration Parameters =============================*/
 
 /**
@@ -319,12 +364,38 @@ extern "C" {
 
 /**
  * @brief   TX Buffer Configuration
- * @details Configuration for TX buffering per HTH
+ * @details L-PDUs CanIf buffers per HTH while the CAN driver returns CAN_BUSY (TxBufferSize of
+ *          CanIf_HthConfigData). CANIF_CFG_TX_BUFFER_SIZE is their sum.
  */
 #define CANIF_TX_BUFFER_HTH_0_SIZE             (5U)
 #define CANIF_TX_BUFFER_HTH_1_SIZE             (5U)
 #define CANIF_TX_BUFFER_HTH_2_SIZE             (3U)
 
+/**
+ * @brief   Deferred Rx Queue Size
+ * @details Rx indications waiting for CanIf_MainFunction, all controllers together. Power of
+ *          two; a reception that finds the queue full is lost and reported to the DET.
+ */
+#define CANIF_RX_DEFERRED_QUEUE_SIZE           (16U)
+
+/*============================ Generated Table Sizes =============================*/
+
+/**
+ * @brief   Configuration Table Sizes
+ * @details Number of entries of the configuration tables in CanIf_Cfg.c
+ */
+#if defined(STM32F10X_CL)
+#define CANIF_CFG_MAX_CONTROLLERS              (2U)
+#else
+#define CANIF_CFG_MAX_CONTROLLERS              (1U)
+#endif
+#define CANIF_CFG_MAX_RX_HRHS                  (2U)
+#define CANIF_CFG_MAX_TX_HTHS                  (3U)
+#define CANIF_CFG_MAX_RX_PDUS                  (3U)
+#define CANIF_CFG_MAX_TX_PDUS                  (4U)
+#define CANIF_CFG_TX_BUFFER_SIZE               (CANIF_TX_BUFFER_HTH_0_SIZE + CANIF_TX_BUFFER_HTH_1_SIZE + \
+                                                 CANIF_TX_BUFFER_HTH_2_SIZE)
+
 /*============================ Timeout Configuration Parameters =============================*/
 
 /**
@@ -333,6 +404,21 @@ extern "C" {
  */
 #define CANIF_MAIN_FUNCTION_PERIOD             (10U)
 
+/**
+ * @brief   Deferred Rx Frame Budget
+ * @details Deferred Rx indications dispatched per CanIf_MainFunction call at most; the rest
+ *          waits for the next call.
+ */
+#define CANIF_RX_DEFERRED_FRAME_BUDGET         (8U)
+
+/**
+ * @brief   Deferred Rx Cycle Budget
+ * @details Core clock cycles (DWT_CYCCNT) after which CanIf_MainFunction stops dispatching,
+ *          checked after each indication, so one indication always runs. 0: frame budget only.
+ *          E.g. 7200 cycles are 100 us at 72 MHz.
+ */
+#define CANIF_RX_DEFERRED_CYCLE_BUDGET         (0UL)
+
 /**
  * @brief   TX Confirmation Timeout
  * @details Maximum time to wait for TX confirmation (in main function cycles)
@@ -375,34 +461,10 @@ extern "C" {
 extern const CanIf_ConfigType CanIf_Config;
 
 /**
- * @brief   CanIf Controller Configuration Array Declaration
- * @details External declaration of CanIf controller configuration array
- */
-extern const CanIf_ControllerConfigType CanIf_ControllerConfigs[CANIF_MAX_CAN_CONTROLLERS];
-
-/**
- * @brief   CanIf HTH Configuration Array Declaration
- * @details External declaration of CanIf HTH configuration array
- */
-extern const CanIf_HthConfigType CanIf_HthConfigs[CANIF_MAX_HTH_OBJECTS];
-
-/**
- * @brief   CanIf HRH Configuration Array Declaration
- * @details External declaration of CanIf HRH configuration array
- */
-extern const CanIf_HrhConfigType CanIf_HrhConfigs[CANIF_MAX_HRH_OBJECTS];
-
-/**
- * @brief   CanIf TX PDU Configuration Array Declaration
- * @details External declaration of CanIf TX PDU configuration array
- */
-extern const CanIf_TxPduConfigType CanIf_TxPduConfigs[CANIF_MAX_TX_PDUS];
-
-/**
- * @brief   CanIf RX PDU Configuration Array Declaration
- * @details External declaration of CanIf RX PDU configuration array
+ * @brief   CanIf Configuration Pointer Declaration
+ * @details Pre-compile configuration pointer passed to CanIf_Init
  */
-extern const CanIf_RxPduConfigType CanIf_RxPduConfigs[CANIF_MAX_RX_PDUS];
+extern const CanIf_ConfigType* CanIf_ConfigPtr;
 
 /*==================================================================================================
 *                                     FUNCTION PROTOTYPES
@@ -22,6 +22,19 @@
 #include "stm32f10x.h"
 #include "stm32f10x_can.h"
 #include "stm32f10x_rcc.h"
+#include "stm32f10x_gpio.h"
+#include "misc.h"
+#include "CanIf_Cbk.h"
+#include "Can_Time.h"
+#if (CAN_RX_FILTER_API == STD_ON)
+    #include "Can_Filter.h"
+#endif
+#if (CAN_STATISTICS_API == STD_ON)
+    #include "Can_Stats.h"
+#endif
+#if (CAN_GATEWAY_SUPPORT == STD_ON)
+    #include "Can_Gw.h"
+#endif
 
 #if (CAN_DEV_ERROR_DETECT == STD_ON)
     #include "Det.h"
@@ -49,11 +62,40 @@
 #endif
 
 
-/* Check if Lin.c file and Lin.h file are of the same AUTOSAR version */
-#if ((LIN_AR_RELEASE_MAJOR_VERSION_C != LIN_AR_RELEASE_MAJOR_VERSION) || \
-     (LIN_AR_RELEASE_MINOR_VERSION_C != LIN_AR_RELEASE_MINOR_VERSION) || \
-     (LIN_AR_RELEASE_REVISION_VERSION_C != LIN_AR_RELEASE_REVISION_VERSION))
-    #error "AUTOSAR Version Numbers of Lin.c and Lin.h are different"
+/* Check if Can.c file and Can.h file are of the same AUTOSAR version */
+#if ((CAN_AR_RELEASE_MAJOR_VERSION_C != CAN_AR_RELEASE_MAJOR_VERSION) || \
+     (CAN_AR_RELEASE_MINOR_VERSION_C != CAN_AR_RELEASE_MINOR_VERSION) || \
+     (CAN_AR_RELEASE_REVISION_VERSION_C != CAN_AR_RELEASE_REVISION_VERSION))
+    #error "AUTOSAR Version Numbers of Can.c and Can.h are different"
+#endif
+
+/* bxCAN has no interrupt for INAK, mode transitions are always completed by polling */
+#if (CAN_MODE_PROCESSING != POLLING)
+    #error "CAN_MODE_PROCESSING must be POLLING"
+#endif
+
+#if ((CAN_RX_PROCESSING == ADAPTIVE) && (CAN_RX_POLL_EXIT_THRESHOLD >= CAN_RX_POLL_ENTER_THRESHOLD))
+    #error "CAN_RX_POLL_EXIT_THRESHOLD must be below CAN_RX_POLL_ENTER_THRESHOLD"
+#endif
+
+/* RX ring indices wrap by masking */
+#if ((CAN_MAX_RX_BUFFER_SIZE & (CAN_MAX_RX_BUFFER_SIZE - 1U)) != 0U)
+    #error "CAN_MAX_RX_BUFFER_SIZE must be a power of two"
+#endif
+
+/* A batch is indicated out of the ring slots it occupies */
+#if ((CAN_RX_INDICATION_BATCH_SIZE < 1U) || (CAN_RX_INDICATION_BATCH_SIZE > CAN_MAX_RX_BUFFER_SIZE))
+    #error "CAN_RX_INDICATION_BATCH_SIZE must be 1 .. CAN_MAX_RX_BUFFER_SIZE"
+#endif
+
+/* Slot instants and reference message are timed with the ingress time stamps */
+#if ((CAN_TT_SCHEDULE_API == STD_ON) && (CAN_GET_INGRESS_TIME_STAMP_API == STD_OFF))
+    #error "CAN_TT_SCHEDULE_API requires CAN_GET_INGRESS_TIME_STAMP_API"
+#endif
+
+/* The gateway forwards frames from the L-PDU callout */
+#if ((CAN_GATEWAY_SUPPORT == STD_ON) && (CAN_LPDU_CALLOUT_SUPPORT == STD_OFF))
+    #error "CAN_GATEWAY_SUPPORT requires CAN_LPDU_CALLOUT_SUPPORT"
 #endif
 
 /* Check if Can.c file and Can.h file are of the same software version */
@@ -68,14 +110,9 @@
 *                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
 ==================================================================================================*/
 /**
- * @brief   LIN Channel Runtime Information
- * @details Structure to hold runtime information for each LIN channel
+ * @brief   CAN Controller Runtime Information
+ * @details Structure to hold runtime information for each CAN controller
  */
-typedef struct
-{
-
-} Can_ChannelRuntimeType;
-
 typedef struct
 {
     Can_ControllerStateType ControllerState;       /**< Current Controller State */
@@ -84,9 +121,206 @@ typedef struct
     boolean WakeupFlag;                           /**< Wakeup Detection Flag */
     uint8 RxErrorCounter;                         /**< Receive Error Counter */
     uint8 TxErrorCounter;                         /**< Transmit Error Counter */
-    uint32 TimeoutCounter;                        /**< Timeout Counter for operations */
+    uint32 TimeoutCounter;                        /**< Can_MainFunction_Mode calls spent on the pending transition */
+    Can_ControllerStateType RequestedState;       /**< Target of the pending mode transition */
+    boolean TransitionPending;                    /**< Waiting for INAK/SLAK */
+    uint8 TestMode;                               /**< CAN_TEST_MODE_xxx programmed into CAN_BTR */
 } Can_ControllerRuntimeType;
 
+/**
+ * @brief   CAN RX Frame
+ * @details One L-PDU copied out of a hardware RX FIFO, waiting to be indicated to CanIf
+ */
+typedef struct
+{
+    Can_IdType CanId;                             /**< CAN ID, CAN_ID_EXTENDED_FLAG set for 29-bit IDs */
+    Can_HwHandleType Hoh;                         /**< HRH the frame was received on */
+    uint8 FilterMatchIndex;                       /**< FMI of the filter element that accepted the frame */
+    uint8 Length;                                 /**< Data length (0..8) */
+    uint8 Data[CAN_MAX_DATA_LENGTH];              /**< Payload */
+#if (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON)
+    uint64 TimeStamp;                             /**< SOF time on the time base (Can_Time) */
+#endif
+} Can_RxFrameType;
+
+/**
+ * @brief   CAN RX Queue
+ * @details Lock-free single-producer/single-consumer ring between the ISR of one hardware FIFO
+ *          and Can_MainFunction_Read. Every FIFO has its own ring (lane), so the FIFO 1 ISR may
+ *          preempt the FIFO 0 ISR. Head is written only by the producer, Tail only by the
+ *          consumer. Both are free-running and wrap by masking; Head also counts the frames
+ *          queued since the controller was initialized.
+ */
+typedef struct
+{
+    Can_RxFrameType Frame[CAN_MAX_RX_BUFFER_SIZE]; /**< Frame slots */
+    volatile uint32 Head;                         /**< Next slot to be written by the producer */
+    volatile uint32 Tail;                         /**< Next slot to be read by the consumer */
+    uint32 QueueOverrunCount;                     /**< Frames dropped because the ring was full */
+    uint32 FifoOverrunCount;                      /**< Frames dropped by hardware (FOVx) */
+    uint32 MaxFill;                               /**< Highest ring fill seen by the producer */
+} Can_RxQueueType;
+
+#if (CAN_RX_PROCESSING == ADAPTIVE)
+/**
+ * @brief   CAN Adaptive RX State
+ * @details Load tracking of the adaptive reception, updated once per Can_MainFunction_Read
+ */
+typedef struct
+{
+    uint32 LastArrived;                           /**< Head + QueueOverrunCount at the last period */
+    uint8 QuietPeriods;                           /**< Consecutive periods at or below the exit threshold */
+    Can_RxModeStatisticsType Statistics;          /**< Mode and switch counters */
+} Can_RxAdaptiveType;
+#endif
+
+/**
+ * @brief   CAN Bus-off Recovery State
+ * @details Progress of the software bus-off recovery of one controller
+ */
+typedef struct
+{
+    uint8 State;                                  /**< CAN_BUSOFF_STATE_xxx */
+    uint32 Delay;                                 /**< Periods left before the restart is requested */
+    uint32 Elapsed;                               /**< Periods since the bus-off was handled */
+    uint32 StablePeriods;                         /**< Periods on the bus since the last recovery, saturating */
+    Can_BusOffStatisticsType Statistics;          /**< Event counters */
+} Can_BusOffType;
+
+/**
+ * @brief   CAN TX Frame
+ * @details One L-PDU accepted by Can_Write and waiting in a TX buffer. Identifier and payload are
+ *          kept as mailbox register images so that loading a mailbox is four register stores.
+ */
+typedef struct
+{
+    uint32 Priority;                              /**< Arbitration key, lower value wins (CAN_TX_PRIORITY) */
+    uint32 Tir;                                   /**< CAN_TIxR image without TXRQ */
+    uint32 DataLow;                               /**< CAN_TDLxR image (bytes 0..3) */
+    uint32 DataHigh;                              /**< CAN_TDHxR image (bytes 4..7) */
+    PduIdType swPduHandle;                        /**< CanIf handle for the TX confirmation */
+    uint8 Length;                                 /**< Data length (0..8) */
+#if (CAN_TRIGGER_TRANSMIT_SUPPORT == STD_ON)
+    boolean TriggerTransmit;                      /**< Payload still to be fetched from CanIf */
+#endif
+} Can_TxFrameType;
+
+/**
+ * @brief   CAN TX Buffer
+ * @details Per-HTH buffer of frames waiting for a free mailbox. Frame[] is sorted by descending
+ *          Priority key, so the frame that wins arbitration is Frame[Count - 1] and is taken
+ *          without moving the others. AbortPending counts frames of this HTH that are being
+ *          aborted in a mailbox; a slot is reserved for each so they can always be re-queued.
+ */
+typedef struct
+{
+    Can_TxFrameType Frame[CAN_MAX_TX_BUFFER_SIZE]; /**< Waiting frames, highest priority last */
+    uint8 Count;                                  /**< Number of waiting frames */
+    uint8 AbortPending;                           /**< Slots reserved for frames being aborted */
+} Can_TxBufferType;
+
+/**
+ * @brief   CAN TX Mailbox
+ * @details Shadow of one hardware TX mailbox, the mailbox -> HTH -> swPduHandle table used for
+ *          TX confirmation and cancellation. Identifier and payload stay in the mailbox
+ *          registers and are read back from there if the frame is aborted.
+ */
+typedef struct
+{
+    uint32 Priority;                              /**< Arbitration key of the frame in the mailbox */
+    PduIdType swPduHandle;                        /**< CanIf handle for the TX confirmation */
+    Can_HwHandleType Hth;                         /**< HTH the frame was written on */
+    uint8 Sequence;                               /**< Load order, breaks ties between equal keys */
+    boolean Pending;                              /**< Transmission requested and not yet completed */
+    boolean AbortRequested;                       /**< ABRQ set for this mailbox */
+#if (CAN_CANCEL_TX_API == STD_ON)
+    boolean CancelRequested;                      /**< ABRQ set by Can_CancelTx, not requeued */
+#endif
+} Can_TxMailboxType;
+
+/**
+ * @brief   CAN TX Confirmation Entry
+ */
+typedef struct
+{
+    uint32 Priority;                              /**< Arbitration key of the frame */
+    PduIdType swPduHandle;                        /**< CanIf handle for the TX confirmation */
+    uint8 Sequence;                               /**< Load order of the frame */
+#if (CAN_HW_TIME_STAMP == STD_ON)
+    uint16 Time;                                  /**< TDTxR.TIME, SOF time of the frame */
+#endif
+#if (CAN_GET_EGRESS_TIME_STAMP_API == STD_ON)
+    Can_HwHandleType Hth;                         /**< HTH the frame was written on */
+    uint64 TimeStamp;                             /**< SOF time on the time base (Can_Time) */
+#endif
+#if (CAN_STATISTICS_API == STD_ON)
+    uint32 Tir;                                   /**< CAN_TIxR of the sent frame */
+    uint32 DataLow;                               /**< CAN_TDLxR of the sent frame */
+    uint32 DataHigh;                              /**< CAN_TDHxR of the sent frame */
+    uint8 Length;                                 /**< Data length of the sent frame */
+#endif
+} Can_TxConfirmationEntryType;
+
+/**
+ * @brief   CAN TX Confirmation Batch
+ * @details Transmissions found complete in one TSR read. With TTCM (CAN_HW_TIME_STAMP) they
+ *          are in bus order, by the SOF time the controller stored in TDTxR.TIME. Without it the
+ *          bus order is not recorded and they are in arbitration order, equal identifiers in
+ *          load order: the order in which frames pending together leave. A frame loaded after a
+ *          lower priority one had started may come first although it was sent later.
+ */
+typedef struct
+{
+    Can_TxConfirmationEntryType Entry[CAN_TX_MAILBOX_COUNT]; /**< Confirmations, see above */
+    uint8 Count;                                  /**< Number of entries */
+#if (CAN_CANCEL_TX_API == STD_ON)
+    PduIdType Cancelled[CAN_TX_MAILBOX_COUNT];    /**< Frames aborted by Can_CancelTx or not sent */
+    uint8 CancelledCount;                         /**< Number of aborted frames */
+#endif
+} Can_TxConfirmationType;
+
+#if ((CAN_GET_EGRESS_TIME_STAMP_API == STD_ON) || (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON))
+/**
+ * @brief   CAN Frame Time Stamp
+ * @details Time stamp of the frame currently (or last) indicated or confirmed on a handle
+ */
+typedef struct
+{
+    uint64 Time;                                  /**< SOF time on the time base (Can_Time) */
+    PduIdType swPduHandle;                        /**< Confirmed L-PDU (egress only) */
+    boolean Valid;                                /**< A frame has been stamped */
+} Can_FrameTimeStampType;
+#endif
+
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+/**
+ * @brief   CAN Time-triggered Frame
+ * @details Frame written to a time-triggered HTH, held back until the next slot of the HTH
+ */
+typedef struct
+{
+    Can_TxFrameType Frame;                        /**< Frame as mailbox register images */
+    boolean Valid;                                /**< A frame is waiting */
+} Can_TtFrameType;
+
+/**
+ * @brief   CAN Time-triggered Schedule
+ * @details Position of the schedule on the time base. All times are in core clock cycles
+ *          (Can_Time), converted from the microseconds of the configuration by Can_TtInit.
+ */
+typedef struct
+{
+    uint64 CycleStart;                            /**< Start of the current communication cycle */
+    uint32 CycleLength;                           /**< CAN_TT_CYCLE_US */
+    uint32 CyclesPerUs;                           /**< Core clock cycles per microsecond and timer tick */
+    uint32 ReleaseWindow;                         /**< CAN_TT_RELEASE_WINDOW_US */
+    uint32 MaxReleaseDelay;                       /**< Longest slot instant -> TXRQ delay */
+    uint8 NextSlot;                               /**< Next slot of the current cycle */
+    boolean Running;                              /**< Controller started, slots are dispatched */
+    Can_ScheduleStatusType Status;                /**< Counters for Can_GetScheduleStatus */
+} Can_TtScheduleType;
+#endif
+
 typedef struct {
     uint32 Prescaler;
     uint32 SJW;
@@ -100,13 +334,6 @@ typedef enum {
     CAN_BAUD_500KBPS,
     CAN_BAUD_1MBPS
 } Can_BaudrateType;
-
-typedef enum {
-    CAN_MODE_NORMAL          = CAN_Mode_Normal,             /*!< normal mode */
-    CAN_MODE_LOOPBACK        = CAN_Mode_LoopBack,          /*!< loopback mode */
-    CAN_MODE_SILENT          = CAN_Mode_Silent,             /*!< silent mode */
-    CAN_MODE_SILENT_LOOPBACK = CAN_Mode_Silent_LoopBack    /*!< loopback combined with silent mode */
-} Can_ModeType;
 /*==================================================================================================
 *                                       LOCAL MACROS
 ==================================================================================================*/
@@ -117,7 +344,7 @@ typedef enum {
  */
 #define CAN_GET_HW_CONTROLLER(controllerId) \
     ((controllerId) < CAN_MAX_CONTROLLERS ? \
-     (CAN_TypeDef*)Can_ControllerHwConfig[controllerId].BaseAddress : NULL)
+     (CAN_TypeDef*)Can_ControllerHwConfig[controllerId].BaseAddress : NULL_PTR)
 
 /**
  * @brief   CAN Controller Clock Enable Mapping
@@ -141,6 +368,118 @@ typedef enum {
         } \
     } while(0)
 
+/**
+ * @brief   RX Queue Index Mask
+ */
+#define CAN_RX_QUEUE_INDEX_MASK             (CAN_MAX_RX_BUFFER_SIZE - 1U)
+
+/**
+ * @brief   Hardware RX FIFO to HRH Mapping
+ */
+#define CAN_FIFO_TO_HRH(fifoNumber)         ((Can_HwHandleType)(CAN_HRH_0 + (fifoNumber)))
+
+/**
+ * @brief   Number of RX FIFOs per Controller
+ */
+#define CAN_RX_FIFO_COUNT                   (2U)
+
+/**
+ * @brief   CAN1 Interrupt Vector Names
+ * @details Connectivity line devices have no USB device peripheral sharing the CAN1 vectors
+ */
+#if defined(STM32F10X_CL)
+#define CAN1_TX_IRQ_HANDLER                 CAN1_TX_IRQHandler
+#define CAN1_RX0_IRQ_HANDLER                CAN1_RX0_IRQHandler
+#else
+#define CAN1_TX_IRQ_HANDLER                 USB_HP_CAN1_TX_IRQHandler
+#define CAN1_RX0_IRQ_HANDLER                USB_LP_CAN1_RX0_IRQHandler
+#endif
+
+/**
+ * @brief   Bus-off Recovery States
+ */
+#define CAN_BUSOFF_STATE_IDLE               (0U)    /**< On the bus */
+#define CAN_BUSOFF_STATE_WAIT               (1U)    /**< Bus-off, back-off delay running */
+#define CAN_BUSOFF_STATE_INIT               (2U)    /**< Restart: waiting for INAK */
+#define CAN_BUSOFF_STATE_RECOVERING         (3U)    /**< Hardware waiting for 128 x 11 recessive bits */
+
+/**
+ * @brief   Consumed Last Error Code
+ * @details LEC value 7 is never set by hardware; software writes it after counting an error
+ */
+#define CAN_LEC_CONSUMED                    (7U)
+
+/**
+ * @brief   Automatic Bus-off Management
+ * @details Kept off in every CAN_Init call: bus-off recovery is paced by Can_MainFunction_BusOff
+ */
+#define CAN_ABOM_STATE                      DISABLE
+
+/**
+ * @brief   TTCM Setting
+ * @details The TTCM counter provides the SOF time stamps of received and transmitted frames
+ */
+#if (CAN_HW_TIME_STAMP == STD_ON)
+#define CAN_TTCM_STATE                      ENABLE
+#else
+#define CAN_TTCM_STATE                      DISABLE
+#endif
+
+/**
+ * @brief   Initialization Mode Wait
+ * @details Polls of CAN_MSR for INAK after a reset; as CAN_Init, INAK_TIMEOUT of the SPL
+ */
+#define CAN_INAK_WAIT_LOOPS                 (0x0000FFFFUL)
+
+/**
+ * @brief   Time-triggered Schedule Timer
+ * @details TIM2 counts microseconds and wakes the schedule shortly before each slot instant with
+ *          its channel 1 compare interrupt; the instant itself is met by polling the time base.
+ */
+#define CAN_TT_TIMER                        TIM2
+#define CAN_TT_TIMER_IRQ_NUMBER             TIM2_IRQn
+#define CAN_TT_TIMER_IRQ_HANDLER            TIM2_IRQHandler
+#define CAN_TT_TIMER_TICK_HZ                (1000000UL)
+
+/**
+ * @brief   Longest Timer Wait
+ * @details Ticks a single compare may lie ahead of the counter. Longer waits are split, the
+ *          schedule re-arms the timer each time it fires early.
+ */
+#define CAN_TT_TIMER_MAX_TICKS              (0xFFF0U)
+
+/**
+ * @brief   Shortest Timer Wait
+ * @details A compare less than two ticks ahead might be passed before it is written
+ */
+#define CAN_TT_TIMER_MIN_TICKS              (2U)
+
+/**
+ * @brief   Slot Polling Time
+ * @details Microseconds before a slot instant from which the time base is polled instead of
+ *          arming the timer; covers the tick granularity of the timer.
+ */
+#define CAN_TT_SPIN_US                      (2U)
+
+/**
+ * @brief   TX Mailbox Status Bits
+ * @details CAN_TSR holds one byte of RQCP/TXOK/ALST/TERR/ABRQ per mailbox and one TME bit each
+ */
+#define CAN_TSR_MAILBOX_SHIFT(mailbox)      ((uint32)(mailbox) * 8U)
+#define CAN_TSR_RQCP(mailbox)               (CAN_TSR_RQCP0 << CAN_TSR_MAILBOX_SHIFT(mailbox))
+#define CAN_TSR_TXOK(mailbox)               (CAN_TSR_TXOK0 << CAN_TSR_MAILBOX_SHIFT(mailbox))
+#define CAN_TSR_ABRQ(mailbox)               (CAN_TSR_ABRQ0 << CAN_TSR_MAILBOX_SHIFT(mailbox))
+#define CAN_TSR_TME_MAILBOX(mailbox)        (CAN_TSR_TME0 << (mailbox))
+
+/**
+ * @brief   TX Mailbox Identifier Register Image
+ * @details CAN_TIxR layout: STID in bits 31..21, or EXID in bits 31..3 with IDE set
+ */
+#define CAN_TX_TIR(canId) \
+    ((((canId) & CAN_ID_EXTENDED_FLAG) != 0U) ? \
+     ((((canId) & CAN_EXT_ID_MASK) << 3U) | CAN_TI0R_IDE) : \
+     (((canId) & CAN_STD_ID_MASK) << 21U))
+
 /**
  * @brief   CAN Controller GPIO Mapping (DEPRECATED)
  * @details This structure is now replaced by Can_ControllerHwConfig in Can_Cfg.c
@@ -158,18 +497,19 @@ typedef enum {
 ==================================================================================================*/
 /**
  * @brief   CAN Baudrate Configuration Table
- * @details Pre-calculated baudrate settings for different speeds
+ * @details Pre-calculated baudrate settings for different speeds, indexed by
+ *          CAN_BAUDRATE_xxx_ID. The CAN clock is PCLK1, 36 MHz (CAN_CLOCK_FREQUENCY).
  */
 // TODO make a function to auto calculate baud rate
 static const Can_BaudrateConfigType Can_BaudrateTable[] = {
-    /* 125kbps: (72MHz / (1 + 13 + 2) / 36) = 125kbps */
-    {36, CAN_SJW_1tq, CAN_BS1_13tq, CAN_BS2_2tq},    
-    /* 250kbps: (72MHz / (1 + 13 + 2) / 18) = 250kbps */
-    {18, CAN_SJW_1tq, CAN_BS1_13tq, CAN_BS2_2tq},    
-    /* 500kbps: (72MHz / (1 + 13 + 2) / 9) = 500kbps */  
-    {9,  CAN_SJW_1tq, CAN_BS1_13tq, CAN_BS2_2tq},    
-    /* 1Mbps: (72MHz / (1 + 13 + 2) / 4.5) = 1Mbps */
-    {4,  CAN_SJW_1tq, CAN_BS1_6tq,  CAN_BS2_1tq}     
+    /* 125kbps: (36MHz / (1 + 13 + 2) / 18) = 125kbps, sample point 87.5% */
+    {18, CAN_SJW_1tq, CAN_BS1_13tq, CAN_BS2_2tq},
+    /* 250kbps: (36MHz / (1 + 13 + 2) / 9) = 250kbps, sample point 87.5% */
+    {9,  CAN_SJW_1tq, CAN_BS1_13tq, CAN_BS2_2tq},
+    /* 500kbps: (36MHz / (1 + 15 + 2) / 4) = 500kbps, sample point 88.9% */
+    {4,  CAN_SJW_1tq, CAN_BS1_15tq, CAN_BS2_2tq},
+    /* 1Mbps: (36MHz / (1 + 15 + 2) / 2) = 1Mbps, sample point 88.9% */
+    {2,  CAN_SJW_1tq, CAN_BS1_15tq, CAN_BS2_2tq}
 };
 
 /*==================================================================================================
@@ -186,106 +526,289 @@ static const Can_BaudrateConfigType Can_BaudrateTable[] = {
 const Can_ConfigType* Can_ConfigPtr = NULL_PTR;
 
 /**
- * @brief CAN Channel Runtime Information
- * @details Array to store runtime information for each CAN channel
+ * @brief CAN Controller Runtime Information
+ * @details Array to store runtime information for each CAN controller
+ */
+static Can_ControllerRuntimeType Can_ControllerRuntime[CAN_MAX_CONTROLLERS];
+
+/**
+ * @brief CAN RX Queues
+ * @details One RX ring per controller and hardware FIFO, drained by Can_MainFunction_Read
+ */
+static Can_RxQueueType Can_RxQueue[CAN_MAX_CONTROLLERS][CAN_RX_FIFO_COUNT];
+
+#if (CAN_RX_PROCESSING == ADAPTIVE)
+/**
+ * @brief CAN Adaptive RX State
+ * @details Reception mode and load of each controller
+ */
+static Can_RxAdaptiveType Can_RxAdaptive[CAN_MAX_CONTROLLERS];
+#endif
+
+/**
+ * @brief CAN Bus-off Recovery
+ * @details Bus-off recovery state and statistics of each controller
+ */
+static Can_BusOffType Can_BusOff[CAN_MAX_CONTROLLERS];
+
+#if ((CAN_STATISTICS_API == STD_ON) && (CAN_BUSOFF_PROCESSING == INTERRUPT))
+/**
+ * @brief CAN Bus Error Interrupts
+ * @details Last error code interrupts taken in the running Can_MainFunction_Read period
+ */
+static uint8 Can_LecIrqCount[CAN_MAX_CONTROLLERS];
+#endif
+
+/**
+ * @brief CAN TX Buffers
+ * @details One priority-sorted buffer per HTH, filled by Can_Write while all mailboxes are busy
+ */
+static Can_TxBufferType Can_TxBuffer[CAN_MAX_HTH_OBJECTS];
+
+/**
+ * @brief CAN TX Mailboxes
+ * @details Shadow of the three hardware TX mailboxes of each controller
+ */
+static Can_TxMailboxType Can_TxMailbox[CAN_MAX_CONTROLLERS][CAN_TX_MAILBOX_COUNT];
+
+/**
+ * @brief CAN TX Load Sequence
+ * @details Incremented for every frame written into a mailbox of the controller
  */
-static Can_ChannelRuntimeType Can_ChannelRuntime[CAN_MAX_CONFIGURED_CHANNELS];
+static uint8 Can_TxSequence[CAN_MAX_CONTROLLERS];
+
+#if (CAN_GET_EGRESS_TIME_STAMP_API == STD_ON)
+/**
+ * @brief CAN Egress Time Stamps
+ * @details Enable flag and time stamp of the last confirmed frame of each HTH. Without
+ *          Can_EnableEgressTimeStamp every HTH is stamped.
+ */
+static boolean Can_EgressTimeStampEnabled[CAN_MAX_HTH_OBJECTS];
+static Can_FrameTimeStampType Can_EgressTimeStamp[CAN_MAX_HTH_OBJECTS];
+#endif
+
+#if (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON)
+/**
+ * @brief CAN Ingress Time Stamps
+ * @details Time stamp and HRH of each frame of the Rx indication batch, by batch position, and
+ *          the position CanIf is indicating (Can_SelectIngressFrame). Batches are indicated one
+ *          after the other from Can_MainFunction_Read, so the slots always hold the frames of the
+ *          indication in progress.
+ */
+static Can_FrameTimeStampType Can_IngressTimeStamp[CAN_RX_INDICATION_BATCH_SIZE];
+static Can_HwHandleType Can_IngressHrh[CAN_RX_INDICATION_BATCH_SIZE];
+static uint8 Can_IngressFrame;
+#endif
+
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+/**
+ * @brief CAN Time-triggered Frames
+ * @details Frame waiting for the next slot of each time-triggered HTH
+ */
+static Can_TtFrameType Can_TtFrame[CAN_MAX_HTH_OBJECTS];
+
+/**
+ * @brief CAN Time-triggered Schedule
+ */
+static Can_TtScheduleType Can_TtSchedule;
+#endif
 
 /**
  * @brief CAN Driver State
  */
-static boolean Can_DriverInitialized = CAN_UNINIT;
+static boolean Can_DriverInitialized = FALSE;
+
+#if (CAN_RX_FILTER_API == STD_ON)
+/**
+ * @brief CAN Rx Filter Banks
+ * @details Register images of the banks compiled by Can_SetRxFilter, per controller
+ */
+static Can_FilterBankType Can_FilterBank[CAN_MAX_CONTROLLERS][CAN_MAX_FILTER_COUNT];
+
+/**
+ * @brief CAN Rx Filter Reports
+ * @details Result of the last Can_SetRxFilter call, per controller
+ */
+static Can_FilterReportType Can_FilterReport[CAN_MAX_CONTROLLERS];
+#endif
 
 /*==================================================================================================
 *                                   LOCAL FUNCTION PROTOTYPES
 ==================================================================================================*/
 
-static void Can_InitHw(uint8 Controller, const Can_ChannelConfigType* ChannelConfig);
-static inline void Can_DeInitChannel(uint8 Controller);
+static inline boolean Can_IsControllerEnabled(uint8 Controller);
 
-static inline void Can_HwConfig(uint8 Controller, uint32 BaudRate);
+static inline Std_ReturnType Can_HwConfig(uint8 Controller, uint16 BaudrateID);
+static inline void Can_ModeConfig(uint8 Controller, uint8 TestMode);
 static inline void Can_FilterConfig(uint8 Controller);
 static inline void Can_GpioConfig(uint8 Controller);
 
-// Two way to config baud rate
-// Using id default from table or set up by hand
-static Std_ReturnType Can_BaudrateConfigID(uint8 Controller, uint16 Baudrate);
-static Std_ReturnType Can_BaudrateConfig(uint8 Controller, Can_BaudrateConfigType Baudrate);
+static Std_ReturnType Can_BaudrateConfigID(uint8 Controller, uint16 BaudrateID);
 // TODO: need to set flag
 static inline void Can_EnableInterrupts(uint8 Controller);
 static inline void Can_DisableInterrupts(uint8 Controller);
+#if ((CAN_RX_PROCESSING != POLLING) || (CAN_TX_PROCESSING == INTERRUPT) || (CAN_BUSOFF_PROCESSING == INTERRUPT))
+static inline void Can_NvicConfig(uint8 Controller);
+#endif
+
+#if (CAN_RX_FILTER_API == STD_ON)
+static void Can_FilterApply(uint8 Controller);
+#endif
+
+static void Can_RxQueueReset(uint8 Controller);
+static void Can_RxDrainFifo(uint8 Controller, uint8 FifoNumber);
+static void Can_RxQueueProcess(uint8 Controller, uint8 FifoNumber);
+#if (CAN_RX_PROCESSING == ADAPTIVE)
+static void Can_RxAdaptiveReset(uint8 Controller);
+static void Can_RxAdaptiveUpdate(uint8 Controller);
+#endif
 
+static inline uint32 Can_EnterCritical(void);
+static inline void Can_ExitCritical(uint32 PriMask);
+static void Can_TxReset(uint8 Controller);
+static uint8 Can_TxFreeMailbox(uint8 Controller, uint8 MailboxMask);
+static inline boolean Can_TxFetchData(Can_TxFrameType* Frame);
+static inline void Can_TxPackData(const uint8* SduPtr, uint8 Length, uint32* DataLowPtr, uint32* DataHighPtr);
+static inline void Can_TxMailboxLoad(uint8 Controller, uint8 Mailbox, Can_HwHandleType Hth,
+                                     const Can_TxFrameType* Frame, uint32 Tdtr);
+static void Can_TxMailboxWrite(uint8 Controller, uint8 Mailbox, Can_HwHandleType Hth, const Can_TxFrameType* Frame);
+static boolean Can_TxBufferInsert(Can_HwHandleType Hth, const Can_TxFrameType* Frame, boolean Requeue);
+static Can_HwHandleType Can_TxBestHth(uint8 Controller, uint8 Mailbox);
+static void Can_TxRefill(uint8 Controller);
+#if (CAN_HW_TRANSMIT_CANCELLATION == STD_ON)
+static void Can_TxAbortLowestPriority(uint8 Controller);
+#endif
+#if (CAN_TIME_BASE == STD_ON)
+static void Can_TimeStampInit(void);
+#endif
+#if ((CAN_HW_TIME_STAMP == STD_ON) || (CAN_STATISTICS_API == STD_ON))
+static uint32 Can_GetBitCycles(uint8 Controller);
+#endif
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+static void Can_TtInit(void);
+static void Can_TtStart(void);
+static void Can_TtStop(void);
+static void Can_TtSync(uint64 SofTime);
+static void Can_TtArm(uint64 Wait);
+static void Can_TtRelease(const Can_TtSlotConfigType* Slot, uint32 Delay);
+static void Can_TtDispatch(void);
+#endif
+#if (CAN_STATISTICS_API == STD_ON)
+static uint16 Can_TxFrameBits(uint32 Tir, uint32 DataLow, uint32 DataHigh, uint8 Length);
+static void Can_StatsSample(uint8 Controller, uint64 Now);
+#if (CAN_BUSOFF_PROCESSING == INTERRUPT)
+static void Can_StatsLecIsr(uint8 Controller);
+#endif
+#endif
+static inline CanIf_ControllerModeType Can_ToCanIfMode(Can_ControllerStateType State);
+static void Can_BusOffReset(uint8 Controller);
+static void Can_BusOffEnter(uint8 Controller);
+static boolean Can_BusOffRecover(uint8 Controller);
+static void Can_BusOffProcess(uint8 Controller);
+#if (CAN_BUSOFF_PROCESSING == INTERRUPT)
+static void Can_BusOffIsr(uint8 Controller);
+#endif
+static void Can_TxCollect(uint8 Controller, Can_TxConfirmationType* Batch);
+static void Can_TxConfirm(uint8 Controller, const Can_TxConfirmationType* Batch);
+static void Can_TxProcess(uint8 Controller);
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+static boolean Can_ValidateWrite(uint8 ServiceId, Can_HwHandleType Hth, const Can_PduType* PduInfo);
+#endif
+__STATIC_FORCEINLINE Std_ReturnType Can_WriteInline(Can_HwHandleType Hth, const Can_PduType* PduInfo, uint8 Length);
 
 #if (CAN_DEV_ERROR_DETECT == STD_ON)
-static inline boolean Can_ValidateDriverInitialized(void);
 /**
- * @brief   Validate group parameter
- * @details This function validates if the group parameter is within valid range
+ * @brief   Validate controller parameter
+ * @details This function validates if the controller ID is in range and enabled in configuration
  * 
- * @param[in]   Group           Group ID to validate
+ * @param[in]   Controller      Controller ID to validate
  * 
- * @return      boolean         TRUE if group is valid, FALSE otherwise
+ * @return      boolean         TRUE if controller is valid, FALSE otherwise
  */
-
-static inline boolean Can_ValidateChannel(Can_ChannelType Channel);
-
+static inline boolean Can_ValidateController(uint8 Controller);
 
 /**
- * @brief   Validate pointer parameter
- * @details This function validates if the pointer parameter is not NULL
- * 
- * @param[in]   Pointer         Pointer to validate
- * 
- * @return      boolean         TRUE if pointer is valid, FALSE otherwise
+ * @brief   Validate the HTH mailbox allocation
+ * @details Every HTH needs at least one mailbox and a FullCAN or time-triggered HTH exactly one,
+ *          which no other HTH of the same controller may use. Time-triggered HTHs belong to
+ *          CAN_TT_CONTROLLER, and the schedule slots are sorted, within the cycle and refer to
+ *          time-triggered HTHs.
+ *
+ * @return      boolean         TRUE if the allocation is consistent, FALSE otherwise
  */
-static inline boolean Can_ValidatePointer(Can_ChannelConfigType* Pointer);
+static boolean Can_ValidateHthConfig(void);
 #endif
 
 /*==================================================================================================
 *                                   LOCAL FUNCTION 
 ==================================================================================================*/
 
-static inline void Can_HwConfig(uint8 Controller, uint32 BaudRate)
+static inline boolean Can_IsControllerEnabled(uint8 Controller)
+{
+    return (boolean)((Controller < CAN_MAX_CONTROLLERS) &&
+                     (Can_ControllerHwConfig[Controller].Enabled == (boolean)STD_ON));
+}
+
+/**
+ * @brief   Reset a controller and leave it in initialization mode with the given bit timing
+ * @details The controller is not released from initialization mode here, so it never joins
+ *          the bus before Can_SetControllerMode(STARTED), and never with another baudrate.
+ *          INAK follows at once after a reset, as no frame is in progress.
+ *
+ * @return      Std_ReturnType  E_OK, or E_NOT_OK if INAK was not reached or the ID is invalid
+ */
+static inline Std_ReturnType Can_HwConfig(uint8 Controller, uint16 BaudrateID)
 {
     CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
-    CAN_InitTypeDef CAN_InitStructure;
+    uint32 Wait = 0U;
     
     /* Validate controller and get hardware pointer */
-    if (CanPtr == NULL || !Can_IsControllerEnabled(Controller)) {
-        return; /* Invalid controller or not enabled */
+    if (CanPtr == NULL_PTR || !Can_IsControllerEnabled(Controller)) {
+        return E_NOT_OK; /* Invalid controller or not enabled */
     }
     
     /* Enable CAN controller clock */
     CAN_ENABLE_CONTROLLER_CLOCK(Controller);
+#if defined(STM32F10X_CL)
+    /* CAN2 is a slave of CAN1: the shared filter banks are clocked by CAN1 */
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_CAN1, ENABLE);
+#endif
     
-    /* Reset CAN controller */
+    /* Reset CAN controller, it leaves reset in sleep mode */
     CAN_DeInit(CanPtr);
-    CAN_StructInit(&CAN_InitStructure);
-
-    /* CAN Cell Configuration */
-    CAN_InitStructure.CAN_TTCM = DISABLE;                  // Time Triggered Communication Mode
-    CAN_InitStructure.CAN_ABOM = DISABLE;                  // Automatic Bus-Off Management
-    CAN_InitStructure.CAN_AWUM = DISABLE;                  // Automatic Wake-Up Mode
-    CAN_InitStructure.CAN_NART = DISABLE;                  // Non-Automatic Retransmission
-    CAN_InitStructure.CAN_RFLM = DISABLE;                  // Receive FIFO Locked Mode
-    CAN_InitStructure.CAN_TXFP = ENABLE;                   // Transmit FIFO Priority
-    CAN_InitStructure.CAN_Mode = CAN_Mode_LoopBack;        // <<<< LOOPBACK MODE FOR TESTING
-    
-    CAN_Init(CanPtr, &CAN_InitStructure);
+
+    /* Request initialization mode */
+    CanPtr->MCR = (CanPtr->MCR & ~(uint32)CAN_MCR_SLEEP) | CAN_MCR_INRQ;
+    while (((CanPtr->MSR & CAN_MSR_INAK) == 0U) && (Wait < CAN_INAK_WAIT_LOOPS))
+    {
+        Wait++;
+    }
+    if ((CanPtr->MSR & CAN_MSR_INAK) == 0U)
+    {
+        return E_NOT_OK;
+    }
+
+    /* CAN Cell Configuration: TTCM and ABOM as configured, no automatic wake-up, automatic
+       retransmission, FIFOs overwrite when full, transmit order by identifier priority */
+    CanPtr->MCR = (CanPtr->MCR & ~(uint32)(CAN_MCR_TTCM | CAN_MCR_ABOM | CAN_MCR_AWUM | CAN_MCR_NART |
+                                           CAN_MCR_RFLM | CAN_MCR_TXFP)) |
+                  ((CAN_TTCM_STATE == ENABLE) ? CAN_MCR_TTCM : 0U) |
+                  ((CAN_ABOM_STATE == ENABLE) ? CAN_MCR_ABOM : 0U);
+
+    return Can_BaudrateConfigID(Controller, BaudrateID);
 }
 
-static inline void Can_ModeConfig(uint8 Controller, Can_ModeType Can_Mode)
+/**
+ * @brief   Program the test mode bits of CAN_BTR
+ * @details LBKM and SILM are only writable in initialization mode, the caller makes sure the
+ *          controller is stopped. The bit timing fields are kept.
+ */
+static inline void Can_ModeConfig(uint8 Controller, uint8 TestMode)
 {
     CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
-    CAN_InitTypeDef CAN_InitStructure;
-    
-    /* Validate controller */
-    if (CanPtr == NULL || !Can_IsControllerEnabled(Controller)) {
-        return; /* Invalid controller or not enabled */
-    }
-    
-    CAN_InitStructure.CAN_Mode = Can_Mode;        // Set desired CAN mode
-    CAN_Init(CanPtr, &CAN_InitStructure);
+
+    CanPtr->BTR = (CanPtr->BTR & ~(uint32)(CAN_BTR_LBKM | CAN_BTR_SILM)) | ((uint32)TestMode << 30U);
+    Can_ControllerRuntime[Controller].TestMode = TestMode;
 }
 
 static inline void Can_FilterConfig(uint8 Controller)
@@ -294,12 +817,17 @@ static inline void Can_FilterConfig(uint8 Controller)
     CAN_FilterInitTypeDef CAN_FilterInitStructure;
     
     /* Validate controller */
-    if (CanPtr == NULL || !Can_IsControllerEnabled(Controller)) {
+    if (CanPtr == NULL_PTR || !Can_IsControllerEnabled(Controller)) {
         return; /* Invalid controller or not enabled */
     }
     
-    /* Configure filter based on controller ID to avoid conflicts */
-    CAN_FilterInitStructure.CAN_FilterNumber = Controller;  /* Use controller ID as filter number */
+#if defined(STM32F10X_CL)
+    /* Split the shared banks; CAN_DeInit(CAN1) resets CAN2SB, so program it per controller */
+    CAN_SlaveStartBank(CAN_CONTROLLER_1_FILTER_BANK_START);
+#endif
+
+    /* Accept-all filter in the first bank of the controller until Can_SetRxFilter is called */
+    CAN_FilterInitStructure.CAN_FilterNumber = Can_ControllerHwConfig[Controller].FilterBankStart;
     CAN_FilterInitStructure.CAN_FilterMode = CAN_FilterMode_IdMask;
     CAN_FilterInitStructure.CAN_FilterScale = CAN_FilterScale_32bit;
     CAN_FilterInitStructure.CAN_FilterIdHigh = 0x0000;
@@ -339,18 +867,14 @@ static inline void Can_GpioConfig(uint8 Controller)
 }
 
 /**
- * @brief   Configure CAN controller baudrate using predefined ID
+ * @brief   Program the bit timing of a controller from Can_BaudrateTable
+ * @details CAN_BTR is only writable in initialization mode, the caller makes sure INAK is set.
+ *          The test mode bits are kept.
  */
 static Std_ReturnType Can_BaudrateConfigID(uint8 Controller, uint16 BaudrateID)
 {
-    Std_ReturnType ReturnValue = E_NOT_OK;
     CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
-    CAN_InitTypeDef CAN_InitStructure;
-    
-    /* Validate controller */
-    if (CanPtr == NULL || !Can_IsControllerEnabled(Controller)) {
-        return E_NOT_OK;
-    }
+    const Can_BaudrateConfigType* Baudrate;
     
     /* Validate baudrate configuration ID */
     if (BaudrateID >= (sizeof(Can_BaudrateTable) / sizeof(Can_BaudrateTable[0])))
@@ -358,89 +882,43 @@ static Std_ReturnType Can_BaudrateConfigID(uint8 Controller, uint16 BaudrateID)
         return E_NOT_OK;
     }
 
-    /* Initialize CAN structure */
-    CAN_StructInit(&CAN_InitStructure);
-    
-    /* Configure timing parameters */
-    CAN_InitStructure.CAN_Prescaler = Can_BaudrateTable[BaudrateID].Prescaler;
-    CAN_InitStructure.CAN_SJW       = Can_BaudrateTable[BaudrateID].SJW;
-    CAN_InitStructure.CAN_BS1       = Can_BaudrateTable[BaudrateID].BS1;
-    CAN_InitStructure.CAN_BS2       = Can_BaudrateTable[BaudrateID].BS2;
-    
-    /* Configure CAN operating mode */
-    CAN_InitStructure.CAN_TTCM = DISABLE;  /* Time Triggered Communication Mode */
-    CAN_InitStructure.CAN_ABOM = ENABLE;   /* Automatic Bus-Off Management */
-    CAN_InitStructure.CAN_AWUM = ENABLE;   /* Automatic Wake-Up Mode */
-    CAN_InitStructure.CAN_NART = DISABLE;  /* Non-Automatic Retransmission */
-    CAN_InitStructure.CAN_RFLM = DISABLE;  /* Receive FIFO Locked Mode */
-    CAN_InitStructure.CAN_TXFP = DISABLE;  /* Transmit FIFO Priority */
-    CAN_InitStructure.CAN_Mode = CAN_Mode_Normal;  /* Normal operating mode */
-    
-    /* Initialize CAN controller */
-    if (CAN_Init(CanPtr, &CAN_InitStructure) == CAN_InitStatus_Success)
-    {
-        ReturnValue = E_OK;
-    }
-    
-    return ReturnValue;
-}
+    Baudrate = &Can_BaudrateTable[BaudrateID];
+    CanPtr->BTR = ((uint32)Can_ControllerRuntime[Controller].TestMode << 30U) |
+                  (Baudrate->SJW << 24U) | (Baudrate->BS2 << 20U) | (Baudrate->BS1 << 16U) |
+                  (Baudrate->Prescaler - 1U);
 
+    return E_OK;
+}
 
-static Std_ReturnType Can_BaudrateConfig(uint8 Controller, Can_BaudrateConfigType Baudrate)
+// TODO: need to set flag
+static inline void Can_EnableInterrupts(uint8 Controller)
 {
-    Std_ReturnType ReturnValue = E_NOT_OK;
     CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
-    CAN_InitTypeDef CAN_InitStructure;
     
     /* Validate controller */
-    if (CanPtr == NULL || !Can_IsControllerEnabled(Controller)) {
-        return E_NOT_OK;
-    }
-
-    /* Initialize CAN structure */
-    CAN_StructInit(&CAN_InitStructure);
-    
-    /* Configure timing parameters */
-    CAN_InitStructure.CAN_Prescaler = Baudrate.Prescaler;
-    CAN_InitStructure.CAN_SJW       = Baudrate.SJW;
-    CAN_InitStructure.CAN_BS1       = Baudrate.BS1;
-    CAN_InitStructure.CAN_BS2       = Baudrate.BS2;
-    
-    /* Configure CAN operating mode */
-    CAN_InitStructure.CAN_TTCM = DISABLE;  /* Time Triggered Communication Mode */
-    CAN_InitStructure.CAN_ABOM = ENABLE;   /* Automatic Bus-Off Management */
-    CAN_InitStructure.CAN_AWUM = ENABLE;   /* Automatic Wake-Up Mode */
-    CAN_InitStructure.CAN_NART = DISABLE;  /* Non-Automatic Retransmission */
-    CAN_InitStructure.CAN_RFLM = DISABLE;  /* Receive FIFO Locked Mode */
-    CAN_InitStructure.CAN_TXFP = DISABLE;  /* Transmit FIFO Priority */
-    CAN_InitStructure.CAN_Mode = CAN_Mode_Normal;  /* Normal operating mode */
-    
-    /* Initialize CAN controller */
-    if (CAN_Init(CanPtr, &CAN_InitStructure) == CAN_InitStatus_Success)
-    {
-        ReturnValue = E_OK;
-    }
-    
-    return ReturnValue;
-}
-
-// TODO: need to set flag
-static inline void Can_EnableInterrupts(uint8 Controller)
-{
-    CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
-    
-    /* Validate controller */
-    if (CanPtr == NULL || !Can_IsControllerEnabled(Controller)) {
-        return; /* Invalid controller or not enabled */
+    if (CanPtr == NULL_PTR || !Can_IsControllerEnabled(Controller)) {
+        return; /* Invalid controller or not enabled */
     }
     
     /* Enable CAN interrupts */
-    CAN_ITConfig(CanPtr, CAN_IT_TME, ENABLE);    /* Transmit mailbox empty interrupt */
+#if (CAN_RX_PROCESSING != POLLING)
     CAN_ITConfig(CanPtr, CAN_IT_FMP0, ENABLE);   /* FIFO 0 message pending interrupt */
+    CAN_ITConfig(CanPtr, CAN_IT_FOV0, ENABLE);   /* FIFO 0 overrun interrupt */
     CAN_ITConfig(CanPtr, CAN_IT_FMP1, ENABLE);   /* FIFO 1 message pending interrupt */
+    CAN_ITConfig(CanPtr, CAN_IT_FOV1, ENABLE);   /* FIFO 1 overrun interrupt */
+#endif
+#if (CAN_TX_PROCESSING == INTERRUPT)
+    CAN_ITConfig(CanPtr, CAN_IT_TME, ENABLE);    /* Transmit mailbox empty interrupt */
+#endif
+#if (CAN_BUSOFF_PROCESSING == INTERRUPT)
+    CAN_ITConfig(CanPtr, CAN_IT_ERR, ENABLE);    /* Error interrupt (SCE) */
     CAN_ITConfig(CanPtr, CAN_IT_BOF, ENABLE);    /* Bus-off interrupt */
-    CAN_ITConfig(CanPtr, CAN_IT_EPV, ENABLE);    /* Error passive interrupt */
-    CAN_ITConfig(CanPtr, CAN_IT_EWG, ENABLE);    /* Error warning interrupt */
+#if (CAN_STATISTICS_API == STD_ON)
+    CAN_ITConfig(CanPtr, CAN_IT_LEC, ENABLE);    /* Last error code interrupt */
+#endif
+#endif
+
+    Can_ControllerRuntime[Controller].InterruptsEnabled = TRUE;
 }
 
 static inline void Can_DisableInterrupts(uint8 Controller)
@@ -448,7 +926,7 @@ static inline void Can_DisableInterrupts(uint8 Controller)
     CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
     
     /* Validate controller */
-    if (CanPtr == NULL || !Can_IsControllerEnabled(Controller)) {
+    if (CanPtr == NULL_PTR || !Can_IsControllerEnabled(Controller)) {
         return; /* Invalid controller or not enabled */
     }
     
@@ -456,103 +934,3122 @@ static inline void Can_DisableInterrupts(uint8 Controller)
     CAN_ITConfig(CanPtr, CAN_IT_TME, DISABLE);   /* Transmit mailbox empty interrupt */
     CAN_ITConfig(CanPtr, CAN_IT_FMP0, DISABLE);  /* FIFO 0 message pending interrupt */
     CAN_ITConfig(CanPtr, CAN_IT_FMP1, DISABLE);  /* FIFO 1 message pending interrupt */
+    CAN_ITConfig(CanPtr, CAN_IT_FF0, DISABLE);   /* FIFO 0 full interrupt */
+    CAN_ITConfig(CanPtr, CAN_IT_FF1, DISABLE);   /* FIFO 1 full interrupt */
     CAN_ITConfig(CanPtr, CAN_IT_BOF, DISABLE);   /* Bus-off interrupt */
     CAN_ITConfig(CanPtr, CAN_IT_EPV, DISABLE);   /* Error passive interrupt */
     CAN_ITConfig(CanPtr, CAN_IT_EWG, DISABLE);   /* Error warning interrupt */
+    CAN_ITConfig(CanPtr, CAN_IT_LEC, DISABLE);   /* Last error code interrupt */
+    CAN_ITConfig(CanPtr, CAN_IT_ERR, DISABLE);   /* Error interrupt */
+    CAN_ITConfig(CanPtr, CAN_IT_FOV0, DISABLE);  /* FIFO 0 overrun interrupt */
+    CAN_ITConfig(CanPtr, CAN_IT_FOV1, DISABLE);  /* FIFO 1 overrun interrupt */
+
+    Can_ControllerRuntime[Controller].InterruptsEnabled = FALSE;
 }
 
 
+#if ((CAN_RX_PROCESSING != POLLING) || (CAN_TX_PROCESSING == INTERRUPT) || (CAN_BUSOFF_PROCESSING == INTERRUPT))
+/**
+ * @brief   Configure NVIC for the RX, TX and SCE interrupts of a controller
+ * @details FIFO 0, TX and SCE share IrqPriority and never preempt each other. FIFO 1 is the
+ *          high priority lane and gets Rx1IrqPriority, so its frames leave the 3-deep hardware
+ *          FIFO even while the other CAN ISRs run. It is the only producer of its own RX queue.
+ */
+static inline void Can_NvicConfig(uint8 Controller)
+{
+    NVIC_InitTypeDef NVIC_InitStructure;
+    const Can_ControllerHwConfigType* HwConfig = &Can_ControllerHwConfig[Controller];
+
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = HwConfig->IrqPriority;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0U;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+
+#if (CAN_RX_PROCESSING != POLLING)
+    NVIC_InitStructure.NVIC_IRQChannel = HwConfig->RxIrqNumber;
+    NVIC_Init(&NVIC_InitStructure);
+
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = HwConfig->Rx1IrqPriority;
+    NVIC_InitStructure.NVIC_IRQChannel = HwConfig->Rx1IrqNumber;
+    NVIC_Init(&NVIC_InitStructure);
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = HwConfig->IrqPriority;
+#endif
+
+#if (CAN_TX_PROCESSING == INTERRUPT)
+    NVIC_InitStructure.NVIC_IRQChannel = HwConfig->TxIrqNumber;
+    NVIC_Init(&NVIC_InitStructure);
+#endif
+
+#if (CAN_BUSOFF_PROCESSING == INTERRUPT)
+    NVIC_InitStructure.NVIC_IRQChannel = HwConfig->ErrorIrqNumber;
+    NVIC_Init(&NVIC_InitStructure);
+#endif
+}
+#endif
+
 #if (CAN_DEV_ERROR_DETECT == STD_ON)
-static inline boolean Can_ValidateDriverInitialized(void);
+static inline boolean Can_ValidateController(uint8 Controller)
+{
+    return Can_IsControllerEnabled(Controller);
+}
+
+static boolean Can_ValidateHthConfig(void)
+{
+    const Can_HthConfigType* HthConfig;
+    Can_HwHandleType Hth;
+    Can_HwHandleType OtherHth;
+    uint8 MailboxMask;
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+    uint8 Slot;
+#endif
+
+    for (Hth = 0U; Hth < CAN_MAX_HTH_OBJECTS; Hth++)
+    {
+        HthConfig = &Can_HthConfig[Hth];
+        MailboxMask = HthConfig->MailboxMask & (uint8)(CAN_TX_MAILBOX_MASK(CAN_TX_MAILBOX_COUNT) - 1U);
+
+        if ((HthConfig->ControllerId >= CAN_MAX_CONTROLLERS) || (MailboxMask == 0U))
+        {
+            return FALSE;
+        }
+
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+        if ((HthConfig->HandleType == CAN_HANDLE_TYPE_TIME_TRIGGERED) &&
+            (HthConfig->ControllerId != CAN_TT_CONTROLLER))
+        {
+            return FALSE;
+        }
+#else
+        if (HthConfig->HandleType == CAN_HANDLE_TYPE_TIME_TRIGGERED)
+        {
+            return FALSE;
+        }
+#endif
+
+        if ((HthConfig->HandleType == CAN_HANDLE_TYPE_FULL) ||
+            (HthConfig->HandleType == CAN_HANDLE_TYPE_TIME_TRIGGERED))
+        {
+            /* Exactly one bit set */
+            if ((MailboxMask & (uint8)(MailboxMask - 1U)) != 0U)
+            {
+                return FALSE;
+            }
+
+            for (OtherHth = 0U; OtherHth < CAN_MAX_HTH_OBJECTS; OtherHth++)
+            {
+                if ((OtherHth != Hth) && (Can_HthConfig[OtherHth].ControllerId == HthConfig->ControllerId) &&
+                    ((Can_HthConfig[OtherHth].MailboxMask & MailboxMask) != 0U))
+                {
+                    return FALSE;
+                }
+            }
+        }
+    }
+
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+    for (Slot = 0U; Slot < CAN_TT_SLOT_COUNT; Slot++)
+    {
+        if ((Can_TtSlotConfig[Slot].Hth >= CAN_MAX_HTH_OBJECTS) ||
+            (Can_HthConfig[Can_TtSlotConfig[Slot].Hth].HandleType != CAN_HANDLE_TYPE_TIME_TRIGGERED) ||
+            (Can_TtSlotConfig[Slot].Offset >= CAN_TT_CYCLE_US) ||
+            ((Slot > 0U) && (Can_TtSlotConfig[Slot].Offset < Can_TtSlotConfig[Slot - 1U].Offset)))
+        {
+            return FALSE;
+        }
+    }
+#endif
+
+    return TRUE;
+}
+#endif
+
+#if (CAN_RX_FILTER_API == STD_ON)
 /**
- * @brief   Validate group parameter
- * @details This function validates if the group parameter is within valid range
- * 
- * @param[in]   Group           Group ID to validate
- * 
- * @return      boolean         TRUE if group is valid, FALSE otherwise
+ * @brief   Program the compiled filter banks of a controller
+ * @details Reception through the filters is suspended (FINIT) while the banks are rewritten.
+ *          All banks owned by the controller are deactivated and reset to 16-bit mask / FIFO 0
+ *          first, so that banks left over from a previous configuration neither stay active nor
+ *          shift the filter match index numbering. Filter registers exist in CAN1 only.
  */
+static void Can_FilterApply(uint8 Controller)
+{
+    const Can_ControllerHwConfigType* HwConfig = &Can_ControllerHwConfig[Controller];
+    const Can_FilterBankType* Bank;
+    uint32 BankBit;
+    uint8 Index;
+
+    CAN1->FMR |= CAN_FMR_FINIT;
+
+    for (Index = 0U; Index < HwConfig->FilterBankCount; Index++)
+    {
+        BankBit = (uint32)1UL << (HwConfig->FilterBankStart + Index);
+        CAN1->FA1R &= ~BankBit;
+        CAN1->FM1R &= ~BankBit;
+        CAN1->FS1R &= ~BankBit;
+        CAN1->FFA1R &= ~BankBit;
+    }
 
-static inline boolean Can_ValidateChannel(Can_ChannelType Channel);
+    for (Index = 0U; Index < Can_FilterReport[Controller].BanksUsed; Index++)
+    {
+        Bank = &Can_FilterBank[Controller][Index];
+        BankBit = (uint32)1UL << (HwConfig->FilterBankStart + Bank->FilterNumber);
+
+        CAN1->FM1R = (Bank->Mode == CAN_FILTER_MODE_LIST) ? (CAN1->FM1R | BankBit) : (CAN1->FM1R & ~BankBit);
+        CAN1->FS1R = (Bank->Scale == CAN_FILTER_SCALE_32BIT) ? (CAN1->FS1R | BankBit) : (CAN1->FS1R & ~BankBit);
+        CAN1->FFA1R = (Bank->Fifo != 0U) ? (CAN1->FFA1R | BankBit) : (CAN1->FFA1R & ~BankBit);
+        CAN1->sFilterRegister[HwConfig->FilterBankStart + Bank->FilterNumber].FR1 = Bank->FR1;
+        CAN1->sFilterRegister[HwConfig->FilterBankStart + Bank->FilterNumber].FR2 = Bank->FR2;
+        CAN1->FA1R |= BankBit;
+    }
 
+    CAN1->FMR &= ~(uint32)CAN_FMR_FINIT;
+}
+#endif
 
 /**
- * @brief   Validate pointer parameter
- * @details This function validates if the pointer parameter is not NULL
- * 
- * @param[in]   Pointer         Pointer to validate
- * 
- * @return      boolean         TRUE if pointer is valid, FALSE otherwise
+ * @brief   Reset the RX queues of a controller
+ */
+static void Can_RxQueueReset(uint8 Controller)
+{
+    uint8 Fifo;
+
+    for (Fifo = 0U; Fifo < CAN_RX_FIFO_COUNT; Fifo++)
+    {
+        Can_RxQueue[Controller][Fifo].Head = 0U;
+        Can_RxQueue[Controller][Fifo].Tail = 0U;
+        Can_RxQueue[Controller][Fifo].QueueOverrunCount = 0U;
+        Can_RxQueue[Controller][Fifo].FifoOverrunCount = 0U;
+        Can_RxQueue[Controller][Fifo].MaxFill = 0U;
+    }
+}
+
+/**
+ * @brief   Move every pending frame of one hardware FIFO into its RX queue
+ * @details Runs in the RX ISR (INTERRUPT) or in Can_MainFunction_Read (POLLING). The FIFO is
+ *          drained completely so that one interrupt entry serves up to three frames and the
+ *          3-deep hardware FIFO is released as early as possible. Frames that do not fit into
+ *          the ring are released from hardware and counted as lost.
+ *
+ *          With CAN_LPDU_CALLOUT_SUPPORT every frame is offered to the callout once it is out of
+ *          the hardware FIFO and before it is published; a frame the callout rejects leaves its
+ *          slot to the next one. Frames the full ring has no slot for still reach the callout
+ *          from a stack copy, so the gateway keeps forwarding while CanIf falls behind.
+ *
+ *          The FIFO output mailbox is read register by register straight into the ring slot,
+ *          the payload with two word stores. CAN_RFxR is written with single bits only: RFOM
+ *          releases the mailbox without clearing FULL/FOVR as a read-modify-write would.
+ *
+ * @param[in]   Controller      Controller ID
+ * @param[in]   FifoNumber      CAN_FIFO0 or CAN_FIFO1
  */
-static inline boolean Can_ValidatePointer(Can_ChannelConfigType* Pointer);
+static void Can_RxDrainFifo(uint8 Controller, uint8 FifoNumber)
+{
+    CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
+    CAN_FIFOMailBox_TypeDef* FifoMailbox = &CanPtr->sFIFOMailBox[FifoNumber];
+    __IO uint32_t* RfrPtr = (FifoNumber == CAN_FIFO0) ? &CanPtr->RF0R : &CanPtr->RF1R;
+    Can_RxQueueType* Queue = &Can_RxQueue[Controller][FifoNumber];
+    Can_RxFrameType* Frame;
+    uint32 Rir;
+    uint32 Rdtr;
+    uint32 Head;
+#if (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON)
+    uint32 PriMask;
+#endif
+#if (CAN_LPDU_CALLOUT_SUPPORT == STD_ON)
+    Can_RxFrameType Spare;
+    Can_HwType Mailbox;
+    PduInfoType PduInfo;
 #endif
 
+    while ((*RfrPtr & CAN_RF0R_FMP0) != 0U)
+    {
+        Rir = FifoMailbox->RIR;
+
+        /* Remote frames are not supported by the AUTOSAR Can driver */
+        if ((Rir & CAN_RI0R_RTR) != 0U)
+        {
+            *RfrPtr = CAN_RF0R_RFOM0;
+            continue;
+        }
+
+        Head = Queue->Head;
+#if (CAN_LPDU_CALLOUT_SUPPORT == STD_ON)
+        Frame = ((Head - Queue->Tail) >= CAN_MAX_RX_BUFFER_SIZE) ? &Spare
+                                                                 : &Queue->Frame[Head & CAN_RX_QUEUE_INDEX_MASK];
+#else
+        if ((Head - Queue->Tail) >= CAN_MAX_RX_BUFFER_SIZE)
+        {
+            *RfrPtr = CAN_RF0R_RFOM0;
+            Queue->QueueOverrunCount++;
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+            (void)Det_ReportRuntimeError(CAN_MODULE_ID, CAN_INSTANCE_ID,
+                                         CAN_MAIN_FUNCTION_READ_SID, CAN_E_DATALOST);
+#endif
+            continue;
+        }
 
+        Frame = &Queue->Frame[Head & CAN_RX_QUEUE_INDEX_MASK];
+#endif
+        if ((Rir & CAN_RI0R_IDE) != 0U)
+        {
+            Frame->CanId = ((Rir >> 3U) & CAN_EXT_ID_MASK) | CAN_ID_EXTENDED_FLAG;
+        }
+        else
+        {
+            Frame->CanId = Rir >> 21U;
+        }
+        Rdtr = FifoMailbox->RDTR;
+        Frame->Hoh = CAN_FIFO_TO_HRH(FifoNumber);
+        Frame->FilterMatchIndex = (uint8)((Rdtr & CAN_RDT0R_FMI) >> 8U);
+        Frame->Length = ((Rdtr & CAN_RDT0R_DLC) > CAN_MAX_DATA_LENGTH) ? CAN_MAX_DATA_LENGTH : (uint8)(Rdtr & CAN_RDT0R_DLC);
+        __UNALIGNED_UINT32_WRITE(&Frame->Data[0], FifoMailbox->RDLR);
+        __UNALIGNED_UINT32_WRITE(&Frame->Data[4], FifoMailbox->RDHR);
+#if (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON)
+        /* The time stamp anchor is shared with the other FIFO and the TX path, and the FIFO 1
+           ISR preempts the FIFO 0 ISR */
+        PriMask = Can_EnterCritical();
+        Frame->TimeStamp = Can_Time_FromFrame(Controller, (uint16)(Rdtr >> 16U),
+                                              CAN_TIME_FRAME_BITS((Rir & CAN_RI0R_IDE) != 0U, Frame->Length),
+                                              Can_Time_Now());
+        Can_ExitCritical(PriMask);
+#endif
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+        if ((Controller == CAN_TT_CONTROLLER) && (Frame->CanId == CAN_TT_REFERENCE_ID))
+        {
+            Can_TtSync(Frame->TimeStamp);
+        }
+#endif
 
+        /* Release the FIFO output mailbox */
+        *RfrPtr = CAN_RF0R_RFOM0;
+
+#if (CAN_LPDU_CALLOUT_SUPPORT == STD_ON)
+        Mailbox.CanId = Frame->CanId;
+        Mailbox.Hoh = Frame->Hoh;
+        Mailbox.ControllerId = Controller;
+        Mailbox.FilterMatchIndex = Frame->FilterMatchIndex;
+        PduInfo.SduDataPtr = Frame->Data;
+        PduInfo.MetaDataPtr = NULL_PTR;
+        PduInfo.SduLength = Frame->Length;
+        if (CAN_LPDU_CALLOUT_NAME(&Mailbox, &PduInfo) == FALSE)
+        {
+            continue;
+        }
+
+        if (Frame == &Spare)
+        {
+            Queue->QueueOverrunCount++;
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+            (void)Det_ReportRuntimeError(CAN_MODULE_ID, CAN_INSTANCE_ID,
+                                         CAN_MAIN_FUNCTION_READ_SID, CAN_E_DATALOST);
+#endif
+            continue;
+        }
+#endif
 
+        /* Publish the slot only after its content is written */
+        __DMB();
+        Head++;
+        Queue->Head = Head;
+        if ((Head - Queue->Tail) > Queue->MaxFill)
+        {
+            Queue->MaxFill = Head - Queue->Tail;
+        }
+    }
 
-/*==================================================================================================
-*                                    FUNCTION PROTOTYPES
-==================================================================================================*/
+    /* FULL is write-1-to-clear and would keep the FIFO full interrupt pending */
+    if ((*RfrPtr & CAN_RF0R_FULL0) != 0U)
+    {
+        *RfrPtr = CAN_RF0R_FULL0;
+    }
 
+    /* Frames lost in hardware because the FIFO was full */
+    if ((*RfrPtr & CAN_RF0R_FOVR0) != 0U)
+    {
+        *RfrPtr = CAN_RF0R_FOVR0;
+        Queue->FifoOverrunCount++;
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+        (void)Det_ReportRuntimeError(CAN_MODULE_ID, CAN_INSTANCE_ID,
+                                     CAN_MAIN_FUNCTION_READ_SID, CAN_E_DATALOST);
+#endif
+    }
+}
 
-/*======================= Services affecting the complete hardware unit ==========================*/
-void Can_Init(const Can_ConfigType* Config)
+#if (CAN_RX_PROCESSING == ADAPTIVE)
+/**
+ * @brief   Put a controller back into interrupt reception with cleared statistics
+ */
+static void Can_RxAdaptiveReset(uint8 Controller)
+{
+    Can_RxAdaptiveType* Adaptive = &Can_RxAdaptive[Controller];
+
+    Adaptive->LastArrived = 0U;
+    Adaptive->QuietPeriods = 0U;
+    Adaptive->Statistics.Mode = CAN_RX_MODE_INTERRUPT;
+    Adaptive->Statistics.SwitchToPollingCount = 0U;
+    Adaptive->Statistics.SwitchToInterruptCount = 0U;
+    Adaptive->Statistics.LastLoad = 0U;
+    Adaptive->Statistics.PeakLoad = 0U;
+}
+
+/**
+ * @brief   Measure the RX load of one Can_MainFunction_Read period and select the RX mode
+ * @details Only the bulk lane (FIFO 0) is adapted. FIFO 1 carries the high priority frames and
+ *          always interrupts per frame, so a flood on FIFO 0 neither delays nor drops them.
+ *
+ *          In polling mode FIFO 0 is drained first. The FIFO full ISR may drain it as well, so
+ *          this runs with interrupts locked to keep a single producer for the RX queue (at most
+ *          three frames are moved). Switching only rewrites FMPIE0/FFIE0: when the message
+ *          pending interrupt comes back on with frames still in the FIFO, the interrupt fires
+ *          at once, so no frame waits for the next period.
+ */
+static void Can_RxAdaptiveUpdate(uint8 Controller)
 {
+    CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
+    Can_RxAdaptiveType* Adaptive = &Can_RxAdaptive[Controller];
+    uint32 PriMask;
+    uint32 Arrived;
+    uint32 Load;
+
+    PriMask = Can_EnterCritical();
+
+    if (Adaptive->Statistics.Mode == CAN_RX_MODE_POLLING)
+    {
+        Can_RxDrainFifo(Controller, CAN_FIFO0);
+    }
+
+    /* Frames dropped on a full ring count as load too */
+    Arrived = Can_RxQueue[Controller][CAN_FIFO0].Head + Can_RxQueue[Controller][CAN_FIFO0].QueueOverrunCount;
+    Load = Arrived - Adaptive->LastArrived;
+    Adaptive->LastArrived = Arrived;
+    Adaptive->Statistics.LastLoad = Load;
+    if (Load > Adaptive->Statistics.PeakLoad)
+    {
+        Adaptive->Statistics.PeakLoad = Load;
+    }
+
+    if (Adaptive->Statistics.Mode == CAN_RX_MODE_INTERRUPT)
+    {
+        if (Load >= CAN_RX_POLL_ENTER_THRESHOLD)
+        {
+            CanPtr->IER = (CanPtr->IER & ~(uint32)CAN_IER_FMPIE0) | CAN_IER_FFIE0;
+            Adaptive->Statistics.Mode = CAN_RX_MODE_POLLING;
+            Adaptive->Statistics.SwitchToPollingCount++;
+            Adaptive->QuietPeriods = 0U;
+        }
+    }
+    else if (Load <= CAN_RX_POLL_EXIT_THRESHOLD)
+    {
+        Adaptive->QuietPeriods++;
+        if (Adaptive->QuietPeriods >= CAN_RX_POLL_EXIT_PERIODS)
+        {
+            CanPtr->IER = (CanPtr->IER & ~(uint32)CAN_IER_FFIE0) | CAN_IER_FMPIE0;
+            Adaptive->Statistics.Mode = CAN_RX_MODE_INTERRUPT;
+            Adaptive->Statistics.SwitchToInterruptCount++;
+        }
+    }
+    else
+    {
+        Adaptive->QuietPeriods = 0U;
+    }
 
+    Can_ExitCritical(PriMask);
 }
+#endif
 
- void Can_GetVersionInfo(Std_VersionInfoType* versioninfo);
+/**
+ * @brief   Forward all queued frames of one RX lane to CanIf
+ * @details Up to CAN_RX_INDICATION_BATCH_SIZE frames go to CanIf in one call. The payload is
+ *          handed over in place and the slots are only released after CanIf returns, so no
+ *          additional copy is made on the consumer side; the producer sees the ring that much
+ *          fuller while a batch is indicated.
+ *
+ * @param[in]   Controller      Controller ID
+ * @param[in]   FifoNumber      CAN_FIFO0 or CAN_FIFO1
+ */
+static void Can_RxQueueProcess(uint8 Controller, uint8 FifoNumber)
+{
+    Can_RxQueueType* Queue = &Can_RxQueue[Controller][FifoNumber];
+    Can_RxFrameType* Frame;
+    Can_HwType Mailbox[CAN_RX_INDICATION_BATCH_SIZE];
+    PduInfoType PduInfo[CAN_RX_INDICATION_BATCH_SIZE];
+    uint32 Tail = Queue->Tail;
+    uint32 Head;
+    uint8 Count;
+
+    while ((Head = Queue->Head) != Tail)
+    {
+        /* Read the slots only after observing the producer's Head */
+        __DMB();
+
+        for (Count = 0U; (Count < CAN_RX_INDICATION_BATCH_SIZE) && ((Tail + Count) != Head); Count++)
+        {
+            Frame = &Queue->Frame[(Tail + Count) & CAN_RX_QUEUE_INDEX_MASK];
+
+#if (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON)
+            /* Available to Can_GetIngressTimeStamp from within the indication of the frame */
+            Can_IngressTimeStamp[Count].Time = Frame->TimeStamp;
+            Can_IngressTimeStamp[Count].Valid = TRUE;
+            Can_IngressHrh[Count] = Frame->Hoh;
+#endif
+#if (CAN_STATISTICS_API == STD_ON)
+            Can_Stats_CountRx(Controller, Can_Stats_FrameBits(Frame->CanId, Frame->Length, Frame->Data));
+#endif
 
- void Can_DeInit(void);
+            Mailbox[Count].CanId = Frame->CanId;
+            Mailbox[Count].Hoh = Frame->Hoh;
+            Mailbox[Count].ControllerId = Controller;
+            Mailbox[Count].FilterMatchIndex = Frame->FilterMatchIndex;
+            PduInfo[Count].SduDataPtr = Frame->Data;
+            PduInfo[Count].MetaDataPtr = NULL_PTR;
+            PduInfo[Count].SduLength = Frame->Length;
+        }
+
+#if (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON)
+        /* CanIf moves it on with Can_SelectIngressFrame */
+        Can_IngressFrame = 0U;
+#endif
 
-/*======================== Services affecting one single CAN Controller =========================*/
+#if (CAN_RX_INDICATION_BATCH_SIZE > 1U)
+        CanIf_RxIndicationBatch(Mailbox, PduInfo, Count);
+#else
+        CanIf_RxIndication(&Mailbox[0], &PduInfo[0]);
+#endif
 
-Std_ReturnType Can_SetBaudrate (uint8 Controller, uint16 BaudRateConfigID);
+        /* Hand the slots back to the producer */
+        __DMB();
+        Tail += Count;
+        Queue->Tail = Tail;
+    }
+}
 
-Std_ReturnType Can_SetControllerMode (uint8 Controller, Can_ControllerStateType Transition);
+/**
+ * @brief   Enter the driver critical section
+ * @details Can_Write may be called from any task or from CanIf callbacks in interrupt context, so
+ *          the TX buffers and mailbox shadows are protected by masking interrupts (PRIMASK).
+ *
+ * @return  uint32          PRIMASK value to restore with Can_ExitCritical
+ */
+static inline uint32 Can_EnterCritical(void)
+{
+    uint32 PriMask = __get_PRIMASK();
 
-void Can_DisableControllerInterrupts (uint8 Controller);
+    __disable_irq();
+    return PriMask;
+}
 
-void Can_EnableControllerInterrupts (uint8 Controller);
+/**
+ * @brief   Leave the driver critical section
+ */
+static inline void Can_ExitCritical(uint32 PriMask)
+{
+    __set_PRIMASK(PriMask);
+}
 
-Std_ReturnType Can_CheckWakeup (uint8 Controller);
+/**
+ * @brief   Drop all TX buffers and mailbox shadows of a controller
+ * @details Hardware mailboxes are not touched; the caller aborts them if the controller runs.
+ */
+static void Can_TxReset(uint8 Controller)
+{
+    Can_HwHandleType Hth;
+    uint8 Mailbox;
+
+    for (Hth = 0U; Hth < CAN_MAX_HTH_OBJECTS; Hth++)
+    {
+        if (Can_HthConfig[Hth].ControllerId == Controller)
+        {
+            Can_TxBuffer[Hth].Count = 0U;
+            Can_TxBuffer[Hth].AbortPending = 0U;
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+            Can_TtFrame[Hth].Valid = FALSE;
+#endif
+        }
+    }
 
-Std_ReturnType Can_GetControllerErrorState (uint8 ControllerId, Can_ErrorStateType* ErrorStatePtr);
+    for (Mailbox = 0U; Mailbox < CAN_TX_MAILBOX_COUNT; Mailbox++)
+    {
+        Can_TxMailbox[Controller][Mailbox].Pending = FALSE;
+        Can_TxMailbox[Controller][Mailbox].AbortRequested = FALSE;
+#if (CAN_CANCEL_TX_API == STD_ON)
+        Can_TxMailbox[Controller][Mailbox].CancelRequested = FALSE;
+#endif
+    }
+}
 
-Std_ReturnType Can_GetControllerMode (uint8 Controller, Can_ControllerStateType* ControllerModePtr);
+/**
+ * @brief   Find a TX mailbox that can take a new frame
+ * @details A mailbox is free when the hardware reports it empty and its previous request has
+ *          been processed by Can_TxProcess, so no TX confirmation is lost.
+ *
+ * @param[in]   Controller      Controller ID
+ * @param[in]   MailboxMask     Mailboxes to consider (Can_HthConfig MailboxMask)
+ *
+ * @return  uint8           Mailbox number, CAN_TX_MAILBOX_COUNT if none is free
+ */
+static uint8 Can_TxFreeMailbox(uint8 Controller, uint8 MailboxMask)
+{
+    uint32 Tsr = CAN_GET_HW_CONTROLLER(Controller)->TSR;
+    uint8 Mailbox;
 
-Std_ReturnType Can_GetControllerRxErrorCounter (uint8 ControllerId, uint8* RxErrorCounterPtr);
+    for (Mailbox = 0U; Mailbox < CAN_TX_MAILBOX_COUNT; Mailbox++)
+    {
+        if (((MailboxMask & CAN_TX_MAILBOX_MASK(Mailbox)) != 0U) &&
+            ((Tsr & CAN_TSR_TME_MAILBOX(Mailbox)) != 0U) &&
+            (Can_TxMailbox[Controller][Mailbox].Pending == FALSE))
+        {
+            break;
+        }
+    }
 
-Std_ReturnType Can_GetControllerTxErrorCounter (uint8 ControllerId, uint8* TxErrorCounterPtr);
+    return Mailbox;
+}
 
-Std_ReturnType Can_GetCurrentTime (uint8 ControllerId, Can_TimeStampType* timeStampPtr);
+/**
+ * @brief   Fetch the payload of a trigger transmit frame that is about to be loaded
+ * @details The upper layer copies the data through CanIf_TriggerTransmit straight into the two
+ *          register images, at most Frame->Length bytes; the DLC becomes the length it returns.
+ *          Called inside the critical section. Frames with a payload are left untouched.
+ *
+ * @return  boolean         FALSE if the upper layer has no data: the frame is not sent
+ */
+static inline boolean Can_TxFetchData(Can_TxFrameType* Frame)
+{
+#if (CAN_TRIGGER_TRANSMIT_SUPPORT == STD_ON)
+    uint32 Data[2] = { 0UL, 0UL };
+    PduInfoType PduInfo;
 
-void Can_EnableEgressTimeStamp (Can_HwHandleType Hth);
+    if (Frame->TriggerTransmit == FALSE)
+    {
+        return TRUE;
+    }
 
-Std_ReturnType Can_GetEgressTimeStamp (PduIdType TxPduId, Can_HwHandleType Hth, Can_TimeStampType* timeStampPtr);
+    PduInfo.SduDataPtr = (uint8*)Data;
+    PduInfo.MetaDataPtr = NULL_PTR;
+    PduInfo.SduLength = Frame->Length;
+    if ((CanIf_TriggerTransmit(Frame->swPduHandle, &PduInfo) != E_OK) || (PduInfo.SduLength > Frame->Length))
+    {
+        return FALSE;
+    }
 
-Std_ReturnType Can_GetIngressTimeStamp (Can_HwHandleType Hrh, Can_TimeStampType* timeStampPtr);
+    /* Little-endian: byte n of the payload is byte n of the register images */
+    Frame->DataLow = Data[0];
+    Frame->DataHigh = Data[1];
+    Frame->Length = (uint8)PduInfo.SduLength;
+    Frame->TriggerTransmit = FALSE;
+#else
+    (void)Frame;
+#endif
 
-/*=========================== Services affecting a Hardware Handle ==============================*/
+    return TRUE;
+}
 
-Std_ReturnType Can_Write (Can_HwHandleType Hth, const Can_PduType* PduInfo);
+/**
+ * @brief   Pack a payload into the two TX data register images
+ * @details A full 8-byte payload is loaded with two (unaligned) word reads. Shorter payloads are
+ *          assembled byte by byte so that no byte beyond Length is read from the caller's buffer.
+ *          With a constant Length the branches fold away.
+ */
+static inline void Can_TxPackData(const uint8* SduPtr, uint8 Length, uint32* DataLowPtr, uint32* DataHighPtr)
+{
+    uint32 Data[2] = { 0UL, 0UL };
+    uint8 DataIndex;
 
-/* =================================== Call-back notifications ==================================*/
-// TODO : redefined this callback
-boolean Can_LPDU_CalloutName (uint8 Hrh, Can_IdType CanId, uint8 CanDataLegth, const uint8* CanSduPtr);
+    if (Length == CAN_MAX_DATA_LENGTH)
+    {
+        Data[0] = __UNALIGNED_UINT32_READ(&SduPtr[0]);
+        Data[1] = __UNALIGNED_UINT32_READ(&SduPtr[4]);
+    }
+    else
+    {
+        for (DataIndex = 0U; DataIndex < Length; DataIndex++)
+        {
+            Data[DataIndex >> 2U] |= (uint32)SduPtr[DataIndex] << ((DataIndex & 3U) * 8U);
+        }
+    }
 
-/* ===================================== Scheduled functions ====================================*/
+    *DataLowPtr = Data[0];
+    *DataHighPtr = Data[1];
+}
 
-/** This function performs the polling of TX confirmation when CAN_TX_PROCESSING is set to
- POLLING. */
-void Can_MainFunction_Write (void);
+/**
+ * @brief   Request transmission of a frame in a free TX mailbox
+ * @details Payload and DLC are written first; the identifier is written together with TXRQ.
+ *          Tdtr adds the TGT bit for frames that carry the global time.
+ */
+static inline void Can_TxMailboxLoad(uint8 Controller, uint8 Mailbox, Can_HwHandleType Hth,
+                                     const Can_TxFrameType* Frame, uint32 Tdtr)
+{
+    CAN_TxMailBox_TypeDef* TxMailbox = &CAN_GET_HW_CONTROLLER(Controller)->sTxMailBox[Mailbox];
+    Can_TxMailboxType* Shadow = &Can_TxMailbox[Controller][Mailbox];
+
+    Shadow->Priority = Frame->Priority;
+    Shadow->swPduHandle = Frame->swPduHandle;
+    Shadow->Hth = Hth;
+    Shadow->Sequence = Can_TxSequence[Controller];
+    Shadow->Pending = TRUE;
+    Shadow->AbortRequested = FALSE;
+#if (CAN_CANCEL_TX_API == STD_ON)
+    Shadow->CancelRequested = FALSE;
+#endif
+    Can_TxSequence[Controller]++;
 
-void Can_MainFunction_Read (void);
+    TxMailbox->TDTR = Tdtr | Frame->Length;
+    TxMailbox->TDLR = Frame->DataLow;
+    TxMailbox->TDHR = Frame->DataHigh;
+    TxMailbox->TIR = Frame->Tir | CAN_TI0R_TXRQ;
+}
 
-void Can_MainFunction_BusOff (void);
+/**
+ * @brief   Request transmission of a frame in a free TX mailbox
+ */
+static void Can_TxMailboxWrite(uint8 Controller, uint8 Mailbox, Can_HwHandleType Hth, const Can_TxFrameType* Frame)
+{
+    Can_TxMailboxLoad(Controller, Mailbox, Hth, Frame, 0U);
+}
 
-void Can_MainFunction_Wakeup (void);
+/**
+ * @brief   Insert a frame into the TX buffer of an HTH, keeping it sorted by priority
+ * @details A new frame is placed behind frames with the same identifier so that one PDU is sent
+ *          in request order. A requeued (aborted) frame is older than those and goes in front.
+ *
+ * @return  boolean         FALSE if the buffer is full
+ */
+static boolean Can_TxBufferInsert(Can_HwHandleType Hth, const Can_TxFrameType* Frame, boolean Requeue)
+{
+    Can_TxBufferType* Buffer = &Can_TxBuffer[Hth];
+    uint8 Index;
+
+    /* Requeued frames use the slot reserved when their abort was requested */
+    if ((Requeue == FALSE) && (((uint32)Buffer->Count + Buffer->AbortPending) >= CAN_MAX_TX_BUFFER_SIZE))
+    {
+        return FALSE;
+    }
+
+    Index = Buffer->Count;
+    while ((Index > 0U) &&
+           ((Buffer->Frame[Index - 1U].Priority < Frame->Priority) ||
+            ((Requeue == FALSE) && (Buffer->Frame[Index - 1U].Priority == Frame->Priority))))
+    {
+        Buffer->Frame[Index] = Buffer->Frame[Index - 1U];
+        Index--;
+    }
+    Buffer->Frame[Index] = *Frame;
+    Buffer->Count++;
+
+    return TRUE;
+}
+
+/**
+ * @brief   Find the HTH whose next frame wins arbitration, among the HTHs that may use a mailbox
+ *
+ * @param[in]   Controller      Controller ID
+ * @param[in]   Mailbox         Mailbox to be filled
+ *
+ * @return  Can_HwHandleType    HTH, CAN_HW_HANDLE_INVALID if no frame is waiting for the mailbox
+ */
+static Can_HwHandleType Can_TxBestHth(uint8 Controller, uint8 Mailbox)
+{
+    Can_HwHandleType BestHth = CAN_HW_HANDLE_INVALID;
+    uint32 BestPriority = 0xFFFFFFFFUL;
+    const Can_TxBufferType* Buffer;
+    Can_HwHandleType Hth;
+
+    for (Hth = 0U; Hth < CAN_MAX_HTH_OBJECTS; Hth++)
+    {
+        Buffer = &Can_TxBuffer[Hth];
+        if ((Can_HthConfig[Hth].ControllerId == Controller) &&
+            ((Can_HthConfig[Hth].MailboxMask & CAN_TX_MAILBOX_MASK(Mailbox)) != 0U) &&
+            (Buffer->Count > 0U) &&
+            (Buffer->Frame[Buffer->Count - 1U].Priority < BestPriority))
+        {
+            BestPriority = Buffer->Frame[Buffer->Count - 1U].Priority;
+            BestHth = Hth;
+        }
+    }
+
+    return BestHth;
+}
+
+/**
+ * @brief   Move buffered frames into free mailboxes, highest priority first
+ * @details Called inside the critical section. Each free mailbox takes the best frame among the
+ *          HTHs allowed to use it, so a FullCAN mailbox only ever carries its own HTH's frames.
+ */
+static void Can_TxRefill(uint8 Controller)
+{
+    uint32 Tsr = CAN_GET_HW_CONTROLLER(Controller)->TSR;
+    Can_TxBufferType* Buffer;
+    Can_HwHandleType Hth;
+    uint8 Mailbox;
+
+    for (Mailbox = 0U; Mailbox < CAN_TX_MAILBOX_COUNT; Mailbox++)
+    {
+        if (((Tsr & CAN_TSR_TME_MAILBOX(Mailbox)) == 0U) ||
+            (Can_TxMailbox[Controller][Mailbox].Pending == TRUE))
+        {
+            continue;
+        }
+
+        /* A trigger transmit frame without data gives the mailbox to the next frame */
+        for (Hth = Can_TxBestHth(Controller, Mailbox); Hth != CAN_HW_HANDLE_INVALID; Hth = Can_TxBestHth(Controller, Mailbox))
+        {
+            Buffer = &Can_TxBuffer[Hth];
+            Buffer->Count--;
+            if (Can_TxFetchData(&Buffer->Frame[Buffer->Count]) == TRUE)
+            {
+                Can_TxMailboxWrite(Controller, Mailbox, Hth, &Buffer->Frame[Buffer->Count]);
+                break;
+            }
+        }
+    }
+}
+
+#if (CAN_HW_TRANSMIT_CANCELLATION == STD_ON)
+/**
+ * @brief   Abort the lowest-priority mailbox if a buffered frame would win arbitration against it
+ * @details Called inside the critical section. A buffered frame is only compared with the
+ *          mailboxes its HTH may use. Only one abort per controller is in flight: the mailbox it
+ *          frees is refilled with the best eligible buffered frame, and the check is repeated
+ *          from Can_TxProcess. The aborted frame goes back into its TX buffer, for which a slot
+ *          is reserved here. If that buffer is full the mailbox is left alone.
+ */
+static void Can_TxAbortLowestPriority(uint8 Controller)
+{
+    Can_TxMailboxType* Shadow;
+    Can_TxMailboxType* Lowest = NULL_PTR;
+    const Can_TxBufferType* Buffer;
+    Can_HwHandleType Hth;
+    uint8 LowestMailbox = 0U;
+    uint8 Mailbox;
+
+    for (Mailbox = 0U; Mailbox < CAN_TX_MAILBOX_COUNT; Mailbox++)
+    {
+        if (Can_TxMailbox[Controller][Mailbox].AbortRequested == TRUE)
+        {
+            return;
+        }
+    }
 
-void Can_MainFunction_Mode (void);
-void Can_MainFunction_Mode (void);
+    for (Hth = 0U; Hth < CAN_MAX_HTH_OBJECTS; Hth++)
+    {
+        Buffer = &Can_TxBuffer[Hth];
+        if ((Can_HthConfig[Hth].ControllerId != Controller) || (Buffer->Count == 0U))
+        {
+            continue;
+        }
+
+        for (Mailbox = 0U; Mailbox < CAN_TX_MAILBOX_COUNT; Mailbox++)
+        {
+            Shadow = &Can_TxMailbox[Controller][Mailbox];
+            if (((Can_HthConfig[Hth].MailboxMask & CAN_TX_MAILBOX_MASK(Mailbox)) != 0U) &&
+                (Shadow->Pending == TRUE) &&
+#if (CAN_CANCEL_TX_API == STD_ON)
+                (Shadow->CancelRequested == FALSE) &&
+#endif
+                (Shadow->Priority > Buffer->Frame[Buffer->Count - 1U].Priority) &&
+                ((Lowest == NULL_PTR) || (Shadow->Priority > Lowest->Priority)))
+            {
+                Lowest = Shadow;
+                LowestMailbox = Mailbox;
+            }
+        }
+    }
+
+    if ((Lowest != NULL_PTR) &&
+        (((uint32)Can_TxBuffer[Lowest->Hth].Count + Can_TxBuffer[Lowest->Hth].AbortPending) < CAN_MAX_TX_BUFFER_SIZE))
+    {
+        Can_TxBuffer[Lowest->Hth].AbortPending++;
+        Lowest->AbortRequested = TRUE;
+        /* ABRQ is set-only and RQCP is write-1-to-clear: write the single bit, no read-modify-write */
+        CAN_GET_HW_CONTROLLER(Controller)->TSR = CAN_TSR_ABRQ(LowestMailbox);
+    }
+}
+#endif
+
+/**
+ * @brief   Map a controller state onto the mode reported to CanIf
+ */
+static inline CanIf_ControllerModeType Can_ToCanIfMode(Can_ControllerStateType State)
+{
+    CanIf_ControllerModeType Mode;
+
+    switch (State)
+    {
+        case CAN_CS_STARTED:
+            Mode = CANIF_CS_STARTED;
+            break;
+        case CAN_CS_STOPPED:
+            Mode = CANIF_CS_STOPPED;
+            break;
+        case CAN_CS_SLEEP:
+            Mode = CANIF_CS_SLEEP;
+            break;
+        default:
+            Mode = CANIF_CS_UNINIT;
+            break;
+    }
+
+    return Mode;
+}
+
+/**
+ * @brief   Clear the bus-off recovery state and statistics of a controller
+ */
+static void Can_BusOffReset(uint8 Controller)
+{
+    Can_BusOffType* BusOff = &Can_BusOff[Controller];
+
+    BusOff->State = CAN_BUSOFF_STATE_IDLE;
+    BusOff->Delay = 0U;
+    BusOff->Elapsed = 0U;
+    BusOff->StablePeriods = CAN_BUSOFF_STABLE_PERIODS;
+    BusOff->Statistics.BusOffCount = 0U;
+    BusOff->Statistics.RecoveryCount = 0U;
+    BusOff->Statistics.SlowRetryCount = 0U;
+    BusOff->Statistics.LastRecoveryPeriods = 0U;
+    BusOff->Statistics.MaxRecoveryPeriods = 0U;
+    BusOff->Statistics.EpisodeBusOffCount = 0U;
+}
+
+/**
+ * @brief   Take a controller off the bus after a bus-off event
+ * @details Runs in the SCE ISR or in Can_MainFunction_BusOff with interrupts locked. The
+ *          controller is STOPPED for Can_Write, but the frames in the TX mailboxes and buffers
+ *          are kept: the mailboxes keep their transmit requests through initialization mode and
+ *          the buffers are drained again after the recovery. The bus-off interrupt stays masked
+ *          until then. The caller notifies CanIf.
+ */
+static void Can_BusOffEnter(uint8 Controller)
+{
+    Can_BusOffType* BusOff = &Can_BusOff[Controller];
+
+    CAN_GET_HW_CONTROLLER(Controller)->IER &= ~(uint32)CAN_IER_BOFIE;
+
+    Can_ControllerRuntime[Controller].ErrorState = CAN_ERRORSTATE_BUSOFF;
+    Can_ControllerRuntime[Controller].ControllerState = CAN_CS_STOPPED;
+
+    /* A controller that stayed on the bus long enough starts a new episode with fast restarts */
+    if (BusOff->StablePeriods >= CAN_BUSOFF_STABLE_PERIODS)
+    {
+        BusOff->Statistics.EpisodeBusOffCount = 0U;
+    }
+    if (BusOff->Statistics.EpisodeBusOffCount < 0xFFU)
+    {
+        BusOff->Statistics.EpisodeBusOffCount++;
+    }
+    BusOff->Statistics.BusOffCount++;
+
+    if (BusOff->Statistics.EpisodeBusOffCount <= CAN_BUSOFF_FAST_RETRIES)
+    {
+        BusOff->Delay = CAN_BUSOFF_FAST_DELAY;
+    }
+    else
+    {
+        BusOff->Delay = CAN_BUSOFF_SLOW_DELAY;
+        BusOff->Statistics.SlowRetryCount++;
+    }
+
+    BusOff->Elapsed = 0U;
+    BusOff->StablePeriods = 0U;
+    BusOff->State = CAN_BUSOFF_STATE_WAIT;
+}
+
+/**
+ * @brief   Advance the bus-off recovery of a controller as far as the hardware allows
+ * @details Called with interrupts locked. With ABOM cleared the restart is requested by entering
+ *          and leaving initialization mode. No frame is on the bus while bus-off, so INAK
+ *          normally follows INRQ at once and a zero back-off delay restarts within the period
+ *          the bus-off is handled in. The hardware then leaves bus-off by itself after 128
+ *          occurrences of 11 recessive bits.
+ *
+ * @return      boolean         TRUE if the controller is back on the bus
+ */
+static boolean Can_BusOffRecover(uint8 Controller)
+{
+    CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
+    Can_BusOffType* BusOff = &Can_BusOff[Controller];
+
+    if (BusOff->State == CAN_BUSOFF_STATE_WAIT)
+    {
+        if (BusOff->Delay > 0U)
+        {
+            BusOff->Delay--;
+            return FALSE;
+        }
+
+        CanPtr->MCR |= CAN_MCR_INRQ;
+        BusOff->State = CAN_BUSOFF_STATE_INIT;
+    }
+
+    if (BusOff->State == CAN_BUSOFF_STATE_INIT)
+    {
+        if ((CanPtr->MSR & CAN_MSR_INAK) == 0U)
+        {
+            return FALSE;
+        }
+
+        CanPtr->MCR &= ~(uint32)CAN_MCR_INRQ;
+        BusOff->State = CAN_BUSOFF_STATE_RECOVERING;
+    }
+
+    if (((CanPtr->MSR & CAN_MSR_INAK) != 0U) || ((CanPtr->ESR & CAN_ESR_BOFF) != 0U))
+    {
+        return FALSE;
+    }
+
+#if (CAN_HW_TIME_STAMP == STD_ON)
+    /* The TTCM counter restarted with initialization mode */
+    Can_Time_Reset(Controller, Can_GetBitCycles(Controller));
+#endif
+
+    Can_ControllerRuntime[Controller].ErrorState = CAN_ERRORSTATE_ACTIVE;
+    Can_ControllerRuntime[Controller].ControllerState = CAN_CS_STARTED;
+
+    BusOff->State = CAN_BUSOFF_STATE_IDLE;
+    BusOff->Statistics.RecoveryCount++;
+    BusOff->Statistics.LastRecoveryPeriods = BusOff->Elapsed;
+    if (BusOff->Elapsed > BusOff->Statistics.MaxRecoveryPeriods)
+    {
+        BusOff->Statistics.MaxRecoveryPeriods = BusOff->Elapsed;
+    }
+
+#if (CAN_BUSOFF_PROCESSING == INTERRUPT)
+    CanPtr->IER |= CAN_IER_BOFIE;
+#endif
+
+    return TRUE;
+}
+
+/**
+ * @brief   Bus-off detection (POLLING) and recovery of one controller per Can_MainFunction_BusOff
+ * @details CanIf is notified outside the critical section. After the recovery the TX mailboxes
+ *          are refilled from the TX buffers before CanIf learns that the controller runs again.
+ */
+static void Can_BusOffProcess(uint8 Controller)
+{
+    Can_ControllerRuntimeType* Runtime = &Can_ControllerRuntime[Controller];
+    Can_BusOffType* BusOff = &Can_BusOff[Controller];
+    boolean Detected = FALSE;
+    boolean Recovered = FALSE;
+    uint32 PriMask;
+
+    PriMask = Can_EnterCritical();
+
+    if (BusOff->State == CAN_BUSOFF_STATE_IDLE)
+    {
+        if (BusOff->StablePeriods < CAN_BUSOFF_STABLE_PERIODS)
+        {
+            BusOff->StablePeriods++;
+        }
+
+#if (CAN_BUSOFF_PROCESSING == POLLING)
+        if ((Runtime->ControllerState == CAN_CS_STARTED) &&
+            ((CAN_GET_HW_CONTROLLER(Controller)->ESR & CAN_ESR_BOFF) != 0U))
+        {
+            Can_BusOffEnter(Controller);
+            Detected = TRUE;
+        }
+#endif
+    }
+
+    if (BusOff->State != CAN_BUSOFF_STATE_IDLE)
+    {
+        if ((Runtime->ControllerState != CAN_CS_STOPPED) || (Runtime->TransitionPending == TRUE))
+        {
+            /* Sleep was requested meanwhile, which ends the recovery */
+            BusOff->State = CAN_BUSOFF_STATE_IDLE;
+        }
+        else
+        {
+            BusOff->Elapsed++;
+            Recovered = Can_BusOffRecover(Controller);
+        }
+    }
+
+    Can_ExitCritical(PriMask);
+
+    if (Detected == TRUE)
+    {
+        CanIf_ControllerBusOff(Controller);
+    }
+
+    if (Recovered == TRUE)
+    {
+        Can_TxProcess(Controller);
+        CanIf_ControllerModeIndication(Controller, CANIF_CS_STARTED);
+    }
+}
+
+#if (CAN_BUSOFF_PROCESSING == INTERRUPT)
+/**
+ * @brief   SCE interrupt of a controller: bus error counting and bus-off detection
+ */
+static void Can_BusOffIsr(uint8 Controller)
+{
+    CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
+
+    /* ERRI is write-1-to-clear, the other MSR bits are read-only or keep their value on 0 */
+    CanPtr->MSR = CAN_MSR_ERRI;
+
+#if (CAN_STATISTICS_API == STD_ON)
+    Can_StatsLecIsr(Controller);
+#endif
+
+    if (((CanPtr->ESR & CAN_ESR_BOFF) != 0U) &&
+        (Can_BusOff[Controller].State == CAN_BUSOFF_STATE_IDLE) &&
+        (Can_ControllerRuntime[Controller].ControllerState == CAN_CS_STARTED))
+    {
+        Can_BusOffEnter(Controller);
+        CanIf_ControllerBusOff(Controller);
+    }
+}
+#endif
+
+#if (CAN_TIME_BASE == STD_ON)
+/**
+ * @brief   Start the time base and clear the ingress/egress time stamps
+ */
+static void Can_TimeStampInit(void)
+{
+    uint8 Index;
+
+    Can_Time_Init();
+
+#if (CAN_GET_EGRESS_TIME_STAMP_API == STD_ON)
+    for (Index = 0U; Index < CAN_MAX_HTH_OBJECTS; Index++)
+    {
+        Can_EgressTimeStampEnabled[Index] = (boolean)(CAN_ENABLE_EGRESS_TIME_STAMP_API == STD_OFF);
+        Can_EgressTimeStamp[Index].Valid = FALSE;
+    }
+#endif
+
+#if (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON)
+    for (Index = 0U; Index < CAN_RX_INDICATION_BATCH_SIZE; Index++)
+    {
+        Can_IngressTimeStamp[Index].Valid = FALSE;
+    }
+    Can_IngressFrame = 0U;
+#endif
+
+    (void)Index;
+}
+#endif
+
+#if ((CAN_HW_TIME_STAMP == STD_ON) || (CAN_STATISTICS_API == STD_ON))
+/**
+ * @brief   Length of one CAN bit time in core clock cycles
+ * @details Taken from CAN_BTR, so it is valid for every baudrate source: a bit time is
+ *          (BRP + 1) * (3 + TS1 + TS2) PCLK1 cycles, and HCLK is an integer multiple of PCLK1.
+ */
+static uint32 Can_GetBitCycles(uint8 Controller)
+{
+    RCC_ClocksTypeDef Clocks;
+    uint32 Btr = CAN_GET_HW_CONTROLLER(Controller)->BTR;
+
+    RCC_GetClocksFreq(&Clocks);
+
+    return (Clocks.HCLK_Frequency / Clocks.PCLK1_Frequency) *
+           ((Btr & CAN_BTR_BRP) + 1U) *
+           (3U + ((Btr & CAN_BTR_TS1) >> 16U) + ((Btr & CAN_BTR_TS2) >> 20U));
+}
+#endif
+
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+/**
+ * @brief   Set up the schedule timer and clear the schedule
+ * @details The timer runs from the same clock tree as the core, so a timer tick is exactly
+ *          CyclesPerUs time base cycles. APB1 timers run at twice PCLK1 unless APB1 is undivided.
+ */
+static void Can_TtInit(void)
+{
+    Can_TtScheduleType* Schedule = &Can_TtSchedule;
+    RCC_ClocksTypeDef Clocks;
+    NVIC_InitTypeDef NVIC_InitStructure;
+    uint32 TimerClock;
+    Can_HwHandleType Hth;
+
+    for (Hth = 0U; Hth < CAN_MAX_HTH_OBJECTS; Hth++)
+    {
+        Can_TtFrame[Hth].Valid = FALSE;
+    }
+
+    Schedule->CyclesPerUs = SystemCoreClock / CAN_TT_TIMER_TICK_HZ;
+    Schedule->CycleLength = CAN_TT_CYCLE_US * Schedule->CyclesPerUs;
+    Schedule->ReleaseWindow = CAN_TT_RELEASE_WINDOW_US * Schedule->CyclesPerUs;
+    Schedule->MaxReleaseDelay = 0U;
+    Schedule->CycleStart = 0U;
+    Schedule->NextSlot = 0U;
+    Schedule->Running = FALSE;
+    Schedule->Status.Synchronised = FALSE;
+    Schedule->Status.CycleCount = 0U;
+    Schedule->Status.SyncCount = 0U;
+    Schedule->Status.ReleasedCount = 0U;
+    Schedule->Status.EmptyCount = 0U;
+    Schedule->Status.MissedCount = 0U;
+    Schedule->Status.LateCount = 0U;
+    Schedule->Status.MaxReleaseDelay = 0U;
+
+    RCC_GetClocksFreq(&Clocks);
+    TimerClock = (Clocks.HCLK_Frequency == Clocks.PCLK1_Frequency) ? Clocks.PCLK1_Frequency
+                                                                   : (2U * Clocks.PCLK1_Frequency);
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+    CAN_TT_TIMER->CR1 = 0U;
+    CAN_TT_TIMER->DIER = 0U;
+    CAN_TT_TIMER->PSC = (uint16)((TimerClock / CAN_TT_TIMER_TICK_HZ) - 1U);
+    CAN_TT_TIMER->ARR = 0xFFFFU;
+    CAN_TT_TIMER->EGR = TIM_EGR_UG;
+    CAN_TT_TIMER->SR = 0U;
+    CAN_TT_TIMER->CR1 = TIM_CR1_CEN;
+
+    NVIC_InitStructure.NVIC_IRQChannel = CAN_TT_TIMER_IRQ_NUMBER;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = CAN_TT_TIMER_IRQ_PRIORITY;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0U;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+ * @brief   Start the schedule when CAN_TT_CONTROLLER has reached STARTED
+ * @details Until the first reference message the cycle starts now and the schedule runs freely.
+ */
+static void Can_TtStart(void)
+{
+    uint32 PriMask = Can_EnterCritical();
+
+    Can_TtSchedule.CycleStart = Can_Time_Now();
+    Can_TtSchedule.NextSlot = 0U;
+    Can_TtSchedule.Running = TRUE;
+    Can_TtSchedule.Status.Synchronised = FALSE;
+    Can_TtDispatch();
+
+    Can_ExitCritical(PriMask);
+}
+
+/**
+ * @brief   Stop the schedule, called with interrupts locked
+ */
+static void Can_TtStop(void)
+{
+    Can_TtSchedule.Running = FALSE;
+    CAN_TT_TIMER->DIER &= (uint16)~TIM_DIER_CC1IE;
+    CAN_TT_TIMER->SR = (uint16)~TIM_SR_CC1IF;
+}
+
+/**
+ * @brief   Align the schedule to a received reference message
+ * @details The SOF of the reference message is the start of a cycle. If it lies within half a
+ *          cycle of the cycle start the schedule already assumed, it is the same cycle and the
+ *          slots released so far are not released again; otherwise a new cycle begins with the
+ *          first slot. Slots of the old alignment that are now behind by more than the release
+ *          window are skipped by Can_TtDispatch.
+ *
+ * @param[in]   SofTime         Ingress time stamp of the reference message
+ */
+static void Can_TtSync(uint64 SofTime)
+{
+    Can_TtScheduleType* Schedule = &Can_TtSchedule;
+    uint32 PriMask = Can_EnterCritical();
+    uint64 Distance;
+
+    if (Schedule->Running == TRUE)
+    {
+        Distance = (SofTime >= Schedule->CycleStart) ? (SofTime - Schedule->CycleStart)
+                                                     : (Schedule->CycleStart - SofTime);
+        if (Distance >= (uint64)(Schedule->CycleLength / 2U))
+        {
+            Schedule->NextSlot = 0U;
+            Schedule->Status.CycleCount++;
+        }
+
+        Schedule->CycleStart = SofTime;
+        Schedule->Status.Synchronised = TRUE;
+        Schedule->Status.SyncCount++;
+        Can_TtDispatch();
+    }
+
+    Can_ExitCritical(PriMask);
+}
+
+/**
+ * @brief   Let the timer fire before the next slot instant
+ * @details Rounds down, so the compare never fires after the instant; a wait beyond the timer
+ *          range fires early and is re-armed.
+ *
+ * @param[in]   Wait            Time base cycles from now to the start of the polling time
+ */
+static void Can_TtArm(uint64 Wait)
+{
+    uint32 Ticks = CAN_TT_TIMER_MAX_TICKS;
+
+    if (Wait < ((uint64)CAN_TT_TIMER_MAX_TICKS * Can_TtSchedule.CyclesPerUs))
+    {
+        Ticks = (uint32)Wait / Can_TtSchedule.CyclesPerUs;
+    }
+    if (Ticks < CAN_TT_TIMER_MIN_TICKS)
+    {
+        Ticks = CAN_TT_TIMER_MIN_TICKS;
+    }
+
+    CAN_TT_TIMER->CCR1 = (uint16)(CAN_TT_TIMER->CNT + Ticks);
+    CAN_TT_TIMER->SR = (uint16)~TIM_SR_CC1IF;
+    CAN_TT_TIMER->DIER |= TIM_DIER_CC1IE;
+}
+
+/**
+ * @brief   Load the frame waiting on the HTH of a slot into its mailbox
+ * @details Called with interrupts locked at the slot instant. The frame goes through the normal
+ *          mailbox shadow, so its confirmation, egress time stamp and statistics are handled by
+ *          Can_TxProcess like any other frame. A slot without a frame stays empty; a mailbox that
+ *          still holds the frame of an earlier slot keeps it and the new frame waits.
+ *
+ * @param[in]   Slot            Slot being released
+ * @param[in]   Delay           Time base cycles since the slot instant
+ */
+static void Can_TtRelease(const Can_TtSlotConfigType* Slot, uint32 Delay)
+{
+    Can_TtScheduleType* Schedule = &Can_TtSchedule;
+    Can_TtFrameType* Pending = &Can_TtFrame[Slot->Hth];
+    uint8 Mailbox;
+
+    if (Pending->Valid == FALSE)
+    {
+        Schedule->Status.EmptyCount++;
+        return;
+    }
+
+    Mailbox = Can_TxFreeMailbox(CAN_TT_CONTROLLER, Can_HthConfig[Slot->Hth].MailboxMask);
+    if ((Can_ControllerRuntime[CAN_TT_CONTROLLER].ControllerState != CAN_CS_STARTED) ||
+        (Mailbox >= CAN_TX_MAILBOX_COUNT))
+    {
+        Schedule->Status.MissedCount++;
+        return;
+    }
+
+    /* The payload of a trigger transmit frame is taken at the slot instant */
+    if (Can_TxFetchData(&Pending->Frame) == FALSE)
+    {
+        Pending->Valid = FALSE;
+        Schedule->Status.EmptyCount++;
+        return;
+    }
+
+    Can_TxMailboxLoad(CAN_TT_CONTROLLER, Mailbox, Slot->Hth, &Pending->Frame,
+                      (Slot->GlobalTime == TRUE) ? CAN_TDT0R_TGT : 0U);
+    Pending->Valid = FALSE;
+
+    Schedule->Status.ReleasedCount++;
+    if (Delay > Schedule->MaxReleaseDelay)
+    {
+        Schedule->MaxReleaseDelay = Delay;
+    }
+}
+
+/**
+ * @brief   Release every slot that is due and arm the timer for the next one
+ * @details Called with interrupts locked. The last CAN_TT_SPIN_US before an instant are spent
+ *          polling the time base, so the release delay is the locked-interrupt latency of the
+ *          timer interrupt plus a few cycles, independent of the timer tick. A schedule that
+ *          fell more than one cycle behind (e.g. a halted core) resumes at the current cycle.
+ */
+static void Can_TtDispatch(void)
+{
+    Can_TtScheduleType* Schedule = &Can_TtSchedule;
+    const Can_TtSlotConfigType* Slot;
+    uint64 Deadline;
+    uint64 Now;
+    uint64 Behind;
+
+    while (Schedule->Running == TRUE)
+    {
+        Now = Can_Time_Now();
+
+        Behind = (Now > Schedule->CycleStart) ? (Now - Schedule->CycleStart) : 0U;
+        if (Behind >= (2U * (uint64)Schedule->CycleLength))
+        {
+            Schedule->CycleStart += (Behind / Schedule->CycleLength) * Schedule->CycleLength;
+            Schedule->NextSlot = 0U;
+        }
+
+        Slot = &Can_TtSlotConfig[Schedule->NextSlot];
+        Deadline = Schedule->CycleStart + ((uint64)Slot->Offset * Schedule->CyclesPerUs);
+
+        if (Now < Deadline)
+        {
+            if ((Deadline - Now) > ((uint64)CAN_TT_SPIN_US * Schedule->CyclesPerUs))
+            {
+                Can_TtArm((Deadline - Now) - ((uint64)CAN_TT_SPIN_US * Schedule->CyclesPerUs));
+                return;
+            }
+
+            while (Now < Deadline)
+            {
+                Now = Can_Time_Now();
+            }
+        }
+
+        if ((Now - Deadline) > Schedule->ReleaseWindow)
+        {
+            Schedule->Status.LateCount++;
+        }
+        else
+        {
+            Can_TtRelease(Slot, (uint32)(Now - Deadline));
+        }
+
+        Schedule->NextSlot++;
+        if (Schedule->NextSlot >= CAN_TT_SLOT_COUNT)
+        {
+            Schedule->NextSlot = 0U;
+            Schedule->CycleStart += Schedule->CycleLength;
+            Schedule->Status.CycleCount++;
+        }
+    }
+
+    CAN_TT_TIMER->DIER &= (uint16)~TIM_DIER_CC1IE;
+}
+#endif
+
+#if (CAN_STATISTICS_API == STD_ON)
+/**
+ * @brief   On-wire length of a frame given as mailbox register images
+ */
+static uint16 Can_TxFrameBits(uint32 Tir, uint32 DataLow, uint32 DataHigh, uint8 Length)
+{
+    uint8 Data[CAN_MAX_DATA_LENGTH];
+    Can_IdType CanId;
+    uint8 Index;
+
+    if ((Tir & CAN_TI0R_IDE) != 0U)
+    {
+        CanId = (Can_IdType)(Tir >> 3U) | CAN_ID_EXTENDED_FLAG;
+    }
+    else
+    {
+        CanId = (Can_IdType)(Tir >> 21U);
+    }
+
+    for (Index = 0U; Index < 4U; Index++)
+    {
+        Data[Index] = (uint8)(DataLow >> (8U * Index));
+        Data[Index + 4U] = (uint8)(DataHigh >> (8U * Index));
+    }
+
+    return Can_Stats_FrameBits(CanId, Length, Data);
+}
+
+/**
+ * @brief   Close the statistics period of a controller
+ * @details Runs once per Can_MainFunction_Read. The last error code is consumed by writing the
+ *          reserved value 7 back, so an error is counted once whether it is seen here or in the
+ *          SCE interrupt. A throttled error code interrupt is enabled again.
+ */
+static void Can_StatsSample(uint8 Controller, uint64 Now)
+{
+    CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
+    uint32 PriMask;
+    uint32 Esr;
+    uint8 Lec;
+
+    PriMask = Can_EnterCritical();
+    Esr = CanPtr->ESR;
+    Lec = (uint8)((Esr & CAN_ESR_LEC) >> 4U);
+    if ((Lec != CAN_LEC_NONE) && (Lec != CAN_LEC_CONSUMED))
+    {
+        Can_Stats_CountLec(Controller, Lec);
+        CanPtr->ESR = CAN_ESR_LEC;
+    }
+#if (CAN_BUSOFF_PROCESSING == INTERRUPT)
+    Can_LecIrqCount[Controller] = 0U;
+    if (Can_ControllerRuntime[Controller].InterruptsEnabled == TRUE)
+    {
+        CanPtr->IER |= CAN_IER_LECIE;
+    }
+#endif
+    Can_ExitCritical(PriMask);
+
+    Can_Stats_Sample(Controller, Now, (uint8)((Esr & CAN_ESR_TEC) >> 16U), (uint8)((Esr & CAN_ESR_REC) >> 24U));
+}
+
+#if (CAN_BUSOFF_PROCESSING == INTERRUPT)
+/**
+ * @brief   Count the bus error behind a last error code interrupt
+ * @details Masks the interrupt for the rest of the period after CAN_STATISTICS_LEC_IRQ_LIMIT
+ *          errors; Can_StatsSample keeps sampling the error code meanwhile.
+ */
+static void Can_StatsLecIsr(uint8 Controller)
+{
+    CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
+    uint8 Lec = (uint8)((CanPtr->ESR & CAN_ESR_LEC) >> 4U);
+
+    if ((Lec == CAN_LEC_NONE) || (Lec == CAN_LEC_CONSUMED))
+    {
+        return;
+    }
+
+    Can_Stats_CountLec(Controller, Lec);
+    CanPtr->ESR = CAN_ESR_LEC;
+
+    Can_LecIrqCount[Controller]++;
+    if (Can_LecIrqCount[Controller] >= CAN_STATISTICS_LEC_IRQ_LIMIT)
+    {
+        CanPtr->IER &= ~(uint32)CAN_IER_LECIE;
+    }
+}
+#endif
+#endif
+
+/**
+ * @brief   Release the TX mailboxes whose request completed
+ * @details Reads TSR once. Every completed mailbox is released: transmitted frames are added
+ *          to the confirmation batch in the order of Can_TxConfirmationType, aborted frames go
+ *          back into their TX buffer.
+ *          Must be called inside the critical section.
+ *
+ * @param[in]   Controller      Controller ID
+ * @param[out]  Batch           Confirmations to give after leaving the critical section
+ */
+static void Can_TxCollect(uint8 Controller, Can_TxConfirmationType* Batch)
+{
+    CAN_TypeDef* CanPtr = CAN_GET_HW_CONTROLLER(Controller);
+    Can_TxMailboxType* Shadow;
+    Can_TxConfirmationEntryType* Entry;
+    Can_TxFrameType Frame;
+    uint32 Tsr;
+    uint8 Mailbox;
+    uint8 Index;
+#if (CAN_HW_TIME_STAMP == STD_ON)
+    uint16 Time;
+#endif
+#if (CAN_GET_EGRESS_TIME_STAMP_API == STD_ON)
+    uint64 Now = Can_Time_Now();
+#endif
+
+    Batch->Count = 0U;
+#if (CAN_CANCEL_TX_API == STD_ON)
+    Batch->CancelledCount = 0U;
+#endif
+
+    Tsr = CanPtr->TSR;
+    for (Mailbox = 0U; Mailbox < CAN_TX_MAILBOX_COUNT; Mailbox++)
+    {
+        if ((Tsr & CAN_TSR_RQCP(Mailbox)) == 0U)
+        {
+            continue;
+        }
+
+        /* Clears RQCP, TXOK, ALST and TERR of the mailbox */
+        CanPtr->TSR = CAN_TSR_RQCP(Mailbox);
+
+        Shadow = &Can_TxMailbox[Controller][Mailbox];
+        if (Shadow->Pending == FALSE)
+        {
+            continue;
+        }
+
+        if (Shadow->AbortRequested == TRUE)
+        {
+            Can_TxBuffer[Shadow->Hth].AbortPending--;
+        }
+
+        if ((Tsr & CAN_TSR_TXOK(Mailbox)) != 0U)
+        {
+#if (CAN_HW_TIME_STAMP == STD_ON)
+            /* Insertion sort by SOF time; TIME compares modulo 2^16 bit times */
+            Time = (uint16)(CanPtr->sTxMailBox[Mailbox].TDTR >> 16U);
+            Index = Batch->Count;
+            while ((Index > 0U) && ((sint16)(uint16)(Batch->Entry[Index - 1U].Time - Time) > 0))
+#else
+            /* Insertion sort by (Priority, Sequence); Sequence compares modulo 256 */
+            Index = Batch->Count;
+            while ((Index > 0U) &&
+                   ((Batch->Entry[Index - 1U].Priority > Shadow->Priority) ||
+                    ((Batch->Entry[Index - 1U].Priority == Shadow->Priority) &&
+                     ((sint8)(uint8)(Batch->Entry[Index - 1U].Sequence - Shadow->Sequence) > 0))))
+#endif
+            {
+                Batch->Entry[Index] = Batch->Entry[Index - 1U];
+                Index--;
+            }
+            Entry = &Batch->Entry[Index];
+            Entry->Priority = Shadow->Priority;
+            Entry->Sequence = Shadow->Sequence;
+#if (CAN_HW_TIME_STAMP == STD_ON)
+            Entry->Time = Time;
+#endif
+            Entry->swPduHandle = Shadow->swPduHandle;
+#if (CAN_GET_EGRESS_TIME_STAMP_API == STD_ON)
+            /* TDTxR.TIME holds the SOF time until the mailbox is written again */
+            Entry->Hth = Shadow->Hth;
+            Entry->TimeStamp = Can_Time_FromFrame(Controller,
+                (uint16)(CanPtr->sTxMailBox[Mailbox].TDTR >> 16U),
+                CAN_TIME_FRAME_BITS((CanPtr->sTxMailBox[Mailbox].TIR & CAN_TI0R_IDE) != 0U,
+                                    CanPtr->sTxMailBox[Mailbox].TDTR & CAN_TDT0R_DLC),
+                Now);
+#endif
+#if (CAN_STATISTICS_API == STD_ON)
+            /* The frame length is counted after the critical section, from a copy */
+            Entry->Tir = CanPtr->sTxMailBox[Mailbox].TIR;
+            Entry->DataLow = CanPtr->sTxMailBox[Mailbox].TDLR;
+            Entry->DataHigh = CanPtr->sTxMailBox[Mailbox].TDHR;
+            Entry->Length = (uint8)(CanPtr->sTxMailBox[Mailbox].TDTR & CAN_TDT0R_DLC);
+#endif
+            Batch->Count++;
+        }
+#if (CAN_CANCEL_TX_API == STD_ON)
+        else if (Shadow->CancelRequested == TRUE)
+        {
+            /* Cancelled by the upper layer: dropped, even if an inversion abort was in flight */
+            Batch->Cancelled[Batch->CancelledCount] = Shadow->swPduHandle;
+            Batch->CancelledCount++;
+        }
+#endif
+        else if (Shadow->AbortRequested == TRUE)
+        {
+            /* The aborted mailbox still holds the frame */
+            Frame.Priority = Shadow->Priority;
+            Frame.Tir = CanPtr->sTxMailBox[Mailbox].TIR & ~(uint32)CAN_TI0R_TXRQ;
+            Frame.DataLow = CanPtr->sTxMailBox[Mailbox].TDLR;
+            Frame.DataHigh = CanPtr->sTxMailBox[Mailbox].TDHR;
+            Frame.swPduHandle = Shadow->swPduHandle;
+            Frame.Length = (uint8)(CanPtr->sTxMailBox[Mailbox].TDTR & CAN_TDT0R_DLC);
+#if (CAN_TRIGGER_TRANSMIT_SUPPORT == STD_ON)
+            Frame.TriggerTransmit = FALSE;
+#endif
+            (void)Can_TxBufferInsert(Shadow->Hth, &Frame, TRUE);
+        }
+        else
+        {
+            /* Request completed without transmission and without abort: the frame is lost */
+#if (CAN_CANCEL_TX_API == STD_ON)
+            Batch->Cancelled[Batch->CancelledCount] = Shadow->swPduHandle;
+            Batch->CancelledCount++;
+#endif
+        }
+
+        Shadow->Pending = FALSE;
+        Shadow->AbortRequested = FALSE;
+#if (CAN_CANCEL_TX_API == STD_ON)
+        Shadow->CancelRequested = FALSE;
+#endif
+    }
+}
+
+/**
+ * @brief   Give the TX confirmations of a batch to CanIf
+ * @details Called outside the critical section so that CanIf may call Can_Write from its
+ *          callback.
+ */
+static void Can_TxConfirm(uint8 Controller, const Can_TxConfirmationType* Batch)
+{
+    const Can_TxConfirmationEntryType* Entry;
+    uint8 Index;
+
+    for (Index = 0U; Index < Batch->Count; Index++)
+    {
+        Entry = &Batch->Entry[Index];
+#if (CAN_STATISTICS_API == STD_ON)
+        Can_Stats_CountTx(Controller, Can_TxFrameBits(Entry->Tir, Entry->DataLow, Entry->DataHigh, Entry->Length));
+#endif
+#if (CAN_GET_EGRESS_TIME_STAMP_API == STD_ON)
+        /* Available to Can_GetEgressTimeStamp from within the confirmation */
+        if (Can_EgressTimeStampEnabled[Entry->Hth] == TRUE)
+        {
+            Can_EgressTimeStamp[Entry->Hth].Time = Entry->TimeStamp;
+            Can_EgressTimeStamp[Entry->Hth].swPduHandle = Entry->swPduHandle;
+            Can_EgressTimeStamp[Entry->Hth].Valid = TRUE;
+        }
+#endif
+#if (CAN_GATEWAY_SUPPORT == STD_ON)
+        /* Forwarded frames have no CanIf Tx PDU */
+        if (Entry->swPduHandle == CAN_GW_TX_PDU_HANDLE)
+        {
+            continue;
+        }
+#endif
+        CanIf_TxConfirmation(Entry->swPduHandle);
+    }
+
+#if (CAN_CANCEL_TX_API == STD_ON)
+    for (Index = 0U; Index < Batch->CancelledCount; Index++)
+    {
+#if (CAN_GATEWAY_SUPPORT == STD_ON)
+        if (Batch->Cancelled[Index] == CAN_GW_TX_PDU_HANDLE)
+        {
+            continue;
+        }
+#endif
+        CanIf_CancelTxConfirmation(Batch->Cancelled[Index]);
+    }
+#endif
+
+    (void)Controller;
+}
+
+/**
+ * @brief   Handle completed TX mailbox requests of a controller
+ * @details Runs in the TX ISR (INTERRUPT) or in Can_MainFunction_Write (POLLING). Completed
+ *          mailboxes are released with a single TSR read, refilled from the TX buffers, and the
+ *          confirmations of the pass are given as one batch at the end.
+ */
+static void Can_TxProcess(uint8 Controller)
+{
+    Can_TxConfirmationType Batch;
+    uint32 PriMask;
+
+    PriMask = Can_EnterCritical();
+
+    Can_TxCollect(Controller, &Batch);
+    Can_TxRefill(Controller);
+#if (CAN_HW_TRANSMIT_CANCELLATION == STD_ON)
+    Can_TxAbortLowestPriority(Controller);
+#endif
+
+    Can_ExitCritical(PriMask);
+
+    Can_TxConfirm(Controller, &Batch);
+}
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+/**
+ * @brief   Development error checks shared by Can_Write and Can_WriteDlc8
+ */
+static boolean Can_ValidateWrite(uint8 ServiceId, Can_HwHandleType Hth, const Can_PduType* PduInfo)
+{
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, ServiceId, CAN_E_UNINIT);
+        return FALSE;
+    }
+
+    if (Hth >= CAN_MAX_HTH_OBJECTS)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, ServiceId, CAN_E_PARAM_HANDLE);
+        return FALSE;
+    }
+
+    /* Without a payload the HTH must fetch it with CanIf_TriggerTransmit */
+    if ((PduInfo == NULL_PTR) ||
+        ((PduInfo->sdu == NULL_PTR) && (PduInfo->length > 0U) &&
+         ((CAN_TRIGGER_TRANSMIT_SUPPORT == STD_OFF) || (Can_HthConfig[Hth].TriggerTransmit == FALSE))))
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, ServiceId, CAN_E_PARAM_POINTER);
+        return FALSE;
+    }
+
+    if (PduInfo->length > CAN_MAX_DATA_LENGTH)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, ServiceId, CAN_E_PARAM_DATA_LENGTH);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+#endif
+
+/**
+ * @brief   Transmit path shared by Can_Write and Can_WriteDlc8
+ * @details The payload is packed from the caller's buffer straight into mailbox register images.
+ *          If a mailbox is free and no buffered frame is waiting for it, the images are stored
+ *          into the mailbox without any intermediate copy. Otherwise they are buffered by
+ *          priority. Forced inline so that a constant Length removes the packing loop.
+ *
+ * @param[in]   Hth             HTH, already validated
+ * @param[in]   PduInfo         L-PDU, already validated
+ * @param[in]   Length          Payload length to send
+ *
+ * @return      E_OK / E_NOT_OK (controller not started) / CAN_BUSY (TX buffer full)
+ */
+__STATIC_FORCEINLINE Std_ReturnType Can_WriteInline(Can_HwHandleType Hth, const Can_PduType* PduInfo, uint8 Length)
+{
+    Std_ReturnType ReturnValue = CAN_BUSY;
+    Can_TxFrameType Frame;
+    uint32 PriMask;
+    uint8 Controller = Can_HthConfig[Hth].ControllerId;
+    uint8 Mailbox;
+
+    /* The range check also bounds the per-controller arrays when DET is off */
+    if ((Controller >= CAN_MAX_CONTROLLERS) ||
+        (Can_ControllerRuntime[Controller].ControllerState != CAN_CS_STARTED))
+    {
+        return E_NOT_OK;
+    }
+
+    Frame.Priority = CAN_TX_PRIORITY(PduInfo->id);
+    Frame.Tir = CAN_TX_TIR(PduInfo->id);
+    Frame.swPduHandle = PduInfo->swPduHandle;
+    Frame.Length = Length;
+#if (CAN_TRIGGER_TRANSMIT_SUPPORT == STD_ON)
+    /* Only the mailbox is requested, the payload is fetched when it is loaded */
+    Frame.TriggerTransmit = ((PduInfo->sdu == NULL_PTR) && (Can_HthConfig[Hth].TriggerTransmit == TRUE)) ? TRUE : FALSE;
+    if (Frame.TriggerTransmit == TRUE)
+    {
+        Frame.DataLow = 0UL;
+        Frame.DataHigh = 0UL;
+    }
+    else
+#endif
+    {
+        Can_TxPackData(PduInfo->sdu, Length, &Frame.DataLow, &Frame.DataHigh);
+    }
+
+    PriMask = Can_EnterCritical();
+
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+    if (Can_HthConfig[Hth].HandleType == CAN_HANDLE_TYPE_TIME_TRIGGERED)
+    {
+        /* Held back for the next slot of the HTH; one frame waits at a time */
+        if (Can_TtFrame[Hth].Valid == FALSE)
+        {
+            Can_TtFrame[Hth].Frame = Frame;
+            Can_TtFrame[Hth].Valid = TRUE;
+            ReturnValue = E_OK;
+        }
+        Can_ExitCritical(PriMask);
+        return ReturnValue;
+    }
+#endif
+
+    /* A mailbox may only be used directly if no buffered frame is waiting for it */
+    Mailbox = Can_TxFreeMailbox(Controller, Can_HthConfig[Hth].MailboxMask);
+    if ((Mailbox < CAN_TX_MAILBOX_COUNT) && (Can_TxBestHth(Controller, Mailbox) == CAN_HW_HANDLE_INVALID))
+    {
+        /* A trigger transmit frame is fetched right away; no data means no transmission */
+        if (Can_TxFetchData(&Frame) == TRUE)
+        {
+            Can_TxMailboxWrite(Controller, Mailbox, Hth, &Frame);
+            ReturnValue = E_OK;
+        }
+        else
+        {
+            ReturnValue = E_NOT_OK;
+        }
+    }
+    else if (Can_TxBufferInsert(Hth, &Frame, FALSE) == TRUE)
+    {
+        Can_TxRefill(Controller);
+#if (CAN_HW_TRANSMIT_CANCELLATION == STD_ON)
+        Can_TxAbortLowestPriority(Controller);
+#endif
+        ReturnValue = E_OK;
+    }
+    else
+    {
+        /* TX buffer of the HTH is full: CAN_BUSY */
+    }
+
+    Can_ExitCritical(PriMask);
+
+    return ReturnValue;
+}
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+
+
+/*======================= Services affecting the complete hardware unit ==========================*/
+void Can_Init(const Can_ConfigType* Config)
+{
+    uint8 Controller;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Config == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_INIT_SID, CAN_E_PARAM_POINTER);
+        return;
+    }
+
+    if (Can_DriverInitialized == TRUE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_INIT_SID, CAN_E_TRANSITION);
+        return;
+    }
+
+    if (Can_ValidateHthConfig() == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_INIT_SID, CAN_E_INIT_FAILED);
+        return;
+    }
+
+#if (CAN_GATEWAY_SUPPORT == STD_ON)
+    if (Can_Gw_IsConfigValid() == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_INIT_SID, CAN_E_INIT_FAILED);
+        return;
+    }
+#endif
+#endif
+
+    Can_ConfigPtr = Config;
+
+#if (CAN_TIME_BASE == STD_ON)
+    Can_TimeStampInit();
+#endif
+#if (CAN_STATISTICS_API == STD_ON)
+    Can_Stats_Init();
+#endif
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+    Can_TtInit();
+#endif
+#if (CAN_GATEWAY_SUPPORT == STD_ON)
+    Can_Gw_Init();
+#endif
+
+    for (Controller = 0U; Controller < CAN_MAX_CONTROLLERS; Controller++)
+    {
+        Can_ControllerRuntime[Controller].ControllerState = CAN_CS_UNINIT;
+        Can_ControllerRuntime[Controller].RequestedState = CAN_CS_UNINIT;
+        Can_ControllerRuntime[Controller].TransitionPending = FALSE;
+        Can_ControllerRuntime[Controller].ErrorState = CAN_ERRORSTATE_ACTIVE;
+        Can_ControllerRuntime[Controller].InterruptsEnabled = FALSE;
+        Can_ControllerRuntime[Controller].WakeupFlag = FALSE;
+        Can_ControllerRuntime[Controller].RxErrorCounter = 0U;
+        Can_ControllerRuntime[Controller].TxErrorCounter = 0U;
+        Can_ControllerRuntime[Controller].TimeoutCounter = 0U;
+        Can_ControllerRuntime[Controller].TestMode = Can_ControllerHwConfig[Controller].TestMode;
+        Can_RxQueueReset(Controller);
+#if (CAN_RX_PROCESSING == ADAPTIVE)
+        Can_RxAdaptiveReset(Controller);
+#endif
+        Can_TxReset(Controller);
+        Can_BusOffReset(Controller);
+#if (CAN_STATISTICS_API == STD_ON)
+        Can_Stats_Reset(Controller);
+#endif
+#if (CAN_RX_FILTER_API == STD_ON)
+        /* Can_FilterConfig below programs the accept-all default, no compiled banks yet */
+        Can_FilterReport[Controller].BanksUsed = 0U;
+        Can_FilterReport[Controller].BanksAvailable = Can_ControllerHwConfig[Controller].FilterBankCount;
+        Can_FilterReport[Controller].WantedIds = 0U;
+        Can_FilterReport[Controller].AcceptedIds = 0U;
+        Can_FilterReport[Controller].UnwantedIds = 0U;
+#endif
+
+        if (Can_IsControllerEnabled(Controller) == FALSE)
+        {
+            continue;
+        }
+
+        Can_GpioConfig(Controller);
+
+        /* The controller stays in initialization mode until Can_SetControllerMode(STARTED) */
+        if (Can_HwConfig(Controller, CAN_DEFAULT_BAUDRATE_ID) != E_OK)
+        {
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+            (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_INIT_SID, CAN_E_INIT_FAILED);
+#endif
+            continue;
+        }
+        Can_FilterConfig(Controller);
+
+#if ((CAN_RX_PROCESSING != POLLING) || (CAN_TX_PROCESSING == INTERRUPT) || (CAN_BUSOFF_PROCESSING == INTERRUPT))
+        Can_NvicConfig(Controller);
+#endif
+        Can_EnableInterrupts(Controller);
+
+        Can_ControllerRuntime[Controller].ControllerState = CAN_CS_STOPPED;
+    }
+
+    Can_DriverInitialized = TRUE;
+}
+
+ void Can_GetVersionInfo(Std_VersionInfoType* versioninfo);
+
+ void Can_DeInit(void);
+
+/*======================== Services affecting one single CAN Controller =========================*/
+
+#if (CAN_SET_BAUDRATE_API == STD_ON)
+Std_ReturnType Can_SetBaudrate (uint8 Controller, uint16 BaudRateConfigID)
+{
+    const Can_ControllerRuntimeType* Runtime;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_BAUD_RATE_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(Controller) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_BAUD_RATE_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if (BaudRateConfigID >= (sizeof(Can_BaudrateTable) / sizeof(Can_BaudrateTable[0])))
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_BAUD_RATE_SID, CAN_E_PARAM_BAUDRATE);
+        return E_NOT_OK;
+    }
+#endif
+
+    Runtime = &Can_ControllerRuntime[Controller];
+
+    /* CAN_BTR is only writable in initialization mode: stopped, INAK reached, no recovery */
+    if ((Runtime->ControllerState != CAN_CS_STOPPED) ||
+        (Runtime->TransitionPending == TRUE) ||
+        (Can_BusOff[Controller].State != CAN_BUSOFF_STATE_IDLE))
+    {
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_BAUD_RATE_SID, CAN_E_TRANSITION);
+#endif
+        return E_NOT_OK;
+    }
+
+    /* The time base and the statistics take the new bit time when the controller is started */
+    return Can_BaudrateConfigID(Controller, BaudRateConfigID);
+}
+#endif
+
+Std_ReturnType Can_SetControllerMode (uint8 Controller, Can_ControllerStateType Transition)
+{
+    Can_ControllerRuntimeType* Runtime;
+    CAN_TypeDef* CanPtr;
+    uint32 PriMask;
+    Can_TxConfirmationType Batch;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_CONTROLLER_MODE_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(Controller) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_CONTROLLER_MODE_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+#endif
+
+    Runtime = &Can_ControllerRuntime[Controller];
+    CanPtr = CAN_GET_HW_CONTROLLER(Controller);
+
+    /* One transition at a time; the previous one completes in Can_MainFunction_Mode */
+    if (Runtime->TransitionPending == TRUE)
+    {
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_CONTROLLER_MODE_SID, CAN_E_TRANSITION);
+#endif
+        return E_NOT_OK;
+    }
+
+    switch (Transition)
+    {
+        case CAN_CS_STARTED:
+            if (Can_BusOff[Controller].State != CAN_BUSOFF_STATE_IDLE)
+            {
+                /* Bus-off recovery running: restart without the remaining back-off delay,
+                   CanIf_ControllerModeIndication follows once the controller is back on the bus */
+                Can_BusOff[Controller].Delay = 0U;
+                return E_OK;
+            }
+
+            if (Runtime->ControllerState != CAN_CS_STOPPED)
+            {
+                break;
+            }
+
+#if (CAN_HW_TIME_STAMP == STD_ON)
+            /* The TTCM counter restarts, the anchor has to be learned again */
+            Can_Time_Reset(Controller, Can_GetBitCycles(Controller));
+#endif
+#if (CAN_STATISTICS_API == STD_ON)
+            /* The baudrate may have changed while stopped */
+            Can_Stats_SetBitTime(Controller, Can_GetBitCycles(Controller));
+#endif
+
+            /* Leave initialization mode; INAK clears after 11 recessive bits */
+            CanPtr->MCR &= ~(uint32)CAN_MCR_INRQ;
+            Runtime->RequestedState = CAN_CS_STARTED;
+            Runtime->TimeoutCounter = 0U;
+            Runtime->TransitionPending = TRUE;
+            return E_OK;
+
+        case CAN_CS_STOPPED:
+            if ((Runtime->ControllerState != CAN_CS_STARTED) && (Runtime->ControllerState != CAN_CS_SLEEP))
+            {
+                break;
+            }
+
+            /* Confirm what already went out, then cancel pending transmissions without
+               confirmation. Can_Write is refused from here on, before INAK is reached. */
+            PriMask = Can_EnterCritical();
+            Can_TxCollect(Controller, &Batch);
+            CanPtr->TSR = CAN_TSR_ABRQ0 | CAN_TSR_ABRQ1 | CAN_TSR_ABRQ2;
+            Can_TxReset(Controller);
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+            if (Controller == CAN_TT_CONTROLLER)
+            {
+                Can_TtStop();
+            }
+#endif
+            Runtime->ControllerState = CAN_CS_STOPPED;
+            Can_ExitCritical(PriMask);
+            Can_TxConfirm(Controller, &Batch);
+
+            /* Enter initialization mode; INAK is set once the current frame has finished */
+            CanPtr->MCR = (CanPtr->MCR & ~(uint32)CAN_MCR_SLEEP) | CAN_MCR_INRQ;
+            Runtime->RequestedState = CAN_CS_STOPPED;
+            Runtime->TimeoutCounter = 0U;
+            Runtime->TransitionPending = TRUE;
+            return E_OK;
+
+        case CAN_CS_SLEEP:
+            if (Runtime->ControllerState != CAN_CS_STOPPED)
+            {
+                break;
+            }
+
+            /* Enter sleep mode */
+            CanPtr->MCR = (CanPtr->MCR & ~(uint32)CAN_MCR_INRQ) | CAN_MCR_SLEEP;
+            Runtime->RequestedState = CAN_CS_SLEEP;
+            Runtime->TimeoutCounter = 0U;
+            Runtime->TransitionPending = TRUE;
+            return E_OK;
+
+        default:
+            break;
+    }
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_CONTROLLER_MODE_SID, CAN_E_TRANSITION);
+#endif
+
+    return E_NOT_OK;
+}
+
+void Can_DisableControllerInterrupts (uint8 Controller);
+
+void Can_EnableControllerInterrupts (uint8 Controller);
+
+Std_ReturnType Can_CheckWakeup (uint8 Controller);
+
+#if (CAN_GET_CONTROLLER_ERROR_STATE_API == STD_ON)
+Std_ReturnType Can_GetControllerErrorState (uint8 ControllerId, Can_ErrorStateType* ErrorStatePtr)
+{
+    uint32 Esr;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_ERROR_STATE_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(ControllerId) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_ERROR_STATE_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if (ErrorStatePtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_ERROR_STATE_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    /* Bus-off until the recovery has completed, even if BOFF already cleared */
+    Esr = CAN_GET_HW_CONTROLLER(ControllerId)->ESR;
+    if (((Esr & CAN_ESR_BOFF) != 0U) || (Can_BusOff[ControllerId].State != CAN_BUSOFF_STATE_IDLE))
+    {
+        *ErrorStatePtr = CAN_ERRORSTATE_BUSOFF;
+    }
+    else if ((Esr & CAN_ESR_EPVF) != 0U)
+    {
+        *ErrorStatePtr = CAN_ERRORSTATE_PASSIVE;
+    }
+    else
+    {
+        *ErrorStatePtr = CAN_ERRORSTATE_ACTIVE;
+    }
+
+    return E_OK;
+}
+#endif
+
+Std_ReturnType Can_GetControllerMode (uint8 Controller, Can_ControllerStateType* ControllerModePtr)
+{
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_MODE_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(Controller) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_MODE_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if (ControllerModePtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_MODE_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    *ControllerModePtr = Can_ControllerRuntime[Controller].ControllerState;
+
+    return E_OK;
+}
+
+#if (CAN_GET_CONTROLLER_RX_ERROR_COUNTER_API == STD_ON)
+Std_ReturnType Can_GetControllerRxErrorCounter (uint8 ControllerId, uint8* RxErrorCounterPtr)
+{
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_RX_ERROR_COUNTER_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(ControllerId) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_RX_ERROR_COUNTER_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if (RxErrorCounterPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_RX_ERROR_COUNTER_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    *RxErrorCounterPtr = (uint8)((CAN_GET_HW_CONTROLLER(ControllerId)->ESR & CAN_ESR_REC) >> 24U);
+
+    return E_OK;
+}
+#endif
+
+#if (CAN_GET_CONTROLLER_TX_ERROR_COUNTER_API == STD_ON)
+Std_ReturnType Can_GetControllerTxErrorCounter (uint8 ControllerId, uint8* TxErrorCounterPtr)
+{
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_TX_ERROR_COUNTER_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(ControllerId) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_TX_ERROR_COUNTER_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if (TxErrorCounterPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CONTROLLER_TX_ERROR_COUNTER_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    *TxErrorCounterPtr = (uint8)((CAN_GET_HW_CONTROLLER(ControllerId)->ESR & CAN_ESR_TEC) >> 16U);
+
+    return E_OK;
+}
+#endif
+
+#if (CAN_STATISTICS_API == STD_ON)
+Std_ReturnType Can_GetStatistics (uint8 ControllerId, Can_StatisticsType* StatisticsPtr)
+{
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_STATISTICS_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(ControllerId) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_STATISTICS_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if (StatisticsPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_STATISTICS_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    Can_Stats_Get(ControllerId, StatisticsPtr);
+
+    return E_OK;
+}
+#endif
+
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+Std_ReturnType Can_GetScheduleStatus (Can_ScheduleStatusType* StatusPtr)
+{
+    uint32 PriMask;
+    uint32 MaxReleaseDelay;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_SCHEDULE_STATUS_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (StatusPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_SCHEDULE_STATUS_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    PriMask = Can_EnterCritical();
+    *StatusPtr = Can_TtSchedule.Status;
+    MaxReleaseDelay = Can_TtSchedule.MaxReleaseDelay;
+    Can_ExitCritical(PriMask);
+
+    StatusPtr->MaxReleaseDelay = (uint32)(((uint64)MaxReleaseDelay * 1000U) / Can_TtSchedule.CyclesPerUs);
+
+    return E_OK;
+}
+#endif
+
+#if (CAN_SET_CONTROLLER_TEST_MODE_API == STD_ON)
+Std_ReturnType Can_SetControllerTestMode (uint8 Controller, uint8 TestMode)
+{
+    const Can_ControllerRuntimeType* Runtime;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_CONTROLLER_TEST_MODE_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(Controller) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_CONTROLLER_TEST_MODE_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+#endif
+
+    Runtime = &Can_ControllerRuntime[Controller];
+
+    /* CAN_BTR is only writable in initialization mode: stopped, INAK reached, no recovery */
+    if ((TestMode > CAN_TEST_MODE_SILENT_LOOPBACK) ||
+        (Runtime->ControllerState != CAN_CS_STOPPED) ||
+        (Runtime->TransitionPending == TRUE) ||
+        (Can_BusOff[Controller].State != CAN_BUSOFF_STATE_IDLE))
+    {
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_CONTROLLER_TEST_MODE_SID, CAN_E_TRANSITION);
+#endif
+        return E_NOT_OK;
+    }
+
+    Can_ModeConfig(Controller, TestMode);
+
+    return E_OK;
+}
+#endif
+
+#if (CAN_GET_CURRENT_TIME_API == STD_ON)
+Std_ReturnType Can_GetCurrentTime (uint8 ControllerId, Can_TimeStampType* timeStampPtr)
+{
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CURRENT_TIME_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(ControllerId) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CURRENT_TIME_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if (timeStampPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_CURRENT_TIME_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    /* All controllers share the core clock time base */
+    (void)ControllerId;
+    Can_Time_ToTimeStamp(Can_Time_Now(), timeStampPtr);
+
+    return E_OK;
+}
+#endif
+
+#if (CAN_ENABLE_EGRESS_TIME_STAMP_API == STD_ON)
+void Can_EnableEgressTimeStamp (Can_HwHandleType Hth)
+{
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_ENABLE_EGRESS_TIMESTAMP_SID, CAN_E_UNINIT);
+        return;
+    }
+
+    if (Hth >= CAN_MAX_HTH_OBJECTS)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_ENABLE_EGRESS_TIMESTAMP_SID, CAN_E_PARAM_HANDLE);
+        return;
+    }
+#endif
+
+#if (CAN_GET_EGRESS_TIME_STAMP_API == STD_ON)
+    Can_EgressTimeStampEnabled[Hth] = TRUE;
+#endif
+}
+#endif
+
+#if (CAN_GET_EGRESS_TIME_STAMP_API == STD_ON)
+Std_ReturnType Can_GetEgressTimeStamp (PduIdType TxPduId, Can_HwHandleType Hth, Can_TimeStampType* timeStampPtr)
+{
+    Can_FrameTimeStampType TimeStamp;
+    uint32 PriMask;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_EGRESS_TIMESTAMP_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Hth >= CAN_MAX_HTH_OBJECTS)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_EGRESS_TIMESTAMP_SID, CAN_E_PARAM_HANDLE);
+        return E_NOT_OK;
+    }
+
+    if (timeStampPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_EGRESS_TIMESTAMP_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    /* The TX ISR may stamp the next frame of the HTH meanwhile */
+    PriMask = Can_EnterCritical();
+    TimeStamp = Can_EgressTimeStamp[Hth];
+    Can_ExitCritical(PriMask);
+
+    if ((TimeStamp.Valid == FALSE) || (TimeStamp.swPduHandle != TxPduId))
+    {
+        return E_NOT_OK;
+    }
+
+    Can_Time_ToTimeStamp(TimeStamp.Time, timeStampPtr);
+
+    return E_OK;
+}
+#endif
+
+#if (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON)
+Std_ReturnType Can_GetIngressTimeStamp (Can_HwHandleType Hrh, Can_TimeStampType* timeStampPtr)
+{
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_INGRESS_TIMESTAMP_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if ((Hrh != CAN_HRH_0) && (Hrh != CAN_HRH_1))
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_INGRESS_TIMESTAMP_SID, CAN_E_PARAM_HANDLE);
+        return E_NOT_OK;
+    }
+
+    if (timeStampPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_INGRESS_TIMESTAMP_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    /* Written by Can_MainFunction_Read right before the indication, same context */
+    if ((Can_IngressTimeStamp[Can_IngressFrame].Valid == FALSE) || (Can_IngressHrh[Can_IngressFrame] != Hrh))
+    {
+        return E_NOT_OK;
+    }
+
+    Can_Time_ToTimeStamp(Can_IngressTimeStamp[Can_IngressFrame].Time, timeStampPtr);
+
+    return E_OK;
+}
+
+void Can_SelectIngressFrame(uint8 Index)
+{
+    /* Called from within the indication, same context as Can_MainFunction_Read */
+    if (Index < CAN_RX_INDICATION_BATCH_SIZE)
+    {
+        Can_IngressFrame = Index;
+    }
+}
+#endif
+
+/*=========================== Services affecting a Hardware Handle ==============================*/
+
+Std_ReturnType Can_Write (Can_HwHandleType Hth, const Can_PduType* PduInfo)
+{
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_ValidateWrite(CAN_WRITE_SID, Hth, PduInfo) == FALSE)
+    {
+        return E_NOT_OK;
+    }
+#endif
+
+    return Can_WriteInline(Hth, PduInfo, PduInfo->length);
+}
+
+/* ================================== Vendor specific services ==================================*/
+
+#if (CAN_WRITE_DLC8_API == STD_ON)
+Std_ReturnType Can_WriteDlc8(Can_HwHandleType Hth, const Can_PduType* PduInfo)
+{
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_ValidateWrite(CAN_WRITE_DLC8_SID, Hth, PduInfo) == FALSE)
+    {
+        return E_NOT_OK;
+    }
+
+    if (PduInfo->length != CAN_MAX_DATA_LENGTH)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_WRITE_DLC8_SID, CAN_E_PARAM_DATA_LENGTH);
+        return E_NOT_OK;
+    }
+#endif
+
+    return Can_WriteInline(Hth, PduInfo, CAN_MAX_DATA_LENGTH);
+}
+#endif
+
+#if (CAN_CANCEL_TX_API == STD_ON)
+Std_ReturnType Can_CancelTx(Can_HwHandleType Hth, PduIdType PduId)
+{
+    Std_ReturnType ReturnValue = E_NOT_OK;
+    Can_TxBufferType* Buffer;
+    Can_TxMailboxType* Shadow;
+    uint32 PriMask;
+    uint8 Controller;
+    uint8 Mailbox;
+    uint8 Index;
+    uint8 Kept = 0U;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_CANCEL_TX_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Hth >= CAN_MAX_HTH_OBJECTS)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_CANCEL_TX_SID, CAN_E_PARAM_HANDLE);
+        return E_NOT_OK;
+    }
+#endif
+
+    Controller = Can_HthConfig[Hth].ControllerId;
+    Buffer = &Can_TxBuffer[Hth];
+
+    PriMask = Can_EnterCritical();
+
+    /* Waiting frames of the PDU are dropped; the others keep their order */
+    for (Index = 0U; Index < Buffer->Count; Index++)
+    {
+        if (Buffer->Frame[Index].swPduHandle != PduId)
+        {
+            Buffer->Frame[Kept] = Buffer->Frame[Index];
+            Kept++;
+        }
+    }
+    if (Kept != Buffer->Count)
+    {
+        Buffer->Count = Kept;
+        ReturnValue = E_OK;
+    }
+
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+    if ((Can_TtFrame[Hth].Valid == TRUE) && (Can_TtFrame[Hth].Frame.swPduHandle == PduId))
+    {
+        Can_TtFrame[Hth].Valid = FALSE;
+        ReturnValue = E_OK;
+    }
+#endif
+
+    /* A frame in a mailbox is aborted; Can_TxCollect reports whether the abort or the bus won */
+    for (Mailbox = 0U; Mailbox < CAN_TX_MAILBOX_COUNT; Mailbox++)
+    {
+        Shadow = &Can_TxMailbox[Controller][Mailbox];
+        if ((Shadow->Pending == TRUE) && (Shadow->Hth == Hth) && (Shadow->swPduHandle == PduId))
+        {
+            if (Shadow->CancelRequested == FALSE)
+            {
+                Shadow->CancelRequested = TRUE;
+                /* ABRQ is set-only and RQCP is write-1-to-clear: write the single bit */
+                CAN_GET_HW_CONTROLLER(Controller)->TSR = CAN_TSR_ABRQ(Mailbox);
+            }
+            ReturnValue = E_OK;
+        }
+    }
+
+    Can_ExitCritical(PriMask);
+
+    return ReturnValue;
+}
+
+uint8 Can_GetTxMailboxCount(Can_HwHandleType Hth, PduIdType PduId)
+{
+    const Can_TxMailboxType* Shadow;
+    uint8 Controller;
+    uint8 Mailbox;
+    uint8 Count = 0U;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_TX_MAILBOX_COUNT_SID, CAN_E_UNINIT);
+        return 0U;
+    }
+
+    if (Hth >= CAN_MAX_HTH_OBJECTS)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_TX_MAILBOX_COUNT_SID, CAN_E_PARAM_HANDLE);
+        return 0U;
+    }
+#endif
+
+    Controller = Can_HthConfig[Hth].ControllerId;
+
+    for (Mailbox = 0U; Mailbox < CAN_TX_MAILBOX_COUNT; Mailbox++)
+    {
+        Shadow = &Can_TxMailbox[Controller][Mailbox];
+        if ((Shadow->Pending == TRUE) && (Shadow->Hth == Hth) && (Shadow->swPduHandle == PduId))
+        {
+            Count++;
+        }
+    }
+
+    return Count;
+}
+#endif
+
+#if (CAN_RX_FILTER_API == STD_ON)
+Std_ReturnType Can_SetRxFilter(uint8 Controller, const Can_FilterIdType* IdList, uint16 IdCount)
+{
+    Can_FilterReportType Report;
+    const Can_FilterIdType* ExtraList = NULL_PTR;
+    uint16 ExtraCount = 0U;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_RX_FILTER_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(Controller) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_RX_FILTER_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if ((IdList == NULL_PTR) && (IdCount > 0U))
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_SET_RX_FILTER_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+#if (CAN_GATEWAY_SUPPORT == STD_ON)
+    /* The source frames of the gateway routes are accepted as well */
+    ExtraList = Can_Gw_GetFilterIds(Controller, &ExtraCount);
+#endif
+
+    /* The previous banks stay programmed if the list cannot be compiled */
+    if (Can_Filter_Compile(IdList, IdCount, ExtraList, ExtraCount, Can_ControllerHwConfig[Controller].FilterBankCount,
+                           Can_FilterBank[Controller], &Report) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    Can_FilterReport[Controller] = Report;
+    Can_FilterApply(Controller);
+
+    return E_OK;
+}
+
+Std_ReturnType Can_GetRxFilterReport(uint8 Controller, Can_FilterReportType* ReportPtr)
+{
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_FILTER_REPORT_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(Controller) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_FILTER_REPORT_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if (ReportPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_FILTER_REPORT_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    *ReportPtr = Can_FilterReport[Controller];
+
+    return E_OK;
+}
+
+Std_ReturnType Can_GetRxFilterElement(uint8 Controller, Can_HwHandleType Hrh, uint8 FilterMatchIndex,
+                                      Can_FilterIdType* ElementPtr)
+{
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_FILTER_ELEMENT_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(Controller) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_FILTER_ELEMENT_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if ((Hrh != CAN_HRH_0) && (Hrh != CAN_HRH_1))
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_FILTER_ELEMENT_SID, CAN_E_PARAM_HANDLE);
+        return E_NOT_OK;
+    }
+
+    if (ElementPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_FILTER_ELEMENT_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    /* BanksUsed is 0 while the accept-all default filter is programmed */
+    if (Can_Filter_GetElement(Can_FilterBank[Controller], Can_FilterReport[Controller].BanksUsed,
+                              (uint8)(Hrh - CAN_HRH_0), FilterMatchIndex, ElementPtr) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    ElementPtr->Hrh = Hrh;
+
+    return E_OK;
+}
+#endif
+
+#if (CAN_RX_PROCESSING == ADAPTIVE)
+Std_ReturnType Can_GetRxModeStatistics(uint8 Controller, Can_RxModeStatisticsType* StatisticsPtr)
+{
+    uint32 PriMask;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_MODE_STATISTICS_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(Controller) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_MODE_STATISTICS_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if (StatisticsPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_MODE_STATISTICS_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    /* Consistent copy against a concurrent Can_MainFunction_Read */
+    PriMask = Can_EnterCritical();
+    *StatisticsPtr = Can_RxAdaptive[Controller].Statistics;
+    Can_ExitCritical(PriMask);
+
+    return E_OK;
+}
+#endif
+
+Std_ReturnType Can_GetRxLaneStatistics(uint8 Controller, Can_HwHandleType Hrh,
+                                       Can_RxLaneStatisticsType* StatisticsPtr)
+{
+    const Can_RxQueueType* Queue;
+    uint32 PriMask;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_LANE_STATISTICS_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(Controller) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_LANE_STATISTICS_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if ((Hrh != CAN_HRH_0) && (Hrh != CAN_HRH_1))
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_LANE_STATISTICS_SID, CAN_E_PARAM_HANDLE);
+        return E_NOT_OK;
+    }
+
+    if (StatisticsPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_RX_LANE_STATISTICS_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    Queue = &Can_RxQueue[Controller][Hrh - CAN_HRH_0];
+
+    /* Consistent copy against the RX ISRs */
+    PriMask = Can_EnterCritical();
+    StatisticsPtr->ReceivedCount = Queue->Head;
+    StatisticsPtr->QueueOverrunCount = Queue->QueueOverrunCount;
+    StatisticsPtr->FifoOverrunCount = Queue->FifoOverrunCount;
+    StatisticsPtr->MaxFill = Queue->MaxFill;
+    Can_ExitCritical(PriMask);
+
+    return E_OK;
+}
+
+#if (CAN_GATEWAY_SUPPORT == STD_ON)
+Std_ReturnType Can_GetGatewayStatistics(uint8 Route, Can_GwStatisticsType* StatisticsPtr)
+{
+    uint32 PriMask;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_GATEWAY_STATISTICS_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Route >= CAN_GW_ROUTE_COUNT)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_GATEWAY_STATISTICS_SID, CAN_E_PARAM_HANDLE);
+        return E_NOT_OK;
+    }
+
+    if (StatisticsPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_GATEWAY_STATISTICS_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    /* Consistent copy against the RX ISRs */
+    PriMask = Can_EnterCritical();
+    Can_Gw_GetStatistics(Route, StatisticsPtr);
+    Can_ExitCritical(PriMask);
+
+    return E_OK;
+}
+#endif
+
+Std_ReturnType Can_GetBusOffStatistics(uint8 Controller, Can_BusOffStatisticsType* StatisticsPtr)
+{
+    uint32 PriMask;
+
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+    if (Can_DriverInitialized == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_BUS_OFF_STATISTICS_SID, CAN_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    if (Can_ValidateController(Controller) == FALSE)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_BUS_OFF_STATISTICS_SID, CAN_E_PARAM_CONTROLLER);
+        return E_NOT_OK;
+    }
+
+    if (StatisticsPtr == NULL_PTR)
+    {
+        (void)Det_ReportError(CAN_MODULE_ID, CAN_INSTANCE_ID, CAN_GET_BUS_OFF_STATISTICS_SID, CAN_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    /* Consistent copy against the SCE ISR and Can_MainFunction_BusOff */
+    PriMask = Can_EnterCritical();
+    *StatisticsPtr = Can_BusOff[Controller].Statistics;
+    Can_ExitCritical(PriMask);
+
+    return E_OK;
+}
+
+/* ===================================== Scheduled functions ====================================*/
+
+#if (CAN_TX_PROCESSING == POLLING)
+/** This function performs the polling of TX confirmation when CAN_TX_PROCESSING is set to
+ POLLING. */
+void Can_MainFunction_Write (void)
+{
+    uint8 Controller;
+
+    if (Can_DriverInitialized == FALSE)
+    {
+        return;
+    }
+
+    for (Controller = 0U; Controller < CAN_MAX_CONTROLLERS; Controller++)
+    {
+        if (Can_ControllerRuntime[Controller].ControllerState == CAN_CS_STARTED)
+        {
+            Can_TxProcess(Controller);
+        }
+    }
+}
+#endif
+
+void Can_MainFunction_Read (void)
+{
+    uint8 Controller;
+#if (CAN_STATISTICS_API == STD_ON)
+    uint64 Now;
+#endif
+
+    if (Can_DriverInitialized == FALSE)
+    {
+        return;
+    }
+
+#if (CAN_STATISTICS_API == STD_ON)
+    /* Also keeps the software extension of the cycle counter across its wrap */
+    Now = Can_Time_Now();
+#elif (CAN_TIME_BASE == STD_ON)
+    /* Keeps the software extension of the cycle counter across its wrap */
+    (void)Can_Time_Now();
+#endif
+
+    for (Controller = 0U; Controller < CAN_MAX_CONTROLLERS; Controller++)
+    {
+        if (Can_ControllerRuntime[Controller].ControllerState == CAN_CS_UNINIT)
+        {
+            continue;
+        }
+
+#if (CAN_RX_PROCESSING == POLLING)
+        Can_RxDrainFifo(Controller, CAN_FIFO0);
+        Can_RxDrainFifo(Controller, CAN_FIFO1);
+#elif (CAN_RX_PROCESSING == ADAPTIVE)
+        Can_RxAdaptiveUpdate(Controller);
+#endif
+        /* The high priority lane first */
+        Can_RxQueueProcess(Controller, CAN_FIFO1);
+        Can_RxQueueProcess(Controller, CAN_FIFO0);
+#if (CAN_STATISTICS_API == STD_ON)
+        Can_StatsSample(Controller, Now);
+#endif
+    }
+}
+
+void Can_MainFunction_BusOff (void)
+{
+    uint8 Controller;
+
+    if (Can_DriverInitialized == FALSE)
+    {
+        return;
+    }
+
+    for (Controller = 0U; Controller < CAN_MAX_CONTROLLERS; Controller++)
+    {
+        if (Can_ControllerRuntime[Controller].ControllerState != CAN_CS_UNINIT)
+        {
+            Can_BusOffProcess(Controller);
+        }
+    }
+}
+
+void Can_MainFunction_Wakeup (void);
+
+void Can_MainFunction_Mode (void)
+{
+    Can_ControllerRuntimeType* Runtime;
+    CAN_TypeDef* CanPtr;
+    uint32 Msr;
+    boolean Acknowledged;
+    uint8 Controller;
+
+    if (Can_DriverInitialized == FALSE)
+    {
+        return;
+    }
+
+    for (Controller = 0U; Controller < CAN_MAX_CONTROLLERS; Controller++)
+    {
+        Runtime = &Can_ControllerRuntime[Controller];
+        if (Runtime->TransitionPending == FALSE)
+        {
+            continue;
+        }
+
+        CanPtr = CAN_GET_HW_CONTROLLER(Controller);
+        Msr = CanPtr->MSR & (CAN_MSR_INAK | CAN_MSR_SLAK);
+
+        switch (Runtime->RequestedState)
+        {
+            case CAN_CS_STARTED:
+                Acknowledged = (boolean)(Msr == 0U);
+                break;
+            case CAN_CS_STOPPED:
+                Acknowledged = (boolean)(Msr == CAN_MSR_INAK);
+                break;
+            case CAN_CS_SLEEP:
+                Acknowledged = (boolean)(Msr == CAN_MSR_SLAK);
+                break;
+            default:
+                Acknowledged = FALSE;
+                break;
+        }
+
+        if (Acknowledged == TRUE)
+        {
+            Runtime->ControllerState = Runtime->RequestedState;
+            Runtime->TransitionPending = FALSE;
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+            if ((Controller == CAN_TT_CONTROLLER) && (Runtime->ControllerState == CAN_CS_STARTED))
+            {
+                Can_TtStart();
+            }
+#endif
+            CanIf_ControllerModeIndication(Controller, Can_ToCanIfMode(Runtime->ControllerState));
+        }
+        else
+        {
+            Runtime->TimeoutCounter++;
+            if (Runtime->TimeoutCounter >= CAN_MODE_TRANSITION_TIMEOUT)
+            {
+                /* Give up; the upper layer may request the transition again. Every transition
+                   starts from or ends in CAN_CS_STOPPED, which ControllerState still reports, so
+                   MCR goes back to initialization mode: the hardware must not complete the
+                   abandoned request later on its own, e.g. join the bus after a failed start. */
+                CanPtr->MCR = (CanPtr->MCR & ~(uint32)CAN_MCR_SLEEP) | CAN_MCR_INRQ;
+                Runtime->TransitionPending = FALSE;
+#if (CAN_DEV_ERROR_DETECT == STD_ON)
+                (void)Det_ReportRuntimeError(CAN_MODULE_ID, CAN_INSTANCE_ID,
+                                             CAN_MAIN_FUNCTION_MODE_SID, CAN_E_MODE_TIMEOUT);
+#endif
+            }
+        }
+    }
+}
+
+/*==================================================================================================
+*                                       INTERRUPT FUNCTIONS
+==================================================================================================*/
+#if (CAN_RX_PROCESSING != POLLING)
+/**
+ * @brief   CAN1 RX FIFO 0 interrupt handler (FMP0 / FF0 / FOV0)
+ */
+void CAN1_RX0_IRQ_HANDLER(void)
+{
+    Can_RxDrainFifo(CAN_CONTROLLER_0_ID, CAN_FIFO0);
+}
+
+/**
+ * @brief   CAN1 RX FIFO 1 interrupt handler (FMP1 / FF1 / FOV1)
+ */
+void CAN1_RX1_IRQHandler(void)
+{
+    Can_RxDrainFifo(CAN_CONTROLLER_0_ID, CAN_FIFO1);
+}
+
+#if (CAN_CONTROLLER_1_ENABLED == STD_ON)
+/**
+ * @brief   CAN2 RX FIFO 0 interrupt handler (FMP0 / FF0 / FOV0)
+ */
+void CAN2_RX0_IRQHandler(void)
+{
+    Can_RxDrainFifo(CAN_CONTROLLER_1_ID, CAN_FIFO0);
+}
+
+/**
+ * @brief   CAN2 RX FIFO 1 interrupt handler (FMP1 / FF1 / FOV1)
+ */
+void CAN2_RX1_IRQHandler(void)
+{
+    Can_RxDrainFifo(CAN_CONTROLLER_1_ID, CAN_FIFO1);
+}
+#endif
+#endif
+
+#if (CAN_TX_PROCESSING == INTERRUPT)
+/**
+ * @brief   CAN1 TX interrupt handler (RQCP0..2)
+ */
+void CAN1_TX_IRQ_HANDLER(void)
+{
+    Can_TxProcess(CAN_CONTROLLER_0_ID);
+}
+
+#if (CAN_CONTROLLER_1_ENABLED == STD_ON)
+/**
+ * @brief   CAN2 TX interrupt handler (RQCP0..2)
+ */
+void CAN2_TX_IRQHandler(void)
+{
+    Can_TxProcess(CAN_CONTROLLER_1_ID);
+}
+#endif
+#endif
+
+#if (CAN_BUSOFF_PROCESSING == INTERRUPT)
+/**
+ * @brief   CAN1 status change error interrupt handler (BOF)
+ */
+void CAN1_SCE_IRQHandler(void)
+{
+    Can_BusOffIsr(CAN_CONTROLLER_0_ID);
+}
+
+#if (CAN_CONTROLLER_1_ENABLED == STD_ON)
+/**
+ * @brief   CAN2 status change error interrupt handler (BOF)
+ */
+void CAN2_SCE_IRQHandler(void)
+{
+    Can_BusOffIsr(CAN_CONTROLLER_1_ID);
+}
+#endif
+#endif
+
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+/**
+ * @brief   Schedule timer interrupt handler (CC1): release the due slots
+ */
+void CAN_TT_TIMER_IRQ_HANDLER(void)
+{
+    uint32 PriMask = Can_EnterCritical();
+
+    CAN_TT_TIMER->SR = (uint16)~TIM_SR_CC1IF;
+    Can_TtDispatch();
+
+    Can_ExitCritical(PriMask);
+}
+#endif
@@ -86,6 +86,21 @@
 #define CAN_MAIN_FUNCTION_WAKEUP_SID            (0x0AU)
 #define CAN_MAIN_FUNCTION_MODE_SID              (0x0CU)
 
+/* Vendor specific services */
+#define CAN_SET_RX_FILTER_SID                   (0x40U)
+#define CAN_GET_RX_FILTER_REPORT_SID            (0x41U)
+#define CAN_GET_RX_FILTER_ELEMENT_SID           (0x42U)
+#define CAN_WRITE_DLC8_SID                      (0x43U)
+#define CAN_GET_RX_MODE_STATISTICS_SID          (0x44U)
+#define CAN_GET_BUS_OFF_STATISTICS_SID          (0x45U)
+#define CAN_GET_STATISTICS_SID                  (0x46U)
+#define CAN_GET_SCHEDULE_STATUS_SID             (0x47U)
+#define CAN_SET_CONTROLLER_TEST_MODE_SID        (0x48U)
+#define CAN_GET_RX_LANE_STATISTICS_SID          (0x49U)
+#define CAN_GET_GATEWAY_STATISTICS_SID          (0x4AU)
+#define CAN_CANCEL_TX_SID                       (0x4BU)
+#define CAN_GET_TX_MAILBOX_COUNT_SID            (0x4CU)
+
 /**
  * @brief   Development Error Codes
  * @details Error codes for CAN driver development error detection
@@ -107,6 +122,7 @@
  * [SWS_Can_91020] 
  */
 #define CAN_E_DATALOST                         (0x01U)     /**< Received CAN message is lost */
+#define CAN_E_MODE_TIMEOUT                     (0x02U)     /**< Mode transition not acknowledged in time (vendor specific) */
 
 
 
@@ -271,6 +287,51 @@ Std_ReturnType Can_GetControllerRxErrorCounter(uint8 ControllerId, uint8* RxErro
 Std_ReturnType Can_GetControllerTxErrorCounter(uint8 ControllerId, uint8* TxErrorCounterPtr);
 #endif
 
+/**
+ * @brief   Frame, bus-load and bus error statistics of a controller
+ * @details Returns the frames and on-wire bits sent and received, the bus load of the last
+ *          Can_MainFunction_Read period and of the sliding window, the error counters sampled
+ *          each period and the bus errors per last error code.
+ * @param[in] ControllerId - CAN controller
+ * @param[out] StatisticsPtr - Statistics
+ * @return  Std_ReturnType
+ *          E_OK: Statistics available
+ *          E_NOT_OK: Wrong ControllerId or NULL pointer
+ * @note    Synchronous, Reentrant, vendor specific
+ */
+#if (CAN_STATISTICS_API == STD_ON)
+Std_ReturnType Can_GetStatistics(uint8 ControllerId, Can_StatisticsType* StatisticsPtr);
+#endif
+
+/**
+ * @brief   Status of the time-triggered transmit schedule
+ * @details Returns the cycle and slot counters and the longest delay between a slot instant and
+ *          the transmit request of its frame.
+ * @param[out] StatusPtr - Schedule status
+ * @return  Std_ReturnType
+ *          E_OK: Status available
+ *          E_NOT_OK: NULL pointer
+ * @note    Synchronous, Reentrant, vendor specific
+ */
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+Std_ReturnType Can_GetScheduleStatus(Can_ScheduleStatusType* StatusPtr);
+#endif
+
+/**
+ * @brief   Select the test mode of a stopped controller
+ * @details Programs the LBKM and SILM bits of CAN_BTR, the mode takes effect with the next
+ *          Can_SetControllerMode(CAN_CS_STARTED) and is kept until changed again or Can_Init.
+ * @param[in] Controller - CAN controller
+ * @param[in] TestMode - CAN_TEST_MODE_NORMAL, _LOOPBACK, _SILENT or _SILENT_LOOPBACK
+ * @return  Std_ReturnType
+ *          E_OK: Test mode set
+ *          E_NOT_OK: Wrong Controller or TestMode, or the controller is not stopped
+ * @note    Synchronous, Non Reentrant, vendor specific
+ */
+#if (CAN_SET_CONTROLLER_TEST_MODE_API == STD_ON)
+Std_ReturnType Can_SetControllerTestMode(uint8 Controller, uint8 TestMode);
+#endif
+
 /**
  * @brief   Returns the current time for a CAN controller
  * @details This service obtains the current time for a CAN controller.
@@ -328,16 +389,32 @@ Std_ReturnType Can_GetEgressTimeStamp(PduIdType TxPduId, Can_HwHandleType Hth, C
 Std_ReturnType Can_GetIngressTimeStamp(Can_HwHandleType Hrh, Can_TimeStampType* timeStampPtr);
 #endif
 
+/**
+ * @brief   Selects the frame of the Rx indication batch being indicated
+ * @details CanIf_RxIndicationBatch calls it before it indicates the frame at position Index, so
+ *          that Can_GetIngressTimeStamp returns the stamp of that frame. Every batch starts at
+ *          position 0.
+ * @param[in] Index - Position of the frame in the batch
+ * @note    Synchronous, Non-reentrant, vendor specific
+ */
+#if (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON)
+void Can_SelectIngressFrame(uint8 Index);
+#endif
+
 /*=========================== Services affecting a Hardware Handle ==============================*/
 
 /**
  * @brief   This function is called by CanIf to pass a CAN message to CanDrv for transmission
  * @details This function is called by CanIf to pass a CAN message to CanDrv for transmission.
+ *          With sdu = NULL_PTR on an HTH configured with TriggerTransmit only the mailbox is
+ *          requested: the payload, at most length bytes, is fetched with CanIf_TriggerTransmit
+ *          when the frame is loaded into the mailbox.
  * @param[in] Hth - Information which HW-transmit handle shall be used for transmit
  * @param[in] PduInfo - Pointer to SDU user memory, DLC and Identifier
  * @return  Std_ReturnType
  *          E_OK: Write command has been accepted
- *          E_NOT_OK: Development error occurred
+ *          E_NOT_OK: Development error occurred, or a free mailbox was found but the upper layer
+ *          had no data for a trigger transmit request
  *          CAN_BUSY: No TX hardware buffer available or pre-emptive call of Can_Write that can't be implemented re-entrant
  * @note    Synchronous, Reentrant (for different HTHs)
  * SWS_Can_00233
@@ -348,12 +425,15 @@ Std_ReturnType Can_Write(Can_HwHandleType Hth, const Can_PduType* PduInfo);
 
 /**
  * @brief   CAN L-PDU callout
- * @details This callout is called by the CAN driver when a CAN L-PDU has been received.
- *          This callout is configurable (ON/OFF) for each HOH.
- * @param[in] Hrh - Hardware Receive Handle
- * @param[in] CanId - Standard/Extended CAN ID of CAN L-PDU
- * @param[in] CanDataLength - Data Length of the received CAN L-PDU
- * @param[in] CanSduPtr - Pointer to L-SDU buffer of the CAN L-PDU
+ * @details Called by the CAN driver for every received CAN L-PDU, before it is queued for CanIf.
+ *          Runs in the RX ISR of the FIFO the frame was received in, or in Can_MainFunction_Read
+ *          with polled reception. The function is named by CAN_LPDU_CALLOUT_NAME.
+ *
+ *          Deviation: the HRHs of this driver are shared by the controllers, so the frame is
+ *          described by Can_HwType (identifier, HRH and controller) and PduInfoType, as in
+ *          CanIf_RxIndication, instead of Hrh, CanId, CanDataLength and CanSduPtr.
+ * @param[in] Mailbox - Identifier, HRH and controller of the received L-PDU
+ * @param[in] PduInfoPtr - Received L-SDU and its length
  * @return  boolean
  *          TRUE: L-PDU is accepted by the upper layer
  *          FALSE: L-PDU is not accepted by the upper layer
@@ -361,7 +441,148 @@ Std_ReturnType Can_Write(Can_HwHandleType Hth, const Can_PduType* PduInfo);
  * SWS_Can_00495
  */
 #if (CAN_LPDU_CALLOUT_SUPPORT == STD_ON)
-boolean Can_LPdu_Callout(uint8 Hrh, Can_IdType CanId, uint8 CanDataLength, const uint8* CanSduPtr);
+boolean CAN_LPDU_CALLOUT_NAME(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr);
+#endif
+
+/*================================== Vendor specific services ===================================*/
+
+/**
+ * @brief   Can_Write for 8-byte L-PDUs
+ * @details Same behaviour as Can_Write, compiled for a constant payload length of 8 bytes so that
+ *          the payload is moved with two word loads and no length dependent code.
+ * @param[in] Hth - Information which HW-transmit handle shall be used for transmit
+ * @param[in] PduInfo - Pointer to SDU user memory, DLC (must be 8) and Identifier
+ * @return  Std_ReturnType
+ *          E_OK: Write command has been accepted
+ *          E_NOT_OK: Development error occurred
+ *          CAN_BUSY: No TX hardware buffer available
+ * @note    Synchronous, Reentrant
+ */
+#if (CAN_WRITE_DLC8_API == STD_ON)
+Std_ReturnType Can_WriteDlc8(Can_HwHandleType Hth, const Can_PduType* PduInfo);
+#endif
+
+/**
+ * @brief   Cancel the pending transmissions of a PDU
+ * @details Frames of the PDU waiting in the TX buffer of the HTH are removed at once. A frame
+ *          already in a mailbox is aborted with ABRQ: if the abort wins, the frame is reported with
+ *          CanIf_CancelTxConfirmation and the mailbox takes the next buffered frame; if the frame
+ *          was already on the bus it is confirmed with CanIf_TxConfirmation as usual.
+ * @param[in] Hth - HTH the PDU was written on
+ * @param[in] PduId - swPduHandle given to Can_Write
+ * @return  Std_ReturnType
+ *          E_OK: A pending request of the PDU was found
+ *          E_NOT_OK: Development error occurred, or nothing of the PDU is pending
+ * @note    Synchronous, Reentrant
+ */
+#if (CAN_CANCEL_TX_API == STD_ON)
+Std_ReturnType Can_CancelTx(Can_HwHandleType Hth, PduIdType PduId);
+
+/**
+ * @brief   Number of frames of a PDU in the TX mailboxes
+ * @details Right after Can_CancelTx these are the only frames left of the PDU, and each still
+ *          ends with CanIf_TxConfirmation or CanIf_CancelTxConfirmation.
+ * @param[in] Hth - HTH the PDU was written on
+ * @param[in] PduId - swPduHandle given to Can_Write
+ * @return  uint8 - Frames of the PDU in the mailboxes; 0 on a development error
+ * @note    Synchronous, Reentrant. Call with interrupts locked for a stable result.
+ */
+uint8 Can_GetTxMailboxCount(Can_HwHandleType Hth, PduIdType PduId);
+#endif
+
+/**
+ * @brief   Program the hardware acceptance filters of a controller
+ * @details Compiles the identifier list into the filter banks owned by the controller (see
+ *          Can_Filter_Compile) and programs them. Until the first call the controller accepts
+ *          every frame into FIFO 0. An empty list closes the hardware filter completely.
+ * @param[in] Controller - CAN controller whose filters shall be programmed
+ * @param[in] IdList - Identifiers and identifier ranges to accept
+ * @param[in] IdCount - Number of entries in IdList (<= CAN_FILTER_MAX_IDS)
+ * @return  Std_ReturnType
+ *          E_OK: Filters programmed
+ *          E_NOT_OK: Invalid list or list does not fit, previous filters unchanged
+ * @note    Synchronous, Non-reentrant
+ */
+#if (CAN_RX_FILTER_API == STD_ON)
+Std_ReturnType Can_SetRxFilter(uint8 Controller, const Can_FilterIdType* IdList, uint16 IdCount);
+
+/**
+ * @brief   Report of the last Can_SetRxFilter call
+ * @details Returns the banks used and the number of identifiers that pass the hardware filter
+ *          without being requested (to be discarded by software filtering).
+ * @param[in] Controller - CAN controller
+ * @param[out] ReportPtr - Report of the filter compilation
+ * @return  Std_ReturnType
+ * @note    Synchronous, Reentrant
+ */
+Std_ReturnType Can_GetRxFilterReport(uint8 Controller, Can_FilterReportType* ReportPtr);
+
+/**
+ * @brief   Filter element behind a filter match index
+ * @details Returns the identifier and mask of the filter element that is reported as
+ *          Can_HwType.FilterMatchIndex for frames received on Hrh. Lets the upper layer map
+ *          match indices to PDUs once instead of searching the CAN ID for every frame.
+ * @param[in] Controller - CAN controller
+ * @param[in] Hrh - CAN_HRH_0 (FIFO 0) or CAN_HRH_1 (FIFO 1)
+ * @param[in] FilterMatchIndex - Filter match index
+ * @param[out] ElementPtr - Identifier and mask of the element
+ * @return  Std_ReturnType
+ *          E_OK: Element returned
+ *          E_NOT_OK: No compiled filter behind the index (e.g. accept-all default filter)
+ * @note    Synchronous, Reentrant
+ */
+Std_ReturnType Can_GetRxFilterElement(uint8 Controller, Can_HwHandleType Hrh, uint8 FilterMatchIndex,
+                                      Can_FilterIdType* ElementPtr);
+#endif
+
+/**
+ * @brief   Adaptive reception statistics of a controller
+ * @details Returns the current reception mode, the number of switches between interrupt and
+ *          polling reception and the observed load in frames per Can_MainFunction_Read period.
+ * @param[in] Controller - CAN controller
+ * @param[out] StatisticsPtr - Reception mode statistics
+ * @return  Std_ReturnType
+ * @note    Synchronous, Reentrant
+ */
+#if (CAN_RX_PROCESSING == ADAPTIVE)
+Std_ReturnType Can_GetRxModeStatistics(uint8 Controller, Can_RxModeStatisticsType* StatisticsPtr);
+#endif
+
+/**
+ * @brief   Bus-off statistics of a controller
+ * @details Returns the bus-off and recovery counters and the recovery durations in
+ *          Can_MainFunction_BusOff periods.
+ * @param[in] Controller - CAN controller
+ * @param[out] StatisticsPtr - Bus-off statistics
+ * @return  Std_ReturnType
+ * @note    Synchronous, Reentrant
+ */
+Std_ReturnType Can_GetBusOffStatistics(uint8 Controller, Can_BusOffStatisticsType* StatisticsPtr);
+
+/**
+ * @brief   Reception statistics of one RX lane
+ * @details Returns the frames received through the FIFO behind Hrh, the frames lost on its RX
+ *          queue and in hardware, and the highest queue fill level. FIFO 1 is the high priority
+ *          lane, its counters show whether control traffic survived a flood on FIFO 0.
+ * @param[in] Controller - CAN controller
+ * @param[in] Hrh - CAN_HRH_0 (FIFO 0) or CAN_HRH_1 (FIFO 1)
+ * @param[out] StatisticsPtr - Lane statistics
+ * @return  Std_ReturnType
+ * @note    Synchronous, Reentrant
+ */
+Std_ReturnType Can_GetRxLaneStatistics(uint8 Controller, Can_HwHandleType Hrh,
+                                       Can_RxLaneStatisticsType* StatisticsPtr);
+
+/**
+ * @brief   Counters of one gateway route
+ * @details Returns the frames the route forwarded and the frames the destination HTH refused.
+ * @param[in] Route - Index into Can_GwRouteConfig
+ * @param[out] StatisticsPtr - Route statistics
+ * @return  Std_ReturnType
+ * @note    Synchronous, Reentrant
+ */
+#if (CAN_GATEWAY_SUPPORT == STD_ON)
+Std_ReturnType Can_GetGatewayStatistics(uint8 Route, Can_GwStatisticsType* StatisticsPtr);
 #endif
 /* ===================================== Scheduled functions ====================================*/
 
@@ -379,23 +600,29 @@ void Can_MainFunction_Write(void);
 
 /**
  * @brief   This function performs the polling of RX indications
- * @details This function performs the polling of RX indications when CAN_RX_PROCESSING is set to POLLING.
+ * @details When CAN_RX_PROCESSING is set to POLLING the hardware FIFOs are drained first. With
+ *          ADAPTIVE they are drained while the controller is in polling mode, and the load of
+ *          the period decides whether to switch between interrupt and polling reception.
+ *          In both modes the frames queued in the per-controller RX ring (filled by the RX
+ *          ISRs in INTERRUPT mode) are then forwarded to CanIf_RxIndicationBatch, up to
+ *          CAN_RX_INDICATION_BATCH_SIZE frames per call, so the upper layers always run in task
+ *          context.
  * @note    Synchronous, Non-reentrant
  * SWS_Can_00226
  */
-#if (CAN_RX_PROCESSING == POLLING)
 void Can_MainFunction_Read(void);
-#endif
 
 /**
  * @brief   This function performs the polling of bus-off events
  * @details This function performs the polling of bus-off events that are configured statically as 'to be polled'.
+ *          It also runs the bus-off recovery of every controller (ABOM is off), so it has to be
+ *          called periodically with CAN_BUSOFF_PROCESSING INTERRUPT as well. Once a controller is
+ *          back on the bus it is STARTED again, CanIf_ControllerModeIndication is called and the
+ *          frames kept in the TX mailboxes and buffers are sent.
  * @note    Synchronous, Non-reentrant
  * SWS_Can_00227
  */
-#if (CAN_BUSOFF_PROCESSING == POLLING)
 void Can_MainFunction_BusOff(void);
-#endif
 
 /**
  * @brief   This function performs the polling of wake-up events
@@ -410,6 +637,11 @@ void Can_MainFunction_Wakeup(void);
 /**
  * @brief   This function performs the polling of CAN controller mode transitions
  * @details This function performs the polling of CAN controller mode transitions that are configured statically as 'to be polled'.
+ *          Can_SetControllerMode only requests a transition; once the hardware acknowledges it
+ *          (INAK/SLAK) this function updates the controller state and calls
+ *          CanIf_ControllerModeIndication. A transition that is not acknowledged within
+ *          CAN_MODE_TRANSITION_TIMEOUT calls is dropped and reported as CAN_E_MODE_TIMEOUT; the
+ *          controller is put back into initialization mode to match CAN_CS_STOPPED.
  * @note    Synchronous, Non-reentrant
  * SWS_Can_00373
  */
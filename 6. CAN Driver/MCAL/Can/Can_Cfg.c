@@ -16,6 +16,8 @@
 #include "Can_Cfg.h"
 #include "Can_Types.h"
 #include "Can.h"
+#include "stm32f10x_gpio.h"
+#include "stm32f10x_rcc.h"
 
 /*==================================================================================================
 *                              SOURCE FILE VERSION INFORMATION
@@ -241,7 +243,7 @@ static const Can_HwObjectConfigType Can_HwObjectConfigs[] =
         .CanIdValue = 0x000U,                    /* Don't care for TX */
         .CanIdMask = 0x000U,                     /* Don't care for TX */
         .CanIdExtended = FALSE,                  /* Standard ID by default */
-        .CanObjectType = 0U,                     /* BASIC CAN object */
+        .CanObjectType = CAN_HANDLE_TYPE_FULL,   /* FULL CAN object */
         .MaxDataLength = 8U                      /* Maximum 8 bytes */
     },
     /* Receive Hardware Objects (HRH) */
@@ -317,6 +319,26 @@ static const Can_ControllerConfigType Can_Controller0_Config =
     .BusoffRecovery = TRUE                       /* Enable automatic busoff recovery */
 };
 
+#if (CAN_CONTROLLER_1_ENABLED == STD_ON)
+/**
+ * @brief   CAN Controller 1 Configuration
+ * @details Complete configuration for CAN Controller 1 (CAN2), same baudrate table as CAN1
+ */
+static const Can_ControllerConfigType Can_Controller1_Config =
+{
+    .ControllerId = CAN_CONTROLLER_1_ID,
+    .ControllerActivation = CAN_CONTROLLER_1_ENABLED,
+    .ControllerBaseAddress = CAN_CONTROLLER_1_BASE_ADDRESS,
+    .ControllerIrqNumber = CAN_CONTROLLER_1_IRQ_NUMBER,
+    .ControllerIrqPriority = CAN_CONTROLLER_1_IRQ_PRIORITY,
+    .DefaultBaudrateId = CAN_DEFAULT_BAUDRATE_ID,
+    .BaudrateConfigs = Can_Controller0_BaudrateConfigs,
+    .BaudrateConfigsCount = (sizeof(Can_Controller0_BaudrateConfigs) / sizeof(Can_BaudrateConfigType)),
+    .WakeupSupport = (CAN_WAKEUP_SUPPORT == STD_ON) ? TRUE : FALSE,
+    .BusoffRecovery = TRUE                       /* Enable automatic busoff recovery */
+};
+#endif
+
 /*==================================================================================================
 *                                      LOCAL VARIABLES
 ==================================================================================================*/
@@ -325,6 +347,169 @@ static const Can_ControllerConfigType Can_Controller0_Config =
 *                                      GLOBAL CONSTANTS
 ==================================================================================================*/
 
+/**
+ * @brief   CAN Controller Hardware Mapping
+ * @details Hardware resources (peripheral, interrupts, pins, clocks) of each logical controller
+ */
+const Can_ControllerHwConfigType Can_ControllerHwConfig[CAN_MAX_CONTROLLERS] =
+{
+    /* Controller 0 - CAN1: PA12(TX), PA11(RX) */
+    {
+        .Enabled = CAN_CONTROLLER_0_ENABLED,
+        .ControllerId = CAN_CONTROLLER_0_ID,
+        .BaseAddress = CAN_CONTROLLER_0_BASE_ADDRESS,
+        .TxIrqNumber = CAN_CONTROLLER_0_IRQ_NUMBER,
+        .RxIrqNumber = CAN_CONTROLLER_0_RX0_IRQ_NUMBER,
+        .Rx1IrqNumber = CAN_CONTROLLER_0_RX1_IRQ_NUMBER,
+        .ErrorIrqNumber = CAN_CONTROLLER_0_SCE_IRQ_NUMBER,
+        .IrqPriority = CAN_CONTROLLER_0_IRQ_PRIORITY,
+        .Rx1IrqPriority = CAN_CONTROLLER_0_RX1_IRQ_PRIORITY,
+        .GpioPort = GPIOA,
+        .TxPin = GPIO_Pin_12,
+        .RxPin = GPIO_Pin_11,
+        .GpioClockCmd = RCC_APB2Periph_GPIOA,
+        .CanClockCmd = RCC_APB1Periph_CAN1,
+        .FilterBankStart = CAN_CONTROLLER_0_FILTER_BANK_START,
+        .FilterBankCount = CAN_CONTROLLER_0_FILTER_BANK_COUNT,
+        .TestMode = CAN_CONTROLLER_0_TEST_MODE
+    },
+    /* Controller 1 - CAN2: PB13(TX), PB12(RX) */
+    {
+        .Enabled = CAN_CONTROLLER_1_ENABLED,
+        .ControllerId = CAN_CONTROLLER_1_ID,
+        .BaseAddress = CAN_CONTROLLER_1_BASE_ADDRESS,
+        .TxIrqNumber = CAN_CONTROLLER_1_IRQ_NUMBER,
+        .RxIrqNumber = CAN_CONTROLLER_1_RX0_IRQ_NUMBER,
+        .Rx1IrqNumber = CAN_CONTROLLER_1_RX1_IRQ_NUMBER,
+        .ErrorIrqNumber = CAN_CONTROLLER_1_SCE_IRQ_NUMBER,
+        .IrqPriority = CAN_CONTROLLER_1_IRQ_PRIORITY,
+        .Rx1IrqPriority = CAN_CONTROLLER_1_RX1_IRQ_PRIORITY,
+        .GpioPort = GPIOB,
+        .TxPin = GPIO_Pin_13,
+        .RxPin = GPIO_Pin_12,
+        .GpioClockCmd = RCC_APB2Periph_GPIOB,
+        .CanClockCmd = RCC_APB1Periph_CAN2,
+        .FilterBankStart = CAN_CONTROLLER_1_FILTER_BANK_START,
+        .FilterBankCount = CAN_CONTROLLER_1_FILTER_BANK_COUNT,
+        .TestMode = CAN_CONTROLLER_1_TEST_MODE
+    }
+};
+
+/**
+ * @brief   Hardware Transmit Handle Configuration
+ * @details CAN_HTH_0 and CAN_HTH_1 are BasicCAN objects sharing mailboxes 0 and 1. CAN_HTH_2 is a
+ *          FullCAN object with mailbox 2 reserved for one safety-critical cyclic PDU. CAN2 gets the
+ *          same layout with CAN_HTH_3 .. CAN_HTH_5.
+ */
+const Can_HthConfigType Can_HthConfig[CAN_MAX_HTH_OBJECTS] =
+{
+    /* CAN_HTH_0 - BasicCAN */
+    {
+        .ControllerId = CAN_CONTROLLER_0_ID,
+        .HandleType = CAN_HANDLE_TYPE_BASIC,
+        .MailboxMask = CAN_TX_MAILBOX_MASK(0U) | CAN_TX_MAILBOX_MASK(1U),
+        .TriggerTransmit = FALSE
+    },
+    /* CAN_HTH_1 - BasicCAN */
+    {
+        .ControllerId = CAN_CONTROLLER_0_ID,
+        .HandleType = CAN_HANDLE_TYPE_BASIC,
+        .MailboxMask = CAN_TX_MAILBOX_MASK(0U) | CAN_TX_MAILBOX_MASK(1U),
+        .TriggerTransmit = FALSE
+    },
+    /* CAN_HTH_2 - FullCAN, time-triggered when the schedule is configured; payload fetched at load */
+    {
+        .ControllerId = CAN_CONTROLLER_0_ID,
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+        .HandleType = CAN_HANDLE_TYPE_TIME_TRIGGERED,
+#else
+        .HandleType = CAN_HANDLE_TYPE_FULL,
+#endif
+        .MailboxMask = CAN_TX_MAILBOX_MASK(2U),
+        .TriggerTransmit = TRUE
+    }
+#if (CAN_CONTROLLER_1_ENABLED == STD_ON)
+    ,
+    /* CAN_HTH_3 - BasicCAN */
+    {
+        .ControllerId = CAN_CONTROLLER_1_ID,
+        .HandleType = CAN_HANDLE_TYPE_BASIC,
+        .MailboxMask = CAN_TX_MAILBOX_MASK(0U) | CAN_TX_MAILBOX_MASK(1U),
+        .TriggerTransmit = FALSE
+    },
+    /* CAN_HTH_4 - BasicCAN */
+    {
+        .ControllerId = CAN_CONTROLLER_1_ID,
+        .HandleType = CAN_HANDLE_TYPE_BASIC,
+        .MailboxMask = CAN_TX_MAILBOX_MASK(0U) | CAN_TX_MAILBOX_MASK(1U),
+        .TriggerTransmit = FALSE
+    },
+    /* CAN_HTH_5 - FullCAN */
+    {
+        .ControllerId = CAN_CONTROLLER_1_ID,
+        .HandleType = CAN_HANDLE_TYPE_FULL,
+        .MailboxMask = CAN_TX_MAILBOX_MASK(2U),
+        .TriggerTransmit = FALSE
+    }
+#endif
+};
+
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+/**
+ * @brief   Time-triggered Schedule
+ * @details The cyclic PDU of CAN_HTH_2 goes out twice per communication cycle, 1 ms and 6 ms after
+ *          the reference message.
+ */
+const Can_TtSlotConfigType Can_TtSlotConfig[CAN_TT_SLOT_COUNT] =
+{
+    {
+        .Offset = 1000U,
+        .Hth = CAN_HTH_2,
+        .GlobalTime = FALSE
+    },
+    {
+        .Offset = 6000U,
+        .Hth = CAN_HTH_2,
+        .GlobalTime = FALSE
+    }
+};
+#endif
+
+#if (CAN_GATEWAY_SUPPORT == STD_ON)
+/**
+ * @brief   Gateway Routing Table
+ * @details Engine speed goes from CAN1 to CAN2 as 0x180 and is still used locally; it is filtered
+ *          into FIFO 1 so that it is forwarded from the high priority RX interrupt. Diagnostic
+ *          responses of the CAN2 ECUs go to the tester on CAN1 unchanged. CAN2 is CanIf
+ *          controller 1 and is started with CanIf_SetControllerMode like CAN1; CanIf_Init narrows
+ *          its filters to the route sources. Until CAN2 is started route 1 drops every frame and
+ *          route 2 receives nothing.
+ */
+const Can_GwRouteConfigType Can_GwRouteConfig[CAN_GW_ROUTE_COUNT] =
+{
+    {
+        .SrcController = CAN_CONTROLLER_0_ID,
+        .SrcCanId = 0x100U,
+        .SrcMask = CAN_STD_ID_MASK,
+        .SrcHrh = CAN_HRH_1,
+        .DstHth = CAN_HTH_3,
+        .DstCanId = 0x180U,
+        .DstIdMask = CAN_STD_ID_MASK,
+        .PassToUpperLayer = TRUE
+    },
+    {
+        .SrcController = CAN_CONTROLLER_1_ID,
+        .SrcCanId = 0x7E8U,
+        .SrcMask = CAN_STD_ID_MASK,
+        .SrcHrh = CAN_HRH_0,
+        .DstHth = CAN_HTH_0,
+        .DstCanId = 0x000U,
+        .DstIdMask = 0x000U,
+        .PassToUpperLayer = FALSE
+    }
+};
+#endif
+
 /**
  * @brief   CAN Controller Configurations Array
  * @details Array containing configuration for all CAN controllers
@@ -335,6 +520,10 @@ const Can_ConfigType Can_ControllerConfigs[CAN_MAX_CONTROLLERS] =
     {
         .ConfigSet = 0U                          /* Configuration set identifier */
         /* Additional controller-specific configuration members can be added here */
+    },
+    /* Controller 1 Configuration */
+    {
+        .ConfigSet = 0U                          /* Configuration set identifier */
     }
 };
 
@@ -379,6 +568,11 @@ const Can_ControllerConfigType* Can_GetControllerConfig(uint8 ControllerId)
         case CAN_CONTROLLER_0_ID:
             ConfigPtr = &Can_Controller0_Config;
             break;
+#if (CAN_CONTROLLER_1_ENABLED == STD_ON)
+        case CAN_CONTROLLER_1_ID:
+            ConfigPtr = &Can_Controller1_Config;
+            break;
+#endif
         default:
             /* Invalid controller ID */
             break;
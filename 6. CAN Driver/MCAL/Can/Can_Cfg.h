@@ -132,7 +132,7 @@ extern "C" {
  *          true: Enabled, false: Disabled
  * SWS_Can_00494
  */
-#define CAN_GET_CURRENT_TIME_API            STD_OFF
+#define CAN_GET_CURRENT_TIME_API            STD_ON
 
 /**
  * @brief   Enable Egress Time Stamp API
@@ -140,7 +140,7 @@ extern "C" {
  *          true: Enabled, false: Disabled
  * SWS_Can_00496
  */
-#define CAN_ENABLE_EGRESS_TIME_STAMP_API    STD_OFF
+#define CAN_ENABLE_EGRESS_TIME_STAMP_API    STD_ON
 
 /**
  * @brief   Get Egress Time Stamp API
@@ -148,7 +148,7 @@ extern "C" {
  *          true: Enabled, false: Disabled
  * SWS_Can_00497
  */
-#define CAN_GET_EGRESS_TIME_STAMP_API       STD_OFF
+#define CAN_GET_EGRESS_TIME_STAMP_API       STD_ON
 
 /**
  * @brief   Get Ingress Time Stamp API
@@ -156,15 +156,169 @@ extern "C" {
  *          true: Enabled, false: Disabled
  * SWS_Can_00498
  */
-#define CAN_GET_INGRESS_TIME_STAMP_API      STD_OFF
+#define CAN_GET_INGRESS_TIME_STAMP_API      STD_ON
+
+/**
+ * @brief   CAN Gateway Support
+ * @details Enables the CAN-to-CAN gateway of Can_GwRouteConfig: frames received on one controller
+ *          are written to an HTH of another controller, with optional ID translation, by the
+ *          L-PDU callout in the RX ISR, without passing through CanIf and the upper layers.
+ *          Needs a second controller, so it is only enabled on connectivity line devices.
+ *          true: Enabled, false: Disabled
+ */
+#if defined(STM32F10X_CL)
+#define CAN_GATEWAY_SUPPORT                 STD_ON
+#else
+#define CAN_GATEWAY_SUPPORT                 STD_OFF
+#endif
 
 /**
  * @brief   L-PDU Callout Support
- * @details Enables/disables the L-PDU callout functionality.
+ * @details Enables/disables the L-PDU callout functionality. CAN_LPDU_CALLOUT_NAME is called for
+ *          every received L-PDU before it is queued for CanIf; with CAN_GATEWAY_SUPPORT the
+ *          gateway is the callout.
  *          true: Enabled, false: Disabled
  * SWS_Can_00500
  */
-#define CAN_LPDU_CALLOUT_SUPPORT            STD_OFF
+#define CAN_LPDU_CALLOUT_SUPPORT            CAN_GATEWAY_SUPPORT
+
+/**
+ * @brief   L-PDU Callout Name
+ * @details Function called for every received L-PDU when CAN_LPDU_CALLOUT_SUPPORT is enabled, see
+ *          Can.h for its signature. It runs in the RX ISR (in Can_MainFunction_Read with polled
+ *          reception); returning FALSE keeps the L-PDU from CanIf.
+ * SWS_Can_00501
+ */
+#define CAN_LPDU_CALLOUT_NAME               Can_Gw_LPduCallout
+
+/**
+ * @brief   Hardware Transmit Cancellation
+ * @details Enables/disables aborting of the lowest-priority pending TX mailbox when a frame with a
+ *          higher priority has to wait in the TX buffer (avoids priority inversion).
+ *          true: Enabled, false: Disabled
+ * ECUC_Can_00069
+ */
+#define CAN_HW_TRANSMIT_CANCELLATION        STD_ON
+
+/**
+ * @brief   Transmit Cancellation API
+ * @details Enables/disables Can_CancelTx, which removes the pending requests of a PDU from the TX
+ *          buffer and aborts its mailbox. An abort that wins the race against the bus is reported
+ *          with CanIf_CancelTxConfirmation.
+ *          true: Enabled, false: Disabled
+ */
+#define CAN_CANCEL_TX_API                   STD_ON
+
+/**
+ * @brief   Fixed-DLC Write API
+ * @details Enables/disables Can_WriteDlc8, a variant of Can_Write specialised at compile time for
+ *          8-byte payloads. CanIf uses it for every 8-byte L-PDU.
+ *          true: Enabled, false: Disabled
+ */
+#define CAN_WRITE_DLC8_API                  STD_ON
+
+/**
+ * @brief   Trigger Transmit Support
+ * @details Enables Can_Write with sdu = NULL_PTR on HTHs configured with TriggerTransmit. Only the
+ *          mailbox is requested; the payload is fetched with CanIf_TriggerTransmit when the frame
+ *          is loaded into the mailbox, so it is as fresh as the bus allows.
+ *          true: Enabled, false: Disabled
+ */
+#define CAN_TRIGGER_TRANSMIT_SUPPORT        STD_ON
+
+/**
+ * @brief   Statistics API
+ * @details Enables/disables Can_GetStatistics and the frame, bus-load and bus error accounting
+ *          behind it. Loads are measured against the DWT time base (Can_Time).
+ *          true: Enabled, false: Disabled
+ */
+#define CAN_STATISTICS_API                  STD_ON
+
+/**
+ * @brief   Exact Stuff Bit Counting
+ * @details STD_ON: the stuff bits of every frame are counted from its identifier, DLC, payload
+ *          and CRC, four bits per table lookup and outside the critical sections.
+ *          STD_OFF: every frame is counted with the worst-case number of stuff bits.
+ */
+#define CAN_STATISTICS_EXACT_STUFFING       STD_ON
+
+/**
+ * @brief   Bus-load Window
+ * @details Number of Can_MainFunction_Read periods in the sliding bus-load window.
+ */
+#define CAN_STATISTICS_WINDOW_PERIODS       (10U)
+
+/**
+ * @brief   Bus Error Interrupt Limit
+ * @details Bus errors counted by interrupt per Can_MainFunction_Read period. Above the limit the
+ *          last error code interrupt is masked until the next period, so an open or shorted bus
+ *          cannot flood the CPU; errors are then sampled once per period.
+ */
+#define CAN_STATISTICS_LEC_IRQ_LIMIT        (32U)
+
+/**
+ * @brief   Time-triggered Transmission
+ * @details Enables the transmit schedule of Can_TtSlotConfig: frames written to a time-triggered
+ *          HTH are held back and loaded into its mailbox at the offset of their slot within the
+ *          communication cycle. The slots are released from the compare interrupt of
+ *          CAN_TT_TIMER and timed against the DWT time base, the cycle start follows the SOF
+ *          time stamp of the reference message, so CAN_GET_INGRESS_TIME_STAMP_API is required.
+ *          true: Enabled, false: Disabled
+ */
+#define CAN_TT_SCHEDULE_API                 STD_OFF
+
+/**
+ * @brief   Time-triggered Controller
+ * @details Controller the schedule runs on; all time-triggered HTHs must belong to it.
+ */
+#define CAN_TT_CONTROLLER                   CAN_CONTROLLER_0_ID
+
+/**
+ * @brief   Reference Message
+ * @details CAN ID (CAN_ID_EXTENDED_FLAG set for 29-bit IDs) whose reception starts a new
+ *          communication cycle. Without a reference message the schedule runs freely from the
+ *          start of the controller, as on the time master.
+ */
+#define CAN_TT_REFERENCE_ID                 (0x010U)
+
+/**
+ * @brief   Communication Cycle Length
+ * @details Microseconds; the schedule repeats with this period until the next reference message.
+ */
+#define CAN_TT_CYCLE_US                     (10000U)
+
+/**
+ * @brief   Number of Schedule Slots
+ */
+#define CAN_TT_SLOT_COUNT                   (2U)
+
+/**
+ * @brief   Release Window
+ * @details Microseconds a slot may be released after its instant. A slot found later than this,
+ *          e.g. behind a long critical section or after the cycle start moved, is skipped.
+ */
+#define CAN_TT_RELEASE_WINDOW_US            (20U)
+
+/**
+ * @brief   Schedule Timer Interrupt Priority
+ * @details Must be more urgent (numerically lower) than the CAN interrupts so that the slot
+ *          instants are not delayed by frame processing.
+ */
+#define CAN_TT_TIMER_IRQ_PRIORITY           (1U)
+
+/**
+ * @brief   Number of Gateway Routes
+ * @details Entries of Can_GwRouteConfig. A frame is forwarded by every route it matches.
+ */
+#define CAN_GW_ROUTE_COUNT                  (2U)
+
+/**
+ * @brief   Set Controller Test Mode API
+ * @details Enables/disables Can_SetControllerTestMode, which switches a stopped controller
+ *          between normal, loopback, silent and silent loopback operation at runtime.
+ *          true: Enabled, false: Disabled
+ */
+#define CAN_SET_CONTROLLER_TEST_MODE_API    STD_ON
 
 /*============================ Processing Configuration Parameters =============================*/
 
@@ -177,6 +331,7 @@ extern "C" {
  */
 #define INTERRUPT                           (0U)
 #define POLLING                             (1U)
+#define ADAPTIVE                            (2U)
 #define CAN_TX_PROCESSING                   INTERRUPT
 
 /**
@@ -184,9 +339,33 @@ extern "C" {
  * @details Defines whether RX indication is handled via interrupt or polling.
  *          INTERRUPT: Interrupt-driven processing
  *          POLLING: Polling-based processing
+ *          ADAPTIVE: Interrupts at low load, polling from Can_MainFunction_Read under high load
  * SWS_Can_00104
  */
-#define CAN_RX_PROCESSING                   INTERRUPT
+#define CAN_RX_PROCESSING                   ADAPTIVE
+
+/**
+ * @brief   Adaptive RX Thresholds
+ * @details Used when CAN_RX_PROCESSING is ADAPTIVE. The load is the number of frames queued per
+ *          Can_MainFunction_Read period. At CAN_RX_POLL_ENTER_THRESHOLD or more the FIFO message
+ *          pending interrupts are masked and only the FIFO full interrupts stay enabled (one
+ *          interrupt per three frames); the FIFOs are otherwise drained by Can_MainFunction_Read.
+ *          After CAN_RX_POLL_EXIT_PERIODS consecutive periods at CAN_RX_POLL_EXIT_THRESHOLD or
+ *          fewer frames the message pending interrupts are enabled again.
+ */
+#define CAN_RX_POLL_ENTER_THRESHOLD         (16U)
+#define CAN_RX_POLL_EXIT_THRESHOLD          (4U)
+#define CAN_RX_POLL_EXIT_PERIODS            (8U)
+
+/**
+ * @brief   Rx Indication Batch Size
+ * @details Frames Can_MainFunction_Read hands over to CanIf_RxIndicationBatch in one call, from
+ *          the ring of one Rx lane in reception order. CanIf then checks its state and the PDU
+ *          mode once per batch instead of once per frame. 1 indicates every frame on its own
+ *          through CanIf_RxIndication. Can_GetIngressTimeStamp keeps the stamp of every frame of
+ *          the batch, so time stamps do not shorten the batches.
+ */
+#define CAN_RX_INDICATION_BATCH_SIZE        (8U)
 
 /**
  * @brief   Bus-off Processing Configuration
@@ -197,6 +376,21 @@ extern "C" {
  */
 #define CAN_BUSOFF_PROCESSING               INTERRUPT
 
+/**
+ * @brief   Bus-off Recovery Configuration
+ * @details Automatic bus-off management (ABOM) is off; Can_MainFunction_BusOff restarts a
+ *          controller after a bus-off event. A restart requests initialization mode and leaves
+ *          it again, then the hardware waits for 128 occurrences of 11 recessive bits before the
+ *          controller is back on the bus. The first CAN_BUSOFF_FAST_RETRIES bus-off events of an
+ *          episode are restarted after CAN_BUSOFF_FAST_DELAY periods, later ones after
+ *          CAN_BUSOFF_SLOW_DELAY periods. An episode ends once the controller stayed on the bus
+ *          for CAN_BUSOFF_STABLE_PERIODS periods. All values count Can_MainFunction_BusOff calls.
+ */
+#define CAN_BUSOFF_FAST_RETRIES             (5U)
+#define CAN_BUSOFF_FAST_DELAY               (0U)
+#define CAN_BUSOFF_SLOW_DELAY               (100U)
+#define CAN_BUSOFF_STABLE_PERIODS           (100U)
+
 /**
  * @brief   Wakeup Processing Configuration
  * @details Defines whether wakeup events are handled via interrupt or polling.
@@ -215,6 +409,14 @@ extern "C" {
  */
 #define CAN_MODE_PROCESSING                 POLLING
 
+/**
+ * @brief   Mode Transition Timeout
+ * @details Number of Can_MainFunction_Mode calls a requested mode transition may take until the
+ *          hardware acknowledges it. Leaving initialization mode needs 11 recessive bits on the
+ *          bus, so a bus stuck dominant never completes a start.
+ */
+#define CAN_MODE_TRANSITION_TIMEOUT         (10U)
+
 /*============================== Hardware Configuration Parameters =============================*/
 
 /**
@@ -228,17 +430,25 @@ extern "C" {
  * @brief   Number of CAN Controllers Available on Current Platform
  * @details Specifies the actual number of CAN controllers available on current board.
  *          This should be configured based on the target hardware:
- *          - STM32F103C8T6: 1 (only CAN1)
- *          - STM32F103VET6: 2 (CAN1 + CAN2)
+ *          - STM32F103 (low/medium/high density): 1 (only CAN1)
+ *          - STM32F105/107 (connectivity line, STM32F10X_CL): 2 (CAN1 + CAN2)
  *          - Other MCUs: Configure according to datasheet
  */
+#if defined(STM32F10X_CL)
+#define CAN_CONTROLLERS_AVAILABLE           (2U)
+#else
 #define CAN_CONTROLLERS_AVAILABLE           (1U)
+#endif
 
 /**
  * @brief   Controller Enable Status Array
  * @details Defines which controllers are enabled in the current configuration
  */
+#if defined(STM32F10X_CL)
+#define CAN_CONTROLLER_ENABLE_MASK          (0x03U)  /* CAN1 and CAN2 */
+#else
 #define CAN_CONTROLLER_ENABLE_MASK          (0x01U)  /* Only CAN1 enabled for STM32F103C8 */
+#endif
 
 /**
  * @brief   Maximum Number of Hardware Objects
@@ -266,15 +476,20 @@ extern "C" {
 
 /**
  * @brief   Maximum TX Message Buffer Size
- * @details Maximum number of messages that can be buffered for transmission per controller
+ * @details Maximum number of messages that can be buffered for transmission per HTH while all
+ *          three TX mailboxes are busy. The buffer is kept sorted by identifier priority and is
+ *          drained from the transmit mailbox empty interrupt (or Can_MainFunction_Write).
  */
 #define CAN_MAX_TX_BUFFER_SIZE              (10U)
 
 /**
  * @brief   Maximum RX Message Buffer Size
- * @details Maximum number of messages that can be buffered for reception per controller
+ * @details Maximum number of messages that can be buffered for reception per controller and
+ *          hardware FIFO. Each RX ISR drains its FIFO into its own ring (lane) and
+ *          Can_MainFunction_Read forwards FIFO 1 before FIFO 0 to CanIf. Must be a power of
+ *          two (index wrap is done by masking).
  */
-#define CAN_MAX_RX_BUFFER_SIZE              (20U)
+#define CAN_MAX_RX_BUFFER_SIZE              (32U)
 
 /**
  * @brief   CAN Clock Source
@@ -285,6 +500,18 @@ extern "C" {
 
 /*================================ Controller Specific Configuration ===========================*/
 
+/**
+ * @brief   Controller Test Modes
+ * @details Values of the LBKM (bit 30) and SILM (bit 31) pair of CAN_BTR, equal to the SPL
+ *          CAN_Mode_xxx constants. In loopback the controller receives its own frames without an
+ *          acknowledging node; silent loopback additionally keeps the TX pin recessive, so a
+ *          controller can test itself while connected to a live bus.
+ */
+#define CAN_TEST_MODE_NORMAL                (0U)
+#define CAN_TEST_MODE_LOOPBACK              (1U)
+#define CAN_TEST_MODE_SILENT                (2U)
+#define CAN_TEST_MODE_SILENT_LOOPBACK       (3U)
+
 /**
  * @brief   CAN Controller Hardware Mapping Structure
  * @details Maps logical controller ID to hardware resources
@@ -294,14 +521,19 @@ typedef struct {
     uint8           ControllerId;       /**< Logical controller ID */
     uint32          BaseAddress;        /**< Hardware base address */
     uint8           TxIrqNumber;        /**< TX interrupt number */
-    uint8           RxIrqNumber;        /**< RX interrupt number */
+    uint8           RxIrqNumber;        /**< RX FIFO 0 interrupt number */
+    uint8           Rx1IrqNumber;       /**< RX FIFO 1 interrupt number */
     uint8           ErrorIrqNumber;     /**< Error interrupt number */
-    uint8           IrqPriority;        /**< Interrupt priority */
+    uint8           IrqPriority;        /**< Interrupt priority (FIFO 0, TX, SCE) */
+    uint8           Rx1IrqPriority;     /**< Interrupt priority of FIFO 1, the high priority RX lane */
     GPIO_TypeDef*   GpioPort;          /**< GPIO port for CAN pins */
     uint16          TxPin;              /**< TX pin number */
     uint16          RxPin;              /**< RX pin number */
     uint32          GpioClockCmd;       /**< GPIO clock enable command */
     uint32          CanClockCmd;        /**< CAN peripheral clock enable command */
+    uint8           FilterBankStart;    /**< First acceptance filter bank owned by the controller */
+    uint8           FilterBankCount;    /**< Number of acceptance filter banks owned by the controller */
+    uint8           TestMode;           /**< CAN_TEST_MODE_xxx the controller starts with */
 } Can_ControllerHwConfigType;
 
 /**
@@ -317,16 +549,87 @@ extern const Can_ControllerHwConfigType Can_ControllerHwConfig[CAN_MAX_CONTROLLE
 #define CAN_CONTROLLER_0_ID                 (0U)
 #define CAN_CONTROLLER_0_BASE_ADDRESS       (0x40006400UL)  /* CAN1 base address */
 #define CAN_CONTROLLER_0_IRQ_NUMBER         (19U)           /* CAN1_TX IRQ */
+#define CAN_CONTROLLER_0_RX0_IRQ_NUMBER     (20U)           /* CAN1_RX0 IRQ */
+#define CAN_CONTROLLER_0_RX1_IRQ_NUMBER     (21U)           /* CAN1_RX1 IRQ */
+#define CAN_CONTROLLER_0_SCE_IRQ_NUMBER     (22U)           /* CAN1_SCE IRQ */
 #define CAN_CONTROLLER_0_IRQ_PRIORITY       (5U)
+#define CAN_CONTROLLER_0_RX1_IRQ_PRIORITY   (4U)            /* Preempts the other CAN ISRs */
+#define CAN_CONTROLLER_0_RX_STD_IDS         (16U)           /* Standard IDs the controller filters */
+#define CAN_CONTROLLER_0_RX_EXT_IDS         (4U)            /* Extended IDs the controller filters */
+#define CAN_CONTROLLER_0_TEST_MODE          CAN_TEST_MODE_NORMAL
 
 /**
  * @brief   CAN Controller 1 Configuration (if available)
  */
+#if defined(STM32F10X_CL)
+#define CAN_CONTROLLER_1_ENABLED            STD_ON
+#else
 #define CAN_CONTROLLER_1_ENABLED            STD_OFF
+#endif
 #define CAN_CONTROLLER_1_ID                 (1U)
 #define CAN_CONTROLLER_1_BASE_ADDRESS       (0x40006800UL)  /* CAN2 base address */
 #define CAN_CONTROLLER_1_IRQ_NUMBER         (63U)           /* CAN2_TX IRQ */
+#define CAN_CONTROLLER_1_RX0_IRQ_NUMBER     (64U)           /* CAN2_RX0 IRQ */
+#define CAN_CONTROLLER_1_RX1_IRQ_NUMBER     (65U)           /* CAN2_RX1 IRQ */
+#define CAN_CONTROLLER_1_SCE_IRQ_NUMBER     (66U)           /* CAN2_SCE IRQ */
 #define CAN_CONTROLLER_1_IRQ_PRIORITY       (5U)
+#define CAN_CONTROLLER_1_RX1_IRQ_PRIORITY   (4U)            /* Preempts the other CAN ISRs */
+#define CAN_CONTROLLER_1_RX_STD_IDS         (16U)           /* Standard IDs the controller filters */
+#define CAN_CONTROLLER_1_RX_EXT_IDS         (4U)            /* Extended IDs the controller filters */
+#define CAN_CONTROLLER_1_TEST_MODE          CAN_TEST_MODE_NORMAL
+
+/*============================ Filter Bank Partitioning =====================================*/
+
+/**
+ * @brief   Number of Acceptance Filter Banks
+ * @details The filter banks live in CAN1 and are shared with CAN2 on connectivity line devices:
+ *          CAN1 owns banks 0 .. CAN2SB-1, CAN2 owns banks CAN2SB .. 27.
+ */
+#if defined(STM32F10X_CL)
+#define CAN_FILTER_BANK_COUNT_TOTAL         (28U)
+#else
+#define CAN_FILTER_BANK_COUNT_TOTAL         (14U)
+#endif
+
+/**
+ * @brief   Filter Banks Needed for an Identifier List
+ * @details Densest packing (four standard IDs per 16-bit list bank, two extended IDs per 32-bit
+ *          list bank) plus one bank for splitting a group over both FIFOs. Can_SetRxFilter still
+ *          merges identifiers into masks when a controller gets fewer banks than this.
+ */
+#define CAN_FILTER_BANKS_FOR_IDS(StdIds, ExtIds) \
+    ((((StdIds) + 3U) / 4U) + (((ExtIds) + 1U) / 2U) + 1U)
+
+#define CAN_CONTROLLER_0_FILTER_BANKS_NEEDED \
+    CAN_FILTER_BANKS_FOR_IDS(CAN_CONTROLLER_0_RX_STD_IDS, CAN_CONTROLLER_0_RX_EXT_IDS)
+#define CAN_CONTROLLER_1_FILTER_BANKS_NEEDED \
+    CAN_FILTER_BANKS_FOR_IDS(CAN_CONTROLLER_1_RX_STD_IDS, CAN_CONTROLLER_1_RX_EXT_IDS)
+
+/**
+ * @brief   Filter Bank Split (CAN2SB)
+ * @details With both controllers enabled the banks are divided in proportion to the banks each
+ *          controller needs, so both get at least their need whenever the sum fits. Written to
+ *          CAN_FMR.CAN2SB by Can_Init. CAN2SB is at most 27, so an unused CAN2 keeps one bank.
+ */
+#if (CAN_CONTROLLER_1_ENABLED == STD_ON)
+#define CAN_CONTROLLER_1_FILTER_BANK_START \
+    ((uint8)(((CAN_FILTER_BANK_COUNT_TOTAL * CAN_CONTROLLER_0_FILTER_BANKS_NEEDED) + \
+              ((CAN_CONTROLLER_0_FILTER_BANKS_NEEDED + CAN_CONTROLLER_1_FILTER_BANKS_NEEDED) / 2U)) / \
+             (CAN_CONTROLLER_0_FILTER_BANKS_NEEDED + CAN_CONTROLLER_1_FILTER_BANKS_NEEDED)))
+#elif defined(STM32F10X_CL)
+#define CAN_CONTROLLER_1_FILTER_BANK_START  ((uint8)(CAN_FILTER_BANK_COUNT_TOTAL - 1U))
+#else
+#define CAN_CONTROLLER_1_FILTER_BANK_START  ((uint8)CAN_FILTER_BANK_COUNT_TOTAL)
+#endif
+
+#define CAN_CONTROLLER_0_FILTER_BANK_START  (0U)
+#define CAN_CONTROLLER_0_FILTER_BANK_COUNT  (CAN_CONTROLLER_1_FILTER_BANK_START)
+#define CAN_CONTROLLER_1_FILTER_BANK_COUNT  ((uint8)(CAN_FILTER_BANK_COUNT_TOTAL - CAN_CONTROLLER_1_FILTER_BANK_START))
+
+#if (CAN_CONTROLLER_1_ENABLED == STD_ON) && \
+    ((CAN_CONTROLLER_0_FILTER_BANKS_NEEDED + CAN_CONTROLLER_1_FILTER_BANKS_NEEDED) > CAN_FILTER_BANK_COUNT_TOTAL)
+    #warning "CAN filter banks overcommitted, Can_SetRxFilter will merge identifiers into masks"
+#endif
 
 /*=============================== Baudrate Configuration IDs ===============================*/
 
@@ -354,22 +657,111 @@ extern const Can_ControllerHwConfigType Can_ControllerHwConfig[CAN_MAX_CONTROLLE
 #define CAN_HTH_0                           (0U)
 #define CAN_HTH_1                           (1U)
 #define CAN_HTH_2                           (2U)
+#if (CAN_CONTROLLER_1_ENABLED == STD_ON)
+#define CAN_HTH_3                           (3U)    /* CAN2 */
+#define CAN_HTH_4                           (4U)    /* CAN2 */
+#define CAN_HTH_5                           (5U)    /* CAN2 */
+#endif
+
+/**
+ * @brief   Hardware Object Handle Types
+ * @details CanHandleType of a transmit object (ECUC_Can_00323)
+ */
+#define CAN_HANDLE_TYPE_BASIC               (0U)    /**< Shares mailboxes with other BasicCAN HTHs */
+#define CAN_HANDLE_TYPE_FULL                (1U)    /**< Owns one dedicated mailbox */
+#define CAN_HANDLE_TYPE_TIME_TRIGGERED      (2U)    /**< Owns one dedicated mailbox, loaded by the schedule */
+
+/**
+ * @brief   Number of TX Mailboxes per Controller
+ */
+#define CAN_TX_MAILBOX_COUNT                (3U)
+
+/**
+ * @brief   TX Mailbox Mask
+ * @details Bit of a TX mailbox (0..2) in Can_HthConfigType.MailboxMask
+ */
+#define CAN_TX_MAILBOX_MASK(mailbox)        ((uint8)(1U << (mailbox)))
+
+/**
+ * @brief   Hardware Transmit Handle Configuration Structure
+ * @details Maps an HTH (index into Can_HthConfig) to its controller and TX mailboxes. A FullCAN
+ *          HTH owns exactly one mailbox that no other HTH of the controller may list, so its
+ *          frames never wait behind BasicCAN traffic. BasicCAN HTHs share the remaining ones.
+ */
+typedef struct {
+    uint8           ControllerId;       /**< Controller owning the HTH */
+    uint8           HandleType;         /**< CAN_HANDLE_TYPE_FULL / CAN_HANDLE_TYPE_BASIC */
+    uint8           MailboxMask;        /**< TX mailboxes the HTH may use (CAN_TX_MAILBOX_MASK) */
+    boolean         TriggerTransmit;    /**< Payload fetched with CanIf_TriggerTransmit (CAN_TRIGGER_TRANSMIT_SUPPORT) */
+} Can_HthConfigType;
+
+/**
+ * @brief   Hardware Transmit Handle Configuration Array
+ */
+extern const Can_HthConfigType Can_HthConfig[CAN_MAX_HTH_OBJECTS];
+
+#if (CAN_TT_SCHEDULE_API == STD_ON)
+/**
+ * @brief   Time-triggered Schedule Slot
+ * @details At Offset microseconds after the cycle start, the frame waiting on Hth is loaded into
+ *          the mailbox of the HTH. Slots are sorted by Offset and lie within CAN_TT_CYCLE_US; an
+ *          HTH may own several slots of a cycle.
+ */
+typedef struct {
+    uint32          Offset;             /**< Microseconds after the cycle start */
+    uint8           Hth;                /**< CAN_HANDLE_TYPE_TIME_TRIGGERED HTH */
+    boolean         GlobalTime;         /**< Set TGT: bytes 6 and 7 carry the SOF time (DLC 8 only) */
+} Can_TtSlotConfigType;
+
+/**
+ * @brief   Time-triggered Schedule
+ */
+extern const Can_TtSlotConfigType Can_TtSlotConfig[CAN_TT_SLOT_COUNT];
+#endif
+
+#if (CAN_GATEWAY_SUPPORT == STD_ON)
+/**
+ * @brief   Gateway Route
+ * @details Frames received on SrcController whose identifier matches SrcCanId under SrcMask are
+ *          written to DstHth. The bits of DstIdMask are replaced by DstCanId, so a mask of 0
+ *          forwards the identifier unchanged and CAN_ID_EXTENDED_FLAG | CAN_EXT_ID_MASK replaces
+ *          it completely. SrcHrh selects the FIFO the source identifiers are filtered into;
+ *          CAN_HRH_1 gives the route the high priority RX interrupt.
+ */
+typedef struct {
+    uint8           SrcController;      /**< Controller the frames are received on */
+    Can_IdType      SrcCanId;           /**< Source identifier, CAN_ID_EXTENDED_FLAG for 29-bit IDs */
+    Can_IdType      SrcMask;            /**< Identifier bits that must match, 1 = must match */
+    Can_HwHandleType SrcHrh;            /**< CAN_HRH_0 / CAN_HRH_1 */
+    Can_HwHandleType DstHth;            /**< HTH the frames are written to */
+    Can_IdType      DstCanId;           /**< Replacement bits of the identifier */
+    Can_IdType      DstIdMask;          /**< Identifier bits taken from DstCanId */
+    boolean         PassToUpperLayer;   /**< Also indicate the frame to CanIf */
+} Can_GwRouteConfigType;
+
+/**
+ * @brief   Gateway Routing Table
+ */
+extern const Can_GwRouteConfigType Can_GwRouteConfig[CAN_GW_ROUTE_COUNT];
+#endif
 
 /**
  * @brief   Hardware Receive Handle (HRH) IDs
- * @details Identifiers for hardware receive objects
+ * @details Identifiers for hardware receive objects, numbered after the HTHs. Every controller
+ *          receives through its own FIFO 0 and FIFO 1; received frames carry the controller in
+ *          Can_HwType.ControllerId.
  */
-#define CAN_HRH_0                           (3U)  /* FIFO 0 */
-#define CAN_HRH_1                           (4U)  /* FIFO 1 */
+#define CAN_HRH_0                           (CAN_MAX_HTH_OBJECTS)         /* FIFO 0 */
+#define CAN_HRH_1                           (CAN_MAX_HTH_OBJECTS + 1U)    /* FIFO 1 */
 
 /*============================ Filter Configuration Parameters ==============================*/
 
 /**
  * @brief   Maximum Number of Message Filters
- * @details Maximum number of acceptance filters that can be configured
- *          STM32F103 CAN1: 14 filters (0-13)
+ * @details Maximum number of acceptance filter banks one controller can own
+ *          STM32F103 CAN1: 14 filters (0-13), STM32F105/107: 28 shared by CAN1 and CAN2
  */
-#define CAN_MAX_FILTER_COUNT                (14U)
+#define CAN_MAX_FILTER_COUNT                (CAN_FILTER_BANK_COUNT_TOTAL)
 
 /**
  * @brief   Default Filter Configuration
@@ -377,6 +769,19 @@ extern const Can_ControllerHwConfigType Can_ControllerHwConfig[CAN_MAX_CONTROLLE
  */
 #define CAN_DEFAULT_FILTER_MODE             STD_ON  /* Accept all messages */
 
+/**
+ * @brief   Rx Filter API
+ * @details Enable/Disable Can_SetRxFilter / Can_GetRxFilterReport. When enabled CanIf compiles its
+ *          Rx PDU table into hardware filter banks at CanIf_Init.
+ */
+#define CAN_RX_FILTER_API                   STD_ON
+
+/**
+ * @brief   Maximum Number of Filter Identifiers
+ * @details Maximum number of entries accepted by one Can_SetRxFilter call
+ */
+#define CAN_FILTER_MAX_IDS                  (128U)
+
 /*============================ Timeout Configuration Parameters =============================*/
 
 /**
@@ -0,0 +1,627 @@
+/****************************************************************************************
+*                               CAN_FILTER.C                                           *
+****************************************************************************************
+* File Name   : Can_Filter.c
+* Module      : Controller Area Network (CAN)
+* Description : bxCAN acceptance filter bank compiler
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+***************************************************************************************/
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Can_Filter.h"
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/**
+ * @brief   Working entry of the compiler: one identifier or identifier range of one group
+ */
+typedef struct
+{
+    Can_IdType  Id;             /**< Identifier bits, already masked */
+    Can_IdType  Mask;           /**< Acceptance mask within the identifier width */
+    uint8       Group;          /**< CAN_FILTER_GROUP(Fifo, Extended) */
+} Can_FilterEntryType;
+
+/*==================================================================================================
+*                                       LOCAL MACROS
+==================================================================================================*/
+
+/* Entries are grouped by FIFO and identifier type, every group gets its own banks */
+#define CAN_FILTER_GROUP_COUNT              (4U)
+#define CAN_FILTER_GROUP(Fifo, Extended)    ((uint8)(((Fifo) << 1U) | (Extended)))
+#define CAN_FILTER_GROUP_FIFO(Group)        ((uint8)((Group) >> 1U))
+#define CAN_FILTER_GROUP_IS_EXT(Group)      (((Group) & 1U) != 0U)
+#define CAN_FILTER_GROUP_ID_MASK(Group)     (CAN_FILTER_GROUP_IS_EXT(Group) ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK)
+#define CAN_FILTER_GROUP_ID_BITS(Group)     (CAN_FILTER_GROUP_IS_EXT(Group) ? 29U : 11U)
+
+/* Filter elements per bank */
+#define CAN_FILTER_STD_PER_LIST_BANK        (4U)
+#define CAN_FILTER_STD_PER_MASK_BANK        (2U)
+#define CAN_FILTER_EXT_PER_LIST_BANK        (2U)
+
+/* Register layout, 16-bit scale: STID[10:0] RTR IDE EXID[17:15] */
+#define CAN_FILTER_16BIT_STID_SHIFT         (5U)
+#define CAN_FILTER_16BIT_RTR                (0x0010U)
+#define CAN_FILTER_16BIT_IDE                (0x0008U)
+
+/* Register layout, 32-bit scale: STID[10:0] EXID[17:0] IDE RTR 0 */
+#define CAN_FILTER_32BIT_EXID_SHIFT         (3U)
+#define CAN_FILTER_32BIT_IDE                (0x00000004UL)
+#define CAN_FILTER_32BIT_RTR                (0x00000002UL)
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/* Scratch area of the compiler */
+static Can_FilterEntryType Can_FilterWork[CAN_FILTER_MAX_IDS];
+static uint16 Can_FilterWorkCount;
+
+/* Number of exact (single identifier) and masked entries per group */
+static uint16 Can_FilterExactCount[CAN_FILTER_GROUP_COUNT];
+static uint16 Can_FilterMaskCount[CAN_FILTER_GROUP_COUNT];
+
+/*==================================================================================================
+*                                   LOCAL FUNCTION PROTOTYPES
+==================================================================================================*/
+static uint32 Can_Filter_SaturatedAdd(uint32 A, uint32 B);
+static boolean Can_Filter_AddIds(const Can_FilterIdType* IdList, uint16 IdCount);
+static uint32 Can_Filter_AcceptedCount(const Can_FilterEntryType* Entry);
+static boolean Can_Filter_IsExact(const Can_FilterEntryType* Entry);
+static boolean Can_Filter_Covers(const Can_FilterEntryType* Outer, const Can_FilterEntryType* Inner);
+static void Can_Filter_RemoveEntry(uint16 Index);
+static void Can_Filter_RemoveCovered(void);
+static boolean Can_Filter_IsBefore(const Can_FilterEntryType* First, const Can_FilterEntryType* Second, boolean ByKind);
+static void Can_Filter_Sort(boolean ByKind);
+static void Can_Filter_Count(void);
+static uint16 Can_Filter_GroupBanks(uint8 Group, uint16 ExactCount, uint16 MaskCount, uint16* MovedPtr);
+static uint16 Can_Filter_TotalBanks(void);
+static boolean Can_Filter_MergeBestPair(void);
+static uint8 Can_Filter_EmitGroup(uint8 Group, uint16 Start, uint8 FirstBank, uint8 BankCount, Can_FilterBankType* BankPtr);
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+static uint32 Can_Filter_SaturatedAdd(uint32 A, uint32 B)
+{
+    return ((0xFFFFFFFFUL - A) < B) ? 0xFFFFFFFFUL : (A + B);
+}
+
+/**
+ * @brief   Append an identifier list to the scratch area
+ * @return  FALSE if an entry names neither FIFO
+ */
+static boolean Can_Filter_AddIds(const Can_FilterIdType* IdList, uint16 IdCount)
+{
+    Can_FilterEntryType* Entry;
+    uint16 Index;
+    uint8 Fifo;
+
+    for (Index = 0U; Index < IdCount; Index++)
+    {
+        if (IdList[Index].Hrh == CAN_HRH_0)
+        {
+            Fifo = 0U;
+        }
+        else if (IdList[Index].Hrh == CAN_HRH_1)
+        {
+            Fifo = 1U;
+        }
+        else
+        {
+            return FALSE;
+        }
+
+        Entry = &Can_FilterWork[Can_FilterWorkCount++];
+        Entry->Group = CAN_FILTER_GROUP(Fifo, ((IdList[Index].CanId & CAN_ID_EXTENDED_FLAG) != 0U) ? 1U : 0U);
+        Entry->Mask = IdList[Index].Mask & CAN_FILTER_GROUP_ID_MASK(Entry->Group);
+        Entry->Id = IdList[Index].CanId & Entry->Mask;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief   Number of identifiers accepted by one entry (2 ^ don't-care bits)
+ */
+static uint32 Can_Filter_AcceptedCount(const Can_FilterEntryType* Entry)
+{
+    Can_IdType Mask = Entry->Mask;
+    uint8 FreeBits = (uint8)CAN_FILTER_GROUP_ID_BITS(Entry->Group);
+
+    while (Mask != 0U)
+    {
+        Mask &= (Mask - 1U);
+        FreeBits--;
+    }
+
+    return (uint32)1UL << FreeBits;
+}
+
+static boolean Can_Filter_IsExact(const Can_FilterEntryType* Entry)
+{
+    return (boolean)(Entry->Mask == CAN_FILTER_GROUP_ID_MASK(Entry->Group));
+}
+
+/**
+ * @brief   TRUE if every identifier accepted by Inner is also accepted by Outer
+ */
+static boolean Can_Filter_Covers(const Can_FilterEntryType* Outer, const Can_FilterEntryType* Inner)
+{
+    return (boolean)((Outer->Group == Inner->Group) &&
+                     ((Outer->Mask & Inner->Mask) == Outer->Mask) &&
+                     ((Inner->Id & Outer->Mask) == Outer->Id));
+}
+
+static void Can_Filter_RemoveEntry(uint16 Index)
+{
+    uint16 Next;
+
+    for (Next = Index + 1U; Next < Can_FilterWorkCount; Next++)
+    {
+        Can_FilterWork[Next - 1U] = Can_FilterWork[Next];
+    }
+    Can_FilterWorkCount--;
+}
+
+/**
+ * @brief   Drop duplicates and entries that are already accepted by a wider entry
+ */
+static void Can_Filter_RemoveCovered(void)
+{
+    uint16 Outer = 0U;
+    uint16 Inner;
+
+    while (Outer < Can_FilterWorkCount)
+    {
+        Inner = 0U;
+        while (Inner < Can_FilterWorkCount)
+        {
+            if ((Inner != Outer) && (Can_Filter_Covers(&Can_FilterWork[Outer], &Can_FilterWork[Inner]) == TRUE))
+            {
+                Can_Filter_RemoveEntry(Inner);
+                if (Inner < Outer)
+                {
+                    Outer--;
+                }
+            }
+            else
+            {
+                Inner++;
+            }
+        }
+        Outer++;
+    }
+}
+
+/**
+ * @brief   Sort order of the scratch area: group, then (ByKind) exact before masked, then identifier
+ */
+static boolean Can_Filter_IsBefore(const Can_FilterEntryType* First, const Can_FilterEntryType* Second, boolean ByKind)
+{
+    boolean FirstExact;
+    boolean SecondExact;
+
+    if (First->Group != Second->Group)
+    {
+        return (boolean)(First->Group < Second->Group);
+    }
+
+    if (ByKind == TRUE)
+    {
+        FirstExact = Can_Filter_IsExact(First);
+        SecondExact = Can_Filter_IsExact(Second);
+        if (FirstExact != SecondExact)
+        {
+            return FirstExact;
+        }
+    }
+
+    return (boolean)(First->Id < Second->Id);
+}
+
+/**
+ * @brief   Sort the scratch area
+ * @details Insertion sort: the area is sorted once and only one entry moves after each merge.
+ */
+static void Can_Filter_Sort(boolean ByKind)
+{
+    uint16 Index;
+    uint16 Slot;
+    Can_FilterEntryType Entry;
+
+    for (Index = 1U; Index < Can_FilterWorkCount; Index++)
+    {
+        Entry = Can_FilterWork[Index];
+        Slot = Index;
+        while ((Slot > 0U) && (Can_Filter_IsBefore(&Entry, &Can_FilterWork[Slot - 1U], ByKind) == TRUE))
+        {
+            Can_FilterWork[Slot] = Can_FilterWork[Slot - 1U];
+            Slot--;
+        }
+        Can_FilterWork[Slot] = Entry;
+    }
+}
+
+static void Can_Filter_Count(void)
+{
+    uint16 Index;
+    uint8 Group;
+
+    for (Group = 0U; Group < CAN_FILTER_GROUP_COUNT; Group++)
+    {
+        Can_FilterExactCount[Group] = 0U;
+        Can_FilterMaskCount[Group] = 0U;
+    }
+
+    for (Index = 0U; Index < Can_FilterWorkCount; Index++)
+    {
+        if (Can_Filter_IsExact(&Can_FilterWork[Index]) == TRUE)
+        {
+            Can_FilterExactCount[Can_FilterWork[Index].Group]++;
+        }
+        else
+        {
+            Can_FilterMaskCount[Can_FilterWork[Index].Group]++;
+        }
+    }
+}
+
+/**
+ * @brief   Banks needed by one group
+ * @details Standard identifiers use 16-bit banks. A partly used 16-bit mask bank can take single
+ *          identifiers as well, so up to three exact entries are tried in mask slots.
+ *          Extended identifiers use 32-bit banks: list banks take two, mask banks one entry.
+ *
+ * @param[out]  MovedPtr    Number of exact entries placed in mask slots
+ */
+static uint16 Can_Filter_GroupBanks(uint8 Group, uint16 ExactCount, uint16 MaskCount, uint16* MovedPtr)
+{
+    uint16 Best;
+    uint16 Banks;
+    uint16 Moved;
+
+    *MovedPtr = 0U;
+
+    if (CAN_FILTER_GROUP_IS_EXT(Group))
+    {
+        return (uint16)(((ExactCount + CAN_FILTER_EXT_PER_LIST_BANK) - 1U) / CAN_FILTER_EXT_PER_LIST_BANK) + MaskCount;
+    }
+
+    Best = 0xFFFFU;
+    for (Moved = 0U; (Moved <= ExactCount) && (Moved < CAN_FILTER_STD_PER_LIST_BANK); Moved++)
+    {
+        Banks = (uint16)((((ExactCount - Moved) + CAN_FILTER_STD_PER_LIST_BANK) - 1U) / CAN_FILTER_STD_PER_LIST_BANK) +
+                (uint16)((((MaskCount + Moved) + CAN_FILTER_STD_PER_MASK_BANK) - 1U) / CAN_FILTER_STD_PER_MASK_BANK);
+        if (Banks < Best)
+        {
+            Best = Banks;
+            *MovedPtr = Moved;
+        }
+    }
+
+    return Best;
+}
+
+static uint16 Can_Filter_TotalBanks(void)
+{
+    uint16 Total = 0U;
+    uint16 Moved;
+    uint8 Group;
+
+    for (Group = 0U; Group < CAN_FILTER_GROUP_COUNT; Group++)
+    {
+        Total += Can_Filter_GroupBanks(Group, Can_FilterExactCount[Group], Can_FilterMaskCount[Group], &Moved);
+    }
+
+    return Total;
+}
+
+/**
+ * @brief   Merge the neighbouring pair that costs the fewest additional identifiers
+ * @details The pair whose merged mask lets through the fewest identifiers that neither entry
+ *          accepted before wins; on a tie the pair that saves more banks is taken.
+ *
+ * @return  FALSE when no pair is left to merge
+ */
+static boolean Can_Filter_MergeBestPair(void)
+{
+    Can_FilterEntryType Merged;
+    Can_FilterEntryType BestMerged;
+    uint16 BestIndex = 0xFFFFU;
+    uint16 BestBanks = 0xFFFFU;
+    uint32 BestAdded = 0xFFFFFFFFUL;
+    uint16 Index;
+    uint16 Exact;
+    uint16 Masked;
+    uint16 Banks;
+    uint16 Moved;
+    uint32 Before;
+    uint32 After;
+    uint32 Added;
+    uint8 Group;
+
+    for (Index = 0U; (Index + 1U) < Can_FilterWorkCount; Index++)
+    {
+        Group = Can_FilterWork[Index].Group;
+        if (Can_FilterWork[Index + 1U].Group != Group)
+        {
+            continue;
+        }
+
+        Merged.Group = Group;
+        Merged.Mask = Can_FilterWork[Index].Mask & Can_FilterWork[Index + 1U].Mask &
+                      ~(Can_FilterWork[Index].Id ^ Can_FilterWork[Index + 1U].Id);
+        Merged.Id = Can_FilterWork[Index].Id & Merged.Mask;
+
+        /* Banks of the group with the pair replaced by one masked entry */
+        Exact = Can_FilterExactCount[Group];
+        Masked = Can_FilterMaskCount[Group] + 1U;
+        if (Can_Filter_IsExact(&Can_FilterWork[Index]) == TRUE) { Exact--; } else { Masked--; }
+        if (Can_Filter_IsExact(&Can_FilterWork[Index + 1U]) == TRUE) { Exact--; } else { Masked--; }
+        Banks = (uint16)(Can_Filter_TotalBanks()
+                         - Can_Filter_GroupBanks(Group, Can_FilterExactCount[Group], Can_FilterMaskCount[Group], &Moved)
+                         + Can_Filter_GroupBanks(Group, Exact, Masked, &Moved));
+
+        Before = Can_Filter_SaturatedAdd(Can_Filter_AcceptedCount(&Can_FilterWork[Index]),
+                                         Can_Filter_AcceptedCount(&Can_FilterWork[Index + 1U]));
+        After = Can_Filter_AcceptedCount(&Merged);
+        Added = (After > Before) ? (After - Before) : 0U;
+
+        if ((Added < BestAdded) || ((Added == BestAdded) && (Banks < BestBanks)))
+        {
+            BestIndex = Index;
+            BestBanks = Banks;
+            BestAdded = Added;
+            BestMerged = Merged;
+        }
+    }
+
+    if (BestIndex == 0xFFFFU)
+    {
+        return FALSE;
+    }
+
+    Can_FilterWork[BestIndex] = BestMerged;
+    Can_Filter_RemoveEntry(BestIndex + 1U);
+    Can_Filter_RemoveCovered();
+    Can_Filter_Sort(FALSE);
+    Can_Filter_Count();
+
+    return TRUE;
+}
+
+/**
+ * @brief   Write the register images of one group
+ * @details The scratch area is sorted by kind, so the group starts with its exact entries followed
+ *          by its masked entries. The last exact entries share mask banks with the masked ones.
+ *          Unused elements of a bank repeat the first element of the bank so that they do not
+ *          accept additional identifiers.
+ *
+ * @param[in]   Start       Index of the first scratch entry of the group
+ *
+ * @return  Index of the next free bank
+ */
+static uint8 Can_Filter_EmitGroup(uint8 Group, uint16 Start, uint8 FirstBank, uint8 BankCount, Can_FilterBankType* BankPtr)
+{
+    const boolean Extended = CAN_FILTER_GROUP_IS_EXT(Group);
+    const Can_FilterEntryType* First;
+    const Can_FilterEntryType* Second;
+    uint16 ListEnd;
+    uint16 MaskEnd;
+    uint16 Moved;
+    uint16 Index;
+    uint16 Element;
+    uint16 Count;
+    uint32 Slot[CAN_FILTER_STD_PER_LIST_BANK];
+    uint8 Bank = FirstBank;
+    Can_FilterBankType* Filter;
+
+    (void)Can_Filter_GroupBanks(Group, Can_FilterExactCount[Group], Can_FilterMaskCount[Group], &Moved);
+    ListEnd = (Start + Can_FilterExactCount[Group]) - Moved;
+    MaskEnd = Start + Can_FilterExactCount[Group] + Can_FilterMaskCount[Group];
+
+    /* List banks */
+    Count = Extended ? CAN_FILTER_EXT_PER_LIST_BANK : CAN_FILTER_STD_PER_LIST_BANK;
+    for (Index = Start; (Index < ListEnd) && (Bank < BankCount); Index += Count)
+    {
+        for (Element = 0U; Element < Count; Element++)
+        {
+            First = &Can_FilterWork[((Index + Element) < ListEnd) ? (Index + Element) : Index];
+            Slot[Element] = Extended
+                          ? (((uint32)First->Id << CAN_FILTER_32BIT_EXID_SHIFT) | CAN_FILTER_32BIT_IDE)
+                          : ((uint32)First->Id << CAN_FILTER_16BIT_STID_SHIFT);
+        }
+
+        Filter = &BankPtr[Bank++];
+        Filter->Fifo = CAN_FILTER_GROUP_FIFO(Group);
+        Filter->Mode = CAN_FILTER_MODE_LIST;
+        if (Extended)
+        {
+            Filter->Scale = CAN_FILTER_SCALE_32BIT;
+            Filter->FR1 = Slot[0];
+            Filter->FR2 = Slot[1];
+        }
+        else
+        {
+            Filter->Scale = CAN_FILTER_SCALE_16BIT;
+            Filter->FR1 = Slot[0] | (Slot[1] << 16U);
+            Filter->FR2 = Slot[2] | (Slot[3] << 16U);
+        }
+    }
+
+    /* Mask banks; remote frames and the other identifier type never match */
+    Count = Extended ? 1U : CAN_FILTER_STD_PER_MASK_BANK;
+    for (Index = ListEnd; (Index < MaskEnd) && (Bank < BankCount); Index += Count)
+    {
+        First = &Can_FilterWork[Index];
+        Second = ((Index + 1U) < MaskEnd) ? &Can_FilterWork[Index + 1U] : First;
+
+        Filter = &BankPtr[Bank++];
+        Filter->Fifo = CAN_FILTER_GROUP_FIFO(Group);
+        Filter->Mode = CAN_FILTER_MODE_MASK;
+        if (Extended)
+        {
+            Filter->Scale = CAN_FILTER_SCALE_32BIT;
+            Filter->FR1 = ((uint32)First->Id << CAN_FILTER_32BIT_EXID_SHIFT) | CAN_FILTER_32BIT_IDE;
+            Filter->FR2 = ((uint32)First->Mask << CAN_FILTER_32BIT_EXID_SHIFT) |
+                          CAN_FILTER_32BIT_IDE | CAN_FILTER_32BIT_RTR;
+        }
+        else
+        {
+            Filter->Scale = CAN_FILTER_SCALE_16BIT;
+            Filter->FR1 = ((uint32)First->Id << CAN_FILTER_16BIT_STID_SHIFT) |
+                          ((((uint32)First->Mask << CAN_FILTER_16BIT_STID_SHIFT) |
+                            CAN_FILTER_16BIT_RTR | CAN_FILTER_16BIT_IDE) << 16U);
+            Filter->FR2 = ((uint32)Second->Id << CAN_FILTER_16BIT_STID_SHIFT) |
+                          ((((uint32)Second->Mask << CAN_FILTER_16BIT_STID_SHIFT) |
+                            CAN_FILTER_16BIT_RTR | CAN_FILTER_16BIT_IDE) << 16U);
+        }
+    }
+
+    return Bank;
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+Std_ReturnType Can_Filter_Compile(const Can_FilterIdType* IdList, uint16 IdCount,
+                                  const Can_FilterIdType* ExtraList, uint16 ExtraCount, uint8 BankCount,
+                                  Can_FilterBankType* BankPtr, Can_FilterReportType* ReportPtr)
+{
+    uint32 Wanted = 0U;
+    uint32 Accepted = 0U;
+    uint16 Index;
+    uint16 Start;
+    uint8 Group;
+    uint8 Bank;
+
+    if (((uint32)IdCount + ExtraCount > CAN_FILTER_MAX_IDS) ||
+        ((IdCount > 0U) && (IdList == NULL_PTR)) || ((ExtraCount > 0U) && (ExtraList == NULL_PTR)))
+    {
+        return E_NOT_OK;
+    }
+
+    /* Normalise the lists into the scratch area */
+    Can_FilterWorkCount = 0U;
+    if ((Can_Filter_AddIds(IdList, IdCount) == FALSE) || (Can_Filter_AddIds(ExtraList, ExtraCount) == FALSE))
+    {
+        return E_NOT_OK;
+    }
+
+    Can_Filter_RemoveCovered();
+    Can_Filter_Sort(FALSE);
+    Can_Filter_Count();
+
+    for (Index = 0U; Index < Can_FilterWorkCount; Index++)
+    {
+        Wanted = Can_Filter_SaturatedAdd(Wanted, Can_Filter_AcceptedCount(&Can_FilterWork[Index]));
+    }
+
+    /* Trade precision for banks until the list fits */
+    while (Can_Filter_TotalBanks() > BankCount)
+    {
+        if (Can_Filter_MergeBestPair() == FALSE)
+        {
+            return E_NOT_OK;
+        }
+    }
+
+    /* Exact entries first within each group for the list banks */
+    Can_Filter_Sort(TRUE);
+
+    Bank = 0U;
+    Start = 0U;
+    for (Group = 0U; Group < CAN_FILTER_GROUP_COUNT; Group++)
+    {
+        Bank = Can_Filter_EmitGroup(Group, Start, Bank, BankCount, BankPtr);
+        Start += Can_FilterExactCount[Group] + Can_FilterMaskCount[Group];
+    }
+    for (Index = 0U; Index < Bank; Index++)
+    {
+        BankPtr[Index].FilterNumber = (uint8)Index;
+    }
+
+    for (Index = 0U; Index < Can_FilterWorkCount; Index++)
+    {
+        Accepted = Can_Filter_SaturatedAdd(Accepted, Can_Filter_AcceptedCount(&Can_FilterWork[Index]));
+    }
+
+    ReportPtr->BanksUsed = Bank;
+    ReportPtr->BanksAvailable = BankCount;
+    ReportPtr->WantedIds = Wanted;
+    ReportPtr->AcceptedIds = Accepted;
+    ReportPtr->UnwantedIds = (Accepted > Wanted) ? (Accepted - Wanted) : 0U;
+
+    return E_OK;
+}
+
+Std_ReturnType Can_Filter_GetElement(const Can_FilterBankType* BankPtr, uint8 BankCount, uint8 Fifo,
+                                     uint8 FilterMatchIndex, Can_FilterIdType* ElementPtr)
+{
+    const Can_FilterBankType* Filter;
+    uint16 First = 0U;
+    uint16 Elements;
+    uint16 Element;
+    uint32 Slot;
+    uint8 Bank;
+
+    for (Bank = 0U; Bank < BankCount; Bank++)
+    {
+        Filter = &BankPtr[Bank];
+        if (Filter->Fifo != Fifo)
+        {
+            continue;
+        }
+
+        if (Filter->Scale == CAN_FILTER_SCALE_32BIT)
+        {
+            Elements = (Filter->Mode == CAN_FILTER_MODE_LIST) ? CAN_FILTER_EXT_PER_LIST_BANK : 1U;
+        }
+        else
+        {
+            Elements = (Filter->Mode == CAN_FILTER_MODE_LIST) ? CAN_FILTER_STD_PER_LIST_BANK : CAN_FILTER_STD_PER_MASK_BANK;
+        }
+
+        if (FilterMatchIndex >= (First + Elements))
+        {
+            First += Elements;
+            continue;
+        }
+
+        Element = FilterMatchIndex - First;
+        if (Filter->Scale == CAN_FILTER_SCALE_32BIT)
+        {
+            Slot = ((Filter->Mode == CAN_FILTER_MODE_LIST) && (Element == 1U)) ? Filter->FR2 : Filter->FR1;
+            ElementPtr->CanId = ((Slot >> CAN_FILTER_32BIT_EXID_SHIFT) & CAN_EXT_ID_MASK) | CAN_ID_EXTENDED_FLAG;
+            ElementPtr->Mask = (Filter->Mode == CAN_FILTER_MODE_LIST)
+                             ? CAN_EXT_ID_MASK
+                             : ((Filter->FR2 >> CAN_FILTER_32BIT_EXID_SHIFT) & CAN_EXT_ID_MASK);
+        }
+        else if (Filter->Mode == CAN_FILTER_MODE_LIST)
+        {
+            Slot = ((Element < 2U) ? Filter->FR1 : Filter->FR2) >> (((Element & 1U) != 0U) ? 16U : 0U);
+            ElementPtr->CanId = (Slot >> CAN_FILTER_16BIT_STID_SHIFT) & CAN_STD_ID_MASK;
+            ElementPtr->Mask = CAN_STD_ID_MASK;
+        }
+        else
+        {
+            Slot = (Element == 0U) ? Filter->FR1 : Filter->FR2;
+            ElementPtr->CanId = (Slot >> CAN_FILTER_16BIT_STID_SHIFT) & CAN_STD_ID_MASK;
+            ElementPtr->Mask = (Slot >> (16U + CAN_FILTER_16BIT_STID_SHIFT)) & CAN_STD_ID_MASK;
+        }
+
+        return E_OK;
+    }
+
+    return E_NOT_OK;
+}
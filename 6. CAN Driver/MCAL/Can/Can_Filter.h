@@ -0,0 +1,115 @@
+/****************************************************************************************
+*                               CAN_FILTER.H                                           *
+****************************************************************************************
+* File Name   : Can_Filter.h
+* Module      : Controller Area Network (CAN)
+* Description : bxCAN acceptance filter bank compiler
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+***************************************************************************************/
+#ifndef CAN_FILTER_H
+#define CAN_FILTER_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Std_Types.h"
+#include "Can_Types.h"
+#include "Can_Cfg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/**
+ * @brief   Filter Bank Mode
+ * @details Value of the bank bit in CAN_FM1R
+ */
+#define CAN_FILTER_MODE_MASK                (0U)    /**< Identifier mask mode */
+#define CAN_FILTER_MODE_LIST                (1U)    /**< Identifier list mode */
+
+/**
+ * @brief   Filter Bank Scale
+ * @details Value of the bank bit in CAN_FS1R
+ */
+#define CAN_FILTER_SCALE_16BIT              (0U)    /**< Two 16-bit filters per register */
+#define CAN_FILTER_SCALE_32BIT              (1U)    /**< One 32-bit filter per register */
+
+/*==================================================================================================
+*                                 STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/**
+ * @brief   Compiled Filter Bank Type
+ * @details Register image of one bxCAN filter bank. FilterNumber is relative to the first bank
+ *          handed to Can_Filter_Compile; the caller adds the bank offset of the controller.
+ */
+typedef struct
+{
+    uint32  FR1;                /**< CAN_FiR1 register value */
+    uint32  FR2;                /**< CAN_FiR2 register value */
+    uint8   FilterNumber;       /**< Bank index relative to the controller's first bank */
+    uint8   Fifo;               /**< FIFO assignment (CAN_FFA1R bit) */
+    uint8   Mode;               /**< CAN_FILTER_MODE_MASK / CAN_FILTER_MODE_LIST */
+    uint8   Scale;              /**< CAN_FILTER_SCALE_16BIT / CAN_FILTER_SCALE_32BIT */
+} Can_FilterBankType;
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief   Compile an identifier list into bxCAN filter banks
+ * @details Identifiers are grouped by FIFO and identifier type. Each group is packed into the
+ *          densest bank layout (16-bit list: 4 standard IDs, 16-bit mask: 2 standard ranges,
+ *          32-bit list: 2 extended IDs, 32-bit mask: 1 extended range). While the result needs
+ *          more banks than available, the two neighbouring entries whose merge into one mask
+ *          lets through the fewest additional identifiers are merged.
+ *
+ *          Only data frames pass the compiled filters. The function works on a static scratch
+ *          area and is not reentrant.
+ *
+ * @param[in]   IdList          Identifiers to accept
+ * @param[in]   IdCount         Number of entries in IdList
+ * @param[in]   ExtraList       Further identifiers to accept (gateway routes), may be NULL_PTR
+ * @param[in]   ExtraCount      Number of entries in ExtraList, IdCount + ExtraCount <= CAN_FILTER_MAX_IDS
+ * @param[in]   BankCount       Number of banks available
+ * @param[out]  BankPtr         Array of BankCount banks receiving the register images
+ * @param[out]  ReportPtr       Compilation report
+ *
+ * @return      E_OK            Banks and report written
+ *              E_NOT_OK        Invalid list or the list cannot be packed into BankCount banks
+ */
+Std_ReturnType Can_Filter_Compile(const Can_FilterIdType* IdList, uint16 IdCount,
+                                  const Can_FilterIdType* ExtraList, uint16 ExtraCount, uint8 BankCount,
+                                  Can_FilterBankType* BankPtr, Can_FilterReportType* ReportPtr);
+
+/**
+ * @brief   Decode the filter element behind a filter match index
+ * @details bxCAN numbers the elements of all banks assigned to a FIFO in bank order: a 32-bit
+ *          mask bank holds 1 element, 32-bit list and 16-bit mask banks 2, a 16-bit list bank 4.
+ *          The FMI of a received frame is that number.
+ *
+ * @param[in]   BankPtr         Compiled banks, ordered by FilterNumber
+ * @param[in]   BankCount       Number of compiled banks
+ * @param[in]   Fifo            FIFO the frame was received in (0 or 1)
+ * @param[in]   FilterMatchIndex FMI reported by the hardware
+ * @param[out]  ElementPtr      Identifier and mask of the element (Hrh is not written)
+ *
+ * @return      E_OK            Element found
+ *              E_NOT_OK        FMI beyond the compiled banks
+ */
+Std_ReturnType Can_Filter_GetElement(const Can_FilterBankType* BankPtr, uint8 BankCount, uint8 Fifo,
+                                     uint8 FilterMatchIndex, Can_FilterIdType* ElementPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAN_FILTER_H */
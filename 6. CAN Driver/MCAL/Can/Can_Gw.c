@@ -0,0 +1,154 @@
+/****************************************************************************************
+*                               CAN_GW.C                                               *
+****************************************************************************************
+* File Name   : Can_Gw.c
+* Module      : Controller Area Network (CAN)
+* Description : CAN-to-CAN gateway on the L-PDU callout
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+***************************************************************************************/
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Can_Gw.h"
+#include "Can.h"
+
+#if (CAN_GATEWAY_SUPPORT == STD_ON)
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/* Route indices grouped by source controller, in table order within a controller */
+static uint8 Can_GwRouteIndex[CAN_GW_ROUTE_COUNT];
+
+/* Acceptance filter entries of Can_GwRouteIndex, same order */
+static Can_FilterIdType Can_GwFilterId[CAN_GW_ROUTE_COUNT];
+
+/* First entry and number of entries of each controller in the two arrays above */
+static uint8 Can_GwFirst[CAN_MAX_CONTROLLERS];
+static uint8 Can_GwCount[CAN_MAX_CONTROLLERS];
+
+static Can_GwStatisticsType Can_GwStatistics[CAN_GW_ROUTE_COUNT];
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+boolean Can_Gw_IsConfigValid(void)
+{
+    const Can_GwRouteConfigType* Route;
+    uint8 Index;
+
+    for (Index = 0U; Index < CAN_GW_ROUTE_COUNT; Index++)
+    {
+        Route = &Can_GwRouteConfig[Index];
+        if ((Route->SrcController >= CAN_MAX_CONTROLLERS) ||
+            ((Route->SrcHrh != CAN_HRH_0) && (Route->SrcHrh != CAN_HRH_1)) ||
+            (Route->DstHth >= CAN_MAX_HTH_OBJECTS))
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+void Can_Gw_Init(void)
+{
+    const Can_GwRouteConfigType* Route;
+    uint8 Next[CAN_MAX_CONTROLLERS];
+    uint8 Controller;
+    uint8 First = 0U;
+    uint8 Index;
+    uint8 Slot;
+
+    for (Controller = 0U; Controller < CAN_MAX_CONTROLLERS; Controller++)
+    {
+        Can_GwCount[Controller] = 0U;
+    }
+    for (Index = 0U; Index < CAN_GW_ROUTE_COUNT; Index++)
+    {
+        Can_GwCount[Can_GwRouteConfig[Index].SrcController]++;
+    }
+    for (Controller = 0U; Controller < CAN_MAX_CONTROLLERS; Controller++)
+    {
+        Can_GwFirst[Controller] = First;
+        Next[Controller] = First;
+        First += Can_GwCount[Controller];
+    }
+
+    for (Index = 0U; Index < CAN_GW_ROUTE_COUNT; Index++)
+    {
+        Route = &Can_GwRouteConfig[Index];
+        Slot = Next[Route->SrcController]++;
+        Can_GwRouteIndex[Slot] = Index;
+        Can_GwFilterId[Slot].CanId = Route->SrcCanId;
+        Can_GwFilterId[Slot].Mask = Route->SrcMask;
+        Can_GwFilterId[Slot].Hrh = Route->SrcHrh;
+
+        Can_GwStatistics[Index].ForwardedCount = 0U;
+        Can_GwStatistics[Index].DroppedCount = 0U;
+    }
+}
+
+const Can_FilterIdType* Can_Gw_GetFilterIds(uint8 Controller, uint16* CountPtr)
+{
+    *CountPtr = Can_GwCount[Controller];
+
+    return &Can_GwFilterId[Can_GwFirst[Controller]];
+}
+
+boolean Can_Gw_LPduCallout(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr)
+{
+    const Can_GwRouteConfigType* Route;
+    Can_PduType Pdu;
+    boolean PassToUpperLayer = TRUE;
+    uint8 Slot;
+    uint8 Last;
+
+    Pdu.swPduHandle = CAN_GW_TX_PDU_HANDLE;
+    Pdu.length = (uint8)PduInfoPtr->SduLength;
+    Pdu.sdu = PduInfoPtr->SduDataPtr;
+
+    Last = Can_GwFirst[Mailbox->ControllerId] + Can_GwCount[Mailbox->ControllerId];
+    for (Slot = Can_GwFirst[Mailbox->ControllerId]; Slot < Last; Slot++)
+    {
+        /* The filter entry holds the source identifier and mask of the route; the identifier
+           type always has to match */
+        if (((Mailbox->CanId ^ Can_GwFilterId[Slot].CanId) & (Can_GwFilterId[Slot].Mask | CAN_ID_EXTENDED_FLAG)) != 0U)
+        {
+            continue;
+        }
+
+        Route = &Can_GwRouteConfig[Can_GwRouteIndex[Slot]];
+        Pdu.id = (Mailbox->CanId & ~Route->DstIdMask) | (Route->DstCanId & Route->DstIdMask);
+
+        /* Each identifier is received through one FIFO, so only one RX ISR counts for a route */
+        if (Can_Write(Route->DstHth, &Pdu) == E_OK)
+        {
+            Can_GwStatistics[Can_GwRouteIndex[Slot]].ForwardedCount++;
+        }
+        else
+        {
+            /* Silently lost: no DET report and no retry, the count is the only trace */
+            Can_GwStatistics[Can_GwRouteIndex[Slot]].DroppedCount++;
+        }
+
+        if (Route->PassToUpperLayer == FALSE)
+        {
+            PassToUpperLayer = FALSE;
+        }
+    }
+
+    return PassToUpperLayer;
+}
+
+void Can_Gw_GetStatistics(uint8 Route, Can_GwStatisticsType* StatisticsPtr)
+{
+    *StatisticsPtr = Can_GwStatistics[Route];
+}
+#endif
@@ -0,0 +1,92 @@
+/****************************************************************************************
+*                               CAN_GW.H                                               *
+****************************************************************************************
+* File Name   : Can_Gw.h
+* Module      : Controller Area Network (CAN)
+* Description : CAN-to-CAN gateway on the L-PDU callout
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+***************************************************************************************/
+#ifndef CAN_GW_H
+#define CAN_GW_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Std_Types.h"
+#include "Can_Types.h"
+#include "Can_Cfg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/**
+ * @brief   Gateway TX Handle
+ * @details swPduHandle of the frames written by the gateway. The driver gives no TX confirmation
+ *          to CanIf for it, the frame does not belong to a CanIf Tx PDU.
+ */
+#define CAN_GW_TX_PDU_HANDLE                ((PduIdType)0xFFFFU)
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief   Check the routing table
+ * @details Every route needs a source controller, a source HRH and an HTH that exist.
+ *
+ * @return      boolean         TRUE if Can_GwRouteConfig is consistent
+ */
+boolean Can_Gw_IsConfigValid(void);
+
+/**
+ * @brief   Index the routing table by source controller and clear the route counters
+ * @details Called once by Can_Init, before any frame is received.
+ */
+void Can_Gw_Init(void);
+
+/**
+ * @brief   Acceptance filter entries of the routes of a controller
+ * @details Can_SetRxFilter adds them to the identifiers of CanIf, so the source frames of the
+ *          routes pass the hardware filter.
+ *
+ * @param[in]   Controller      Controller ID
+ * @param[out]  CountPtr        Number of entries
+ *
+ * @return      const Can_FilterIdType*     First entry, valid for *CountPtr entries
+ */
+const Can_FilterIdType* Can_Gw_GetFilterIds(uint8 Controller, uint16* CountPtr);
+
+/**
+ * @brief   Forward a received frame along every matching route
+ * @details The L-PDU callout of the driver (CAN_LPDU_CALLOUT_NAME). Runs in the RX ISR of the
+ *          source controller and writes the frame with Can_Write, so a route adds one table scan
+ *          over the routes of the controller and one Can_Write to the reception.
+ *
+ * @param[in]   Mailbox         Received frame: identifier, HRH and controller
+ * @param[in]   PduInfoPtr      Received payload
+ *
+ * @return      boolean         FALSE if a route consumed the frame, TRUE to indicate it to CanIf
+ */
+boolean Can_Gw_LPduCallout(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr);
+
+/**
+ * @brief   Counters of one route
+ *
+ * @param[in]   Route           Index into Can_GwRouteConfig
+ * @param[out]  StatisticsPtr   Forwarded and dropped frames since Can_Init
+ */
+void Can_Gw_GetStatistics(uint8 Route, Can_GwStatisticsType* StatisticsPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAN_GW_H */
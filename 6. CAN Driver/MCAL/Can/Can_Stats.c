@@ -0,0 +1,424 @@
+/****************************************************************************************
+*                               CAN_STATS.C                                            *
+****************************************************************************************
+* File Name   : Can_Stats.c
+* Module      : Controller Area Network (CAN)
+* Description : On-wire frame length, bus-load and bus error statistics
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+***************************************************************************************/
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Can_Stats.h"
+#include "stm32f10x.h"
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/* CRC-15/CAN generator polynomial x^15 + x^14 + x^10 + x^8 + x^7 + x^4 + x^3 + 1 */
+#define CAN_STATS_CRC_POLYNOMIAL            (0x4599U)
+#define CAN_STATS_CRC_MASK                  (0x7FFFU)
+
+/* Stuffing state: value of the last bit on the wire and length of its run (1..4) */
+#define CAN_STATS_STUFF_STATE(Last, Run)    ((uint8)(((Last) << 2U) | ((Run) - 1U)))
+#define CAN_STATS_STUFF_STATES              (8U)
+
+/* The bus is recessive before SOF, so the SOF bit starts a new run */
+#define CAN_STATS_STUFF_STATE_IDLE          CAN_STATS_STUFF_STATE(1U, 1U)
+
+/* Longest stuffed region: extended frame with 8 data bytes */
+#define CAN_STATS_MAX_STUFFED_BITS          (54U + 64U)
+#define CAN_STATS_BIT_WORDS                 ((CAN_STATS_MAX_STUFFED_BITS + 31U) / 32U)
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/**
+ * @brief   Frame Bit String
+ * @details Unstuffed bits from SOF to the end of the CRC, first bit in the MSB of Word[0]. A
+ *          nibble never straddles two words.
+ */
+typedef struct
+{
+    uint32  Word[CAN_STATS_BIT_WORDS];      /**< Bits, MSB first */
+    uint8   Count;                          /**< Number of bits */
+} Can_StatsBitsType;
+
+/**
+ * @brief   Controller Statistics
+ * @details The bus-load window is a ring of the last CAN_STATISTICS_WINDOW_PERIODS periods with
+ *          running sums, so closing a period costs one subtraction per sum.
+ */
+typedef struct
+{
+    Can_StatisticsType Statistics;                          /**< Reported values */
+    uint32  WindowBits[CAN_STATISTICS_WINDOW_PERIODS];      /**< Bits counted per period */
+    uint32  WindowCycles[CAN_STATISTICS_WINDOW_PERIODS];    /**< Length of each period, core clock cycles */
+    uint32  WindowBitSum;                                   /**< Sum of WindowBits */
+    uint64  WindowCycleSum;                                 /**< Sum of WindowCycles */
+    uint64  LastSample;                                     /**< Can_Time_Now at the last period end */
+    uint32  PeriodBits;                                     /**< Bits counted in the running period */
+    uint32  BitCycles;                                      /**< Core clock cycles per CAN bit time */
+    uint8   Slot;                                           /**< Next window slot to overwrite */
+    boolean Sampled;                                        /**< LastSample is valid */
+} Can_StatsControllerType;
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+#if (CAN_STATISTICS_EXACT_STUFFING == STD_ON)
+/* CRC-15 of a 4-bit step: register update for each value of (top 4 register bits ^ input nibble) */
+static uint16 Can_StatsCrcTable[16];
+
+/* Stuffing of a 4-bit step: bits 0..2 next state, bits 4..7 stuff bits inserted */
+static uint8 Can_StatsStuffTable[CAN_STATS_STUFF_STATES][16];
+#endif
+
+static Can_StatsControllerType Can_Stats[CAN_MAX_CONTROLLERS];
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+
+#if (CAN_STATISTICS_EXACT_STUFFING == STD_ON)
+static inline uint16 Can_Stats_CrcBit(uint16 Crc, uint32 Bit)
+{
+    uint32 Feedback = Bit ^ ((uint32)Crc >> 14U);
+
+    Crc = (uint16)((Crc << 1U) & CAN_STATS_CRC_MASK);
+    if ((Feedback & 1U) != 0U)
+    {
+        Crc ^= CAN_STATS_CRC_POLYNOMIAL;
+    }
+
+    return Crc;
+}
+
+static inline uint8 Can_Stats_StuffBit(uint8 State, uint32 Bit, uint8* StuffPtr)
+{
+    uint8 Last = (uint8)(State >> 2U);
+
+    if (Bit != Last)
+    {
+        return CAN_STATS_STUFF_STATE(Bit, 1U);
+    }
+
+    if ((State & 3U) == 3U)
+    {
+        /* Fifth equal bit: the complement is inserted and starts the next run */
+        (*StuffPtr)++;
+        return CAN_STATS_STUFF_STATE(Last ^ 1U, 1U);
+    }
+
+    return (uint8)(State + 1U);
+}
+
+static inline uint32 Can_Stats_GetBit(const Can_StatsBitsType* Bits, uint8 Position)
+{
+    return (Bits->Word[Position >> 5U] >> (31U - (Position & 31U))) & 1U;
+}
+
+static inline uint32 Can_Stats_GetNibble(const Can_StatsBitsType* Bits, uint8 Position)
+{
+    return (Bits->Word[Position >> 5U] >> (28U - (Position & 31U))) & 0xFU;
+}
+
+/**
+ * @brief   Append the Count low bits of Value (Count <= 18), MSB first
+ */
+static void Can_Stats_Append(Can_StatsBitsType* Bits, uint32 Value, uint8 Count)
+{
+    uint8 Index = (uint8)(Bits->Count >> 5U);
+    uint8 Free = (uint8)(32U - (Bits->Count & 31U));
+
+    if (Count <= Free)
+    {
+        Bits->Word[Index] |= Value << (Free - Count);
+    }
+    else
+    {
+        Bits->Word[Index] |= Value >> (Count - Free);
+        Bits->Word[Index + 1U] |= Value << (32U - (Count - Free));
+    }
+
+    Bits->Count = (uint8)(Bits->Count + Count);
+}
+
+static uint16 Can_Stats_Crc(const Can_StatsBitsType* Bits)
+{
+    uint16 Crc = 0U;
+    uint8 Position;
+
+    for (Position = 0U; (uint8)(Position + 4U) <= Bits->Count; Position += 4U)
+    {
+        Crc = (uint16)(((Crc << 4U) & CAN_STATS_CRC_MASK) ^
+                       Can_StatsCrcTable[((Crc >> 11U) ^ Can_Stats_GetNibble(Bits, Position)) & 0xFU]);
+    }
+    for (; Position < Bits->Count; Position++)
+    {
+        Crc = Can_Stats_CrcBit(Crc, Can_Stats_GetBit(Bits, Position));
+    }
+
+    return Crc;
+}
+
+static uint8 Can_Stats_StuffCount(const Can_StatsBitsType* Bits)
+{
+    uint8 State = CAN_STATS_STUFF_STATE_IDLE;
+    uint8 Stuff = 0U;
+    uint8 Entry;
+    uint8 Position;
+
+    for (Position = 0U; (uint8)(Position + 4U) <= Bits->Count; Position += 4U)
+    {
+        Entry = Can_StatsStuffTable[State][Can_Stats_GetNibble(Bits, Position)];
+        Stuff = (uint8)(Stuff + (Entry >> 4U));
+        State = (uint8)(Entry & 0x07U);
+    }
+    for (; Position < Bits->Count; Position++)
+    {
+        State = Can_Stats_StuffBit(State, Can_Stats_GetBit(Bits, Position), &Stuff);
+    }
+
+    return Stuff;
+}
+#endif
+
+static uint16 Can_Stats_Load(uint32 Bits, uint64 Cycles, uint32 BitCycles)
+{
+    uint64 Load;
+
+    if (Cycles == 0U)
+    {
+        return 0U;
+    }
+
+    Load = ((uint64)Bits * BitCycles * 1000U) / Cycles;
+
+    return (Load > 0xFFFFU) ? (uint16)0xFFFFU : (uint16)Load;
+}
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+void Can_Stats_Init(void)
+{
+#if (CAN_STATISTICS_EXACT_STUFFING == STD_ON)
+    uint16 Crc;
+    uint8 State;
+    uint8 Next;
+    uint8 Stuff;
+    uint8 Index;
+    uint8 Bit;
+
+    for (Index = 0U; Index < 16U; Index++)
+    {
+        Crc = (uint16)((uint16)Index << 11U);
+        for (Bit = 0U; Bit < 4U; Bit++)
+        {
+            Crc = Can_Stats_CrcBit(Crc, 0U);
+        }
+        Can_StatsCrcTable[Index] = Crc;
+    }
+
+    for (State = 0U; State < CAN_STATS_STUFF_STATES; State++)
+    {
+        for (Index = 0U; Index < 16U; Index++)
+        {
+            Next = State;
+            Stuff = 0U;
+            for (Bit = 0U; Bit < 4U; Bit++)
+            {
+                Next = Can_Stats_StuffBit(Next, ((uint32)Index >> (3U - Bit)) & 1U, &Stuff);
+            }
+            Can_StatsStuffTable[State][Index] = (uint8)((Stuff << 4U) | Next);
+        }
+    }
+#endif
+}
+
+void Can_Stats_Reset(uint8 Controller)
+{
+    Can_StatsControllerType* Stats = &Can_Stats[Controller];
+    uint8 Index;
+
+    Stats->Statistics.TxFrameCount = 0U;
+    Stats->Statistics.RxFrameCount = 0U;
+    Stats->Statistics.TxBitCount = 0U;
+    Stats->Statistics.RxBitCount = 0U;
+    Stats->Statistics.LastLoad = 0U;
+    Stats->Statistics.WindowLoad = 0U;
+    Stats->Statistics.PeakWindowLoad = 0U;
+    Stats->Statistics.TxErrorCounter = 0U;
+    Stats->Statistics.RxErrorCounter = 0U;
+    Stats->Statistics.PeakTxErrorCounter = 0U;
+    Stats->Statistics.PeakRxErrorCounter = 0U;
+    for (Index = 0U; Index < CAN_LEC_COUNT; Index++)
+    {
+        Stats->Statistics.LecCount[Index] = 0U;
+    }
+
+    for (Index = 0U; Index < CAN_STATISTICS_WINDOW_PERIODS; Index++)
+    {
+        Stats->WindowBits[Index] = 0U;
+        Stats->WindowCycles[Index] = 0U;
+    }
+    Stats->WindowBitSum = 0U;
+    Stats->WindowCycleSum = 0U;
+    Stats->LastSample = 0U;
+    Stats->PeriodBits = 0U;
+    Stats->BitCycles = 0U;
+    Stats->Slot = 0U;
+    Stats->Sampled = FALSE;
+}
+
+void Can_Stats_SetBitTime(uint8 Controller, uint32 BitCycles)
+{
+    Can_Stats[Controller].BitCycles = BitCycles;
+}
+
+uint16 Can_Stats_FrameBits(Can_IdType CanId, uint8 Length, const uint8* DataPtr)
+{
+    boolean Extended = (boolean)((CanId & CAN_ID_EXTENDED_FLAG) != 0U);
+#if (CAN_STATISTICS_EXACT_STUFFING == STD_ON)
+    Can_StatsBitsType Bits = { { 0U }, 0U };
+    uint8 Index;
+
+    Can_Stats_Append(&Bits, 0U, 1U);                                /* SOF */
+    if (Extended == TRUE)
+    {
+        Can_Stats_Append(&Bits, (CanId >> 18U) & 0x7FFU, 11U);      /* Base identifier */
+        Can_Stats_Append(&Bits, 0x3U, 2U);                          /* SRR, IDE */
+        Can_Stats_Append(&Bits, CanId & 0x3FFFFU, 18U);             /* Identifier extension */
+        Can_Stats_Append(&Bits, 0U, 3U);                            /* RTR, r1, r0 */
+    }
+    else
+    {
+        Can_Stats_Append(&Bits, CanId & 0x7FFU, 11U);               /* Identifier */
+        Can_Stats_Append(&Bits, 0U, 3U);                            /* RTR, IDE, r0 */
+    }
+    Can_Stats_Append(&Bits, Length, 4U);                            /* DLC */
+    for (Index = 0U; Index < Length; Index++)
+    {
+        Can_Stats_Append(&Bits, DataPtr[Index], 8U);
+    }
+    Can_Stats_Append(&Bits, Can_Stats_Crc(&Bits), 15U);
+
+    return (uint16)(Bits.Count + Can_Stats_StuffCount(&Bits) + CAN_STATS_TAIL_BITS);
+#else
+    (void)DataPtr;
+
+    return CAN_STATS_WORST_CASE_BITS(Extended == TRUE, Length);
+#endif
+}
+
+void Can_Stats_CountTx(uint8 Controller, uint16 Bits)
+{
+    Can_StatsControllerType* Stats = &Can_Stats[Controller];
+    uint32 PriMask = __get_PRIMASK();
+
+    __disable_irq();
+    Stats->Statistics.TxFrameCount++;
+    Stats->Statistics.TxBitCount += Bits;
+    Stats->PeriodBits += Bits;
+    __set_PRIMASK(PriMask);
+}
+
+void Can_Stats_CountRx(uint8 Controller, uint16 Bits)
+{
+    Can_StatsControllerType* Stats = &Can_Stats[Controller];
+    uint32 PriMask = __get_PRIMASK();
+
+    __disable_irq();
+    Stats->Statistics.RxFrameCount++;
+    Stats->Statistics.RxBitCount += Bits;
+    Stats->PeriodBits += Bits;
+    __set_PRIMASK(PriMask);
+}
+
+void Can_Stats_CountLec(uint8 Controller, uint8 Lec)
+{
+    uint32 PriMask = __get_PRIMASK();
+
+    __disable_irq();
+    Can_Stats[Controller].Statistics.LecCount[Lec & (CAN_LEC_COUNT - 1U)]++;
+    __set_PRIMASK(PriMask);
+}
+
+void Can_Stats_Sample(uint8 Controller, uint64 Now, uint8 Tec, uint8 Rec)
+{
+    Can_StatsControllerType* Stats = &Can_Stats[Controller];
+    Can_StatisticsType* Statistics = &Stats->Statistics;
+    uint32 PriMask = __get_PRIMASK();
+    uint64 Elapsed;
+    uint32 Cycles;
+    uint32 Bits;
+    uint16 LastLoad;
+    uint16 WindowLoad;
+
+    __disable_irq();
+    Bits = Stats->PeriodBits;
+    Stats->PeriodBits = 0U;
+    __set_PRIMASK(PriMask);
+
+    if (Stats->Sampled == FALSE)
+    {
+        /* First period end after Can_Init: only anchors the period length */
+        Stats->Sampled = TRUE;
+        Stats->LastSample = Now;
+        Bits = 0U;
+        Cycles = 0U;
+    }
+    else
+    {
+        Elapsed = Now - Stats->LastSample;
+        Cycles = (Elapsed > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : (uint32)Elapsed;
+        Stats->LastSample = Now;
+    }
+
+    Stats->WindowBitSum = Stats->WindowBitSum - Stats->WindowBits[Stats->Slot] + Bits;
+    Stats->WindowCycleSum = Stats->WindowCycleSum - Stats->WindowCycles[Stats->Slot] + Cycles;
+    Stats->WindowBits[Stats->Slot] = Bits;
+    Stats->WindowCycles[Stats->Slot] = Cycles;
+    Stats->Slot = (uint8)((Stats->Slot + 1U) % CAN_STATISTICS_WINDOW_PERIODS);
+
+    /* 64-bit divisions outside the critical section */
+    LastLoad = Can_Stats_Load(Bits, Cycles, Stats->BitCycles);
+    WindowLoad = Can_Stats_Load(Stats->WindowBitSum, Stats->WindowCycleSum, Stats->BitCycles);
+
+    __disable_irq();
+    Statistics->LastLoad = LastLoad;
+    Statistics->WindowLoad = WindowLoad;
+    if (WindowLoad > Statistics->PeakWindowLoad)
+    {
+        Statistics->PeakWindowLoad = WindowLoad;
+    }
+    Statistics->TxErrorCounter = Tec;
+    Statistics->RxErrorCounter = Rec;
+    if (Tec > Statistics->PeakTxErrorCounter)
+    {
+        Statistics->PeakTxErrorCounter = Tec;
+    }
+    if (Rec > Statistics->PeakRxErrorCounter)
+    {
+        Statistics->PeakRxErrorCounter = Rec;
+    }
+    __set_PRIMASK(PriMask);
+}
+
+void Can_Stats_Get(uint8 Controller, Can_StatisticsType* StatisticsPtr)
+{
+    uint32 PriMask = __get_PRIMASK();
+
+    __disable_irq();
+    *StatisticsPtr = Can_Stats[Controller].Statistics;
+    __set_PRIMASK(PriMask);
+}
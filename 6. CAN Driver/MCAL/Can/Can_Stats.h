@@ -0,0 +1,126 @@
+/****************************************************************************************
+*                               CAN_STATS.H                                            *
+****************************************************************************************
+* File Name   : Can_Stats.h
+* Module      : Controller Area Network (CAN)
+* Description : On-wire frame length, bus-load and bus error statistics
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+***************************************************************************************/
+#ifndef CAN_STATS_H
+#define CAN_STATS_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Std_Types.h"
+#include "Can_Types.h"
+#include "Can_Cfg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/**
+ * @brief   Fixed Frame Tail
+ * @details Bits after the CRC sequence that are never stuffed: CRC delimiter, ACK slot, ACK
+ *          delimiter, 7 EOF bits and the 3-bit intermission
+ */
+#define CAN_STATS_TAIL_BITS                 (13U)
+
+/**
+ * @brief   Worst-case Frame Length
+ * @details Stuffed region (SOF to the end of the CRC) is 34 + 8n bits for a standard and 54 + 8n
+ *          bits for an extended data frame; at most one stuff bit follows every four bits of it.
+ */
+#define CAN_STATS_STUFFED_BITS(Extended, Length) \
+    ((uint16)(((Extended) ? 54U : 34U) + (8U * (uint16)(Length))))
+#define CAN_STATS_WORST_CASE_BITS(Extended, Length) \
+    ((uint16)(CAN_STATS_STUFFED_BITS((Extended), (Length)) + \
+              ((CAN_STATS_STUFFED_BITS((Extended), (Length)) - 1U) / 4U) + CAN_STATS_TAIL_BITS))
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief   Build the lookup tables
+ * @details Called once by Can_Init before any frame is counted.
+ */
+void Can_Stats_Init(void);
+
+/**
+ * @brief   Clear the statistics of a controller
+ */
+void Can_Stats_Reset(uint8 Controller);
+
+/**
+ * @brief   Set the bit time used to turn bit counts into a load
+ * @details Called whenever the controller leaves initialization mode, the baudrate may have
+ *          changed since the last start.
+ *
+ * @param[in]   Controller      Controller ID
+ * @param[in]   BitCycles       Core clock cycles per CAN bit time
+ */
+void Can_Stats_SetBitTime(uint8 Controller, uint32 BitCycles);
+
+/**
+ * @brief   On-wire length of a data frame
+ * @details Bits from SOF to the end of the intermission. The stuff bits are counted exactly: the
+ *          frame is assembled bit by bit, its CRC-15 computed and the stuffed region scanned four
+ *          bits at a time.
+ *
+ * @param[in]   CanId           Identifier, CAN_ID_EXTENDED_FLAG set for 29-bit IDs
+ * @param[in]   Length          Data length (0..8)
+ * @param[in]   DataPtr         Payload
+ *
+ * @return      uint16          Frame length in bits
+ */
+uint16 Can_Stats_FrameBits(Can_IdType CanId, uint8 Length, const uint8* DataPtr);
+
+/**
+ * @brief   Count a transmitted frame
+ */
+void Can_Stats_CountTx(uint8 Controller, uint16 Bits);
+
+/**
+ * @brief   Count a received frame
+ */
+void Can_Stats_CountRx(uint8 Controller, uint16 Bits);
+
+/**
+ * @brief   Count a bus error
+ *
+ * @param[in]   Controller      Controller ID
+ * @param[in]   Lec             CAN_LEC_xxx code read from CAN_ESR
+ */
+void Can_Stats_CountLec(uint8 Controller, uint8 Lec);
+
+/**
+ * @brief   Close one period of the bus-load window
+ * @details Called once per Can_MainFunction_Read period. The load of a period is the bits
+ *          counted in it times the bit time, divided by the time since the previous call.
+ *
+ * @param[in]   Controller      Controller ID
+ * @param[in]   Now             Can_Time_Now at the end of the period
+ * @param[in]   Tec             Transmit error counter
+ * @param[in]   Rec             Receive error counter
+ */
+void Can_Stats_Sample(uint8 Controller, uint64 Now, uint8 Tec, uint8 Rec);
+
+/**
+ * @brief   Consistent copy of the statistics of a controller
+ */
+void Can_Stats_Get(uint8 Controller, Can_StatisticsType* StatisticsPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAN_STATS_H */
@@ -0,0 +1,134 @@
+/****************************************************************************************
+*                               CAN_TIME.C                                             *
+****************************************************************************************
+* File Name   : Can_Time.c
+* Module      : Controller Area Network (CAN)
+* Description : Time base and bxCAN TTCM frame time stamp extension
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+***************************************************************************************/
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Can_Time.h"
+#include "stm32f10x.h"
+
+/*==================================================================================================
+*                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
+==================================================================================================*/
+
+/**
+ * @brief   TTCM Counter Anchor
+ * @details One point of the line that maps the TTCM bit counter of a controller onto the time
+ *          base: counter value Counter was reached at Time. The slope is BitCycles.
+ */
+typedef struct
+{
+    uint64  Time;               /**< Time base value of the anchor, core clock cycles */
+    uint32  BitCycles;          /**< Core clock cycles per CAN bit time */
+    uint16  Counter;            /**< TTCM counter value of the anchor */
+    boolean Valid;              /**< An anchor has been learned since Can_Time_Reset */
+} Can_TimeAnchorType;
+
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+
+/* Software extension of DWT_CYCCNT */
+static uint32 Can_TimeHigh = 0U;
+static uint32 Can_TimeLast = 0U;
+
+static Can_TimeAnchorType Can_TimeAnchor[CAN_MAX_CONTROLLERS];
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+
+void Can_Time_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    Can_TimeHigh = 0U;
+    Can_TimeLast = DWT->CYCCNT;
+}
+
+uint64 Can_Time_Now(void)
+{
+    uint32 PriMask = __get_PRIMASK();
+    uint32 Cycles;
+    uint64 Now;
+
+    __disable_irq();
+    Cycles = DWT->CYCCNT;
+    if (Cycles < Can_TimeLast)
+    {
+        Can_TimeHigh++;
+    }
+    Can_TimeLast = Cycles;
+    Now = ((uint64)Can_TimeHigh << 32U) | Cycles;
+    __set_PRIMASK(PriMask);
+
+    return Now;
+}
+
+void Can_Time_Reset(uint8 Controller, uint32 BitCycles)
+{
+    Can_TimeAnchor[Controller].Time = 0U;
+    Can_TimeAnchor[Controller].BitCycles = BitCycles;
+    Can_TimeAnchor[Controller].Counter = 0U;
+    Can_TimeAnchor[Controller].Valid = FALSE;
+}
+
+uint64 Can_Time_FromFrame(uint8 Controller, uint16 SofTime, uint16 FrameBits, uint64 Now)
+{
+    Can_TimeAnchorType* Anchor = &Can_TimeAnchor[Controller];
+    uint16 EndCounter = (uint16)(SofTime + FrameBits);
+    uint64 Elapsed;
+    uint64 Bits;
+    uint64 EndTime;
+    uint16 Predicted;
+    sint16 Ahead;
+
+    if (Anchor->Valid == FALSE)
+    {
+        Anchor->Valid = TRUE;
+        EndTime = Now;
+    }
+    else
+    {
+        /* Counter value the anchor predicts for Now; 32-bit division while the anchor is recent */
+        Elapsed = Now - Anchor->Time;
+        Bits = (Elapsed <= 0xFFFFFFFFULL) ? (uint64)((uint32)Elapsed / Anchor->BitCycles)
+                                         : (Elapsed / Anchor->BitCycles);
+        Predicted = (uint16)(Anchor->Counter + (uint16)Bits);
+
+        Ahead = (sint16)(uint16)(EndCounter - Predicted);
+        if (Ahead > 0)
+        {
+            /* The frame has ended by Now, the anchor was late: tighten it */
+            EndTime = Now;
+        }
+        else
+        {
+            EndTime = Anchor->Time + ((Bits - (uint64)(uint16)(-Ahead)) * Anchor->BitCycles);
+        }
+    }
+
+    /* Move the anchor along the same line to keep the elapsed time short */
+    Anchor->Counter = EndCounter;
+    Anchor->Time = EndTime;
+
+    return EndTime - ((uint64)FrameBits * Anchor->BitCycles);
+}
+
+void Can_Time_ToTimeStamp(uint64 Cycles, Can_TimeStampType* TimeStampPtr)
+{
+    uint32 Remainder = (uint32)(Cycles % SystemCoreClock);
+
+    TimeStampPtr->seconds = (uint32)(Cycles / SystemCoreClock);
+    TimeStampPtr->nanoseconds = (uint32)(((uint64)Remainder * 1000000000ULL) / SystemCoreClock);
+}
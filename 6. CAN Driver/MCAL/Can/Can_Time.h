@@ -0,0 +1,115 @@
+/****************************************************************************************
+*                               CAN_TIME.H                                             *
+****************************************************************************************
+* File Name   : Can_Time.h
+* Module      : Controller Area Network (CAN)
+* Description : Time base and bxCAN TTCM frame time stamp extension
+* Version     : 1.0.0
+* Date        : 16/10/2026
+* Author      : hoangphuc540202@gmail.com
+* Github      : https://github.com/HoangPhuc02
+***************************************************************************************/
+#ifndef CAN_TIME_H
+#define CAN_TIME_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Std_Types.h"
+#include "Can_Types.h"
+#include "Can_Cfg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+
+/**
+ * @brief   Hardware Frame Time Stamps
+ * @details TTCM is enabled and frames carry the 16-bit SOF time stamp when ingress or egress
+ *          time stamps are configured
+ */
+#if ((CAN_GET_EGRESS_TIME_STAMP_API == STD_ON) || (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON))
+#define CAN_HW_TIME_STAMP                   STD_ON
+#else
+#define CAN_HW_TIME_STAMP                   STD_OFF
+#endif
+
+/**
+ * @brief   Time Base
+ * @details The DWT time base runs when the current time, frame time stamps or the bus-load
+ *          statistics are configured
+ */
+#if ((CAN_GET_CURRENT_TIME_API == STD_ON) || (CAN_HW_TIME_STAMP == STD_ON) || (CAN_STATISTICS_API == STD_ON))
+#define CAN_TIME_BASE                       STD_ON
+#else
+#define CAN_TIME_BASE                       STD_OFF
+#endif
+
+/**
+ * @brief   Nominal Frame Length
+ * @details Bits from SOF to the end of EOF of a data frame without stuff bits. Stuff bits only
+ *          make the frame longer, so the end of frame estimated with this value is never late.
+ */
+#define CAN_TIME_FRAME_BITS(Extended, Length) \
+    ((uint16)(((Extended) ? 64U : 44U) + (8U * (uint16)(Length))))
+
+/*==================================================================================================
+*                                     FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/**
+ * @brief   Start the time base
+ * @details Enables the DWT cycle counter. The 32-bit counter is extended to 64 bits in
+ *          software, so Can_Time_Now must be called at least once per counter wrap (2^32 core
+ *          clock cycles, 59 s at 72 MHz); Can_MainFunction_Read does so.
+ */
+void Can_Time_Init(void);
+
+/**
+ * @brief   Current time in core clock cycles since Can_Time_Init
+ */
+uint64 Can_Time_Now(void);
+
+/**
+ * @brief   Restart the frame time stamp extension of a controller
+ * @details Called whenever the controller leaves initialization mode. The TTCM counter counts
+ *          CAN bit times; BitCycles is the length of one bit time in core clock cycles, which is
+ *          exact because the CAN kernel and the core run from the same clock tree.
+ *
+ * @param[in]   Controller      Controller ID
+ * @param[in]   BitCycles       Core clock cycles per CAN bit time
+ */
+void Can_Time_Reset(uint8 Controller, uint32 BitCycles);
+
+/**
+ * @brief   Extend a 16-bit TTCM SOF time stamp to the time base
+ * @details The offset between the TTCM counter and the time base is learned from the frames
+ *          themselves: a frame that is processed at Now ended no later than Now. The offset is
+ *          kept at the tightest bound seen so far (minimum latency filter), so its error is the
+ *          shortest observed delay between end of frame and processing plus the stuff bits of
+ *          that frame. The frame must be processed within 32768 bit times of its SOF, and Now
+ *          must not go backwards between calls for the same controller.
+ *
+ * @param[in]   Controller      Controller ID
+ * @param[in]   SofTime         TIME field of CAN_RDTxR / CAN_TDTxR
+ * @param[in]   FrameBits       CAN_TIME_FRAME_BITS of the frame
+ * @param[in]   Now             Can_Time_Now sampled while processing the frame
+ *
+ * @return      uint64          Time of the SOF in core clock cycles
+ */
+uint64 Can_Time_FromFrame(uint8 Controller, uint16 SofTime, uint16 FrameBits, uint64 Now);
+
+/**
+ * @brief   Convert core clock cycles into a Can_TimeStampType
+ */
+void Can_Time_ToTimeStamp(uint64 Cycles, Can_TimeStampType* TimeStampPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAN_TIME_H */
@@ -166,6 +166,25 @@ typedef uint16 Can_HwHandleType;
  */
 typedef uint16 PduIdType;
 
+/**
+ * @brief   PDU Length Type
+ * @details Type used to store the length of a PDU in bytes.
+ * @note    Available via ComStack_Types.h
+ */
+typedef uint16 PduLengthType;
+
+/**
+ * @brief   PDU Info Type
+ * @details Basic information about a PDU of any type: pointer to the payload and its length.
+ * @note    Available via ComStack_Types.h
+ */
+typedef struct _PduInfoType
+{
+    uint8*          SduDataPtr;     /**< Pointer to the SDU (payload) of the PDU */
+    uint8*          MetaDataPtr;    /**< Pointer to the meta data of the PDU */
+    PduLengthType   SduLength;      /**< Length of the SDU in bytes */
+} PduInfoType;
+
 /**
  * @brief   CAN PDU Type
  * @details This type unites PduId (swPduHandle), SduLength (length), SduData (sdu), and CanId (id) for any CAN L-SDU.
@@ -192,6 +211,7 @@ typedef struct _Can_HwType
     Can_IdType          CanId;         /**< Standard/Extended CAN ID of CAN L-PDU */
     Can_HwHandleType    Hoh;           /**< ID of the corresponding Hardware Object Range */
     uint8               ControllerId;   /**< Controller Id provided by CanIf clearly identify the corresponding controller */
+    uint8               FilterMatchIndex; /**< Vendor specific: bxCAN filter match index (FMI) of the received frame */
 } Can_HwType;
 
 /**
@@ -225,6 +245,157 @@ typedef struct _Can_ConfigType
     /* Note: Additional members will be added based on specific hardware requirements */
 } Can_ConfigType;
 
+/**
+ * @brief   CAN Rx Filter Identifier Type
+ * @details One identifier (or identifier range) that shall pass the hardware acceptance filter of a
+ *          controller. CanId carries CAN_ID_EXTENDED_FLAG for 29-bit identifiers; Mask selects the
+ *          identifier bits that must match (CAN_STD_ID_MASK / CAN_EXT_ID_MASK for a single identifier).
+ * @note    Vendor specific, used by Can_SetRxFilter
+ */
+typedef struct _Can_FilterIdType
+{
+    Can_IdType          CanId;          /**< Standard/Extended CAN ID incl. CAN_ID_EXTENDED_FLAG */
+    Can_IdType          Mask;           /**< Acceptance mask, 1 = bit must match */
+    Can_HwHandleType    Hrh;            /**< Receive object (CAN_HRH_0 = FIFO 0, CAN_HRH_1 = FIFO 1) */
+} Can_FilterIdType;
+
+/**
+ * @brief   CAN Rx Filter Report Type
+ * @details Result of the last filter bank compilation of a controller. UnwantedIds is the number of
+ *          identifiers that pass the hardware filter although no entry of the ID list requested them
+ *          and therefore have to be discarded by software filtering.
+ * @note    Vendor specific, returned by Can_GetRxFilterReport
+ */
+typedef struct _Can_FilterReportType
+{
+    uint8               BanksUsed;      /**< Number of filter banks programmed */
+    uint8               BanksAvailable; /**< Number of filter banks owned by the controller */
+    uint32              WantedIds;      /**< Identifiers requested by the ID list */
+    uint32              AcceptedIds;    /**< Identifiers accepted by the programmed banks */
+    uint32              UnwantedIds;    /**< AcceptedIds - WantedIds */
+} Can_FilterReportType;
+
+/**
+ * @brief   CAN Rx Processing Mode
+ * @details Current reception mode of a controller when CAN_RX_PROCESSING is ADAPTIVE
+ */
+#define CAN_RX_MODE_INTERRUPT   (0U)    /**< One interrupt per received frame */
+#define CAN_RX_MODE_POLLING     (1U)    /**< Drained by Can_MainFunction_Read and the FIFO full interrupt */
+
+/**
+ * @brief   CAN Rx Mode Statistics Type
+ * @details Mode switch counters of the adaptive reception. Load values are frames per
+ *          Can_MainFunction_Read period.
+ * @note    Vendor specific, returned by Can_GetRxModeStatistics
+ */
+typedef struct _Can_RxModeStatisticsType
+{
+    uint8               Mode;                   /**< CAN_RX_MODE_INTERRUPT / CAN_RX_MODE_POLLING */
+    uint32              SwitchToPollingCount;   /**< Interrupt -> polling transitions */
+    uint32              SwitchToInterruptCount; /**< Polling -> interrupt transitions */
+    uint32              LastLoad;               /**< Frames queued in the last period */
+    uint32              PeakLoad;               /**< Highest load since Can_Init */
+} Can_RxModeStatisticsType;
+
+/**
+ * @brief   CAN Rx Lane Statistics Type
+ * @details Counters of the RX queue behind one HRH (hardware FIFO) of a controller since
+ *          Can_Init. Every frame the FIFO delivered is either received or counted as a queue
+ *          overrun; FifoOverrunCount counts the FOVx events, each one losing at least one frame
+ *          in hardware.
+ * @note    Vendor specific, returned by Can_GetRxLaneStatistics
+ */
+typedef struct _Can_RxLaneStatisticsType
+{
+    uint32              ReceivedCount;          /**< Frames queued for CanIf */
+    uint32              QueueOverrunCount;      /**< Frames dropped because the queue was full */
+    uint32              FifoOverrunCount;       /**< Hardware FIFO overruns (FOV0 / FOV1) */
+    uint32              MaxFill;                /**< Highest queue fill level */
+} Can_RxLaneStatisticsType;
+
+/**
+ * @brief   CAN Gateway Statistics Type
+ * @details Frames of one gateway route since Can_Init.
+ * @note    Vendor specific, returned by Can_GetGatewayStatistics
+ */
+typedef struct _Can_GwStatisticsType
+{
+    uint32              ForwardedCount;         /**< Frames accepted by Can_Write on the destination HTH */
+    uint32              DroppedCount;           /**< Frames refused: destination stopped or its TX buffer full */
+} Can_GwStatisticsType;
+
+/**
+ * @brief   CAN Bus-off Statistics Type
+ * @details Bus-off events and recoveries of a controller. Durations are in
+ *          Can_MainFunction_BusOff periods, from the period the bus-off was handled in to the
+ *          period the controller was back on the bus.
+ * @note    Vendor specific, returned by Can_GetBusOffStatistics
+ */
+typedef struct _Can_BusOffStatisticsType
+{
+    uint32              BusOffCount;            /**< Bus-off events since Can_Init */
+    uint32              RecoveryCount;          /**< Completed recoveries */
+    uint32              SlowRetryCount;         /**< Restarts delayed by CAN_BUSOFF_SLOW_DELAY */
+    uint32              LastRecoveryPeriods;    /**< Duration of the last recovery */
+    uint32              MaxRecoveryPeriods;     /**< Longest recovery since Can_Init */
+    uint8               EpisodeBusOffCount;     /**< Bus-off events of the current episode */
+} Can_BusOffStatisticsType;
+
+/**
+ * @brief   CAN Last Error Codes
+ * @details LEC field of CAN_ESR, index into Can_StatisticsType.LecCount
+ */
+#define CAN_LEC_NONE            (0U)    /**< No error */
+#define CAN_LEC_STUFF           (1U)    /**< Stuff error */
+#define CAN_LEC_FORM            (2U)    /**< Form error */
+#define CAN_LEC_ACK             (3U)    /**< Acknowledgment error */
+#define CAN_LEC_BIT_RECESSIVE   (4U)    /**< Bit recessive error */
+#define CAN_LEC_BIT_DOMINANT    (5U)    /**< Bit dominant error */
+#define CAN_LEC_CRC             (6U)    /**< CRC error */
+#define CAN_LEC_COUNT           (8U)    /**< LEC values, 7 is reserved for software */
+
+/**
+ * @brief   CAN Statistics Type
+ * @details Frame and bus-load statistics of a controller. Bit counts are on-wire lengths from
+ *          SOF to the end of the intermission, stuff bits included. Loads are in permille of the
+ *          bus capacity and count the frames this controller sent or accepted.
+ * @note    Vendor specific, returned by Can_GetStatistics
+ */
+typedef struct _Can_StatisticsType
+{
+    uint32              TxFrameCount;           /**< Frames transmitted since Can_Init */
+    uint32              RxFrameCount;           /**< Frames received since Can_Init */
+    uint64              TxBitCount;             /**< Bits of the transmitted frames */
+    uint64              RxBitCount;             /**< Bits of the received frames */
+    uint16              LastLoad;               /**< Load of the last Can_MainFunction_Read period */
+    uint16              WindowLoad;             /**< Load over the last CAN_STATISTICS_WINDOW_PERIODS */
+    uint16              PeakWindowLoad;         /**< Highest WindowLoad since Can_Init */
+    uint8               TxErrorCounter;         /**< TEC at the last period */
+    uint8               RxErrorCounter;         /**< REC at the last period */
+    uint8               PeakTxErrorCounter;     /**< Highest TEC sampled since Can_Init */
+    uint8               PeakRxErrorCounter;     /**< Highest REC sampled since Can_Init */
+    uint32              LecCount[CAN_LEC_COUNT]; /**< Bus errors per CAN_LEC_xxx code */
+} Can_StatisticsType;
+
+/**
+ * @brief   CAN Time-triggered Schedule Status Type
+ * @details Slots and cycles of the time-triggered transmit schedule. The release delay is the
+ *          time from the slot instant to the transmit request, i.e. the transmit jitter caused
+ *          by the driver; arbitration delays on the bus come on top.
+ * @note    Vendor specific, returned by Can_GetScheduleStatus
+ */
+typedef struct _Can_ScheduleStatusType
+{
+    boolean             Synchronised;           /**< The cycle start follows a reference message */
+    uint32              CycleCount;             /**< Communication cycles since the controller started */
+    uint32              SyncCount;              /**< Reference messages received */
+    uint32              ReleasedCount;          /**< Slots that loaded a frame into the mailbox */
+    uint32              EmptyCount;             /**< Slots without a frame waiting on the HTH */
+    uint32              MissedCount;            /**< Slots whose mailbox still held the previous frame */
+    uint32              LateCount;              /**< Slots skipped beyond CAN_TT_RELEASE_WINDOW_US */
+    uint32              MaxReleaseDelay;        /**< Longest release delay, nanoseconds */
+} Can_ScheduleStatusType;
+
 
 
 
@@ -278,6 +449,30 @@ typedef struct _Can_ConfigType
  */
 #define CAN_FRAME_TYPE_MASK         ((Can_IdType)0xC0000000U)
 
+/**
+ * @brief   CAN Extended Frame Flag
+ * @details Most significant bit of Can_IdType, set for frames with a 29-bit identifier
+ */
+#define CAN_ID_EXTENDED_FLAG        ((Can_IdType)0x80000000U)
+
+/**
+ * @brief   TX Arbitration Priority Key
+ * @details Orders identifiers the way the bus arbitrates data frames: base identifier first, then
+ *          the IDE bit (a standard frame wins against an extended frame with the same base
+ *          identifier), then the 18 identifier extension bits. Lower key means higher priority.
+ *          Used by the driver and by CanIf to sort their TX buffers.
+ */
+#define CAN_TX_PRIORITY(canId) \
+    ((((canId) & CAN_ID_EXTENDED_FLAG) != 0U) ? \
+     (((((canId) & CAN_EXT_ID_MASK) >> 18U) << 19U) | 0x00040000UL | ((canId) & 0x0003FFFFUL)) : \
+     (((canId) & CAN_STD_ID_MASK) << 19U))
+
+/**
+ * @brief   Invalid Filter Match Index
+ * @details Can_HwType.FilterMatchIndex value when no filter element is known
+ */
+#define CAN_FILTER_MATCH_INDEX_INVALID  ((uint8)0xFFU)
+
 /* CAN Constants */
 #define CAN_MAX_HW_UNITS            (2U)        /**< Maximum number of CAN hardware units */
 #define CAN_MAX_HW_BAUD_RATES       (1000000U)  /**< Maximum CAN hardware baud rates 1Mbps */
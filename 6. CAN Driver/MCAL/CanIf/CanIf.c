@@ -58,6 +58,82 @@
 *                          LOCAL TYPEDEFS (STRUCTURES, UNIONS, ENUMS)
 ==================================================================================================*/
 
+#if (CANIF_PRIVATE_SOFTWARE_FILTER == STD_ON)
+/* Slot of the software filter hash table */
+typedef struct
+{
+    Can_IdType CanId;                   /* CAN ID incl. CAN_ID_EXTENDED_FLAG */
+    PduIdType RxPduId;                  /* CANIF_INVALID_PDU_ID marks a free slot */
+    uint8 ControllerId;                 /* Controller the Rx PDU is received on */
+} CanIf_RxHashEntryType;
+#endif
+
+#if (CANIF_TX_BUFFERING == STD_ON)
+/* Tx L-PDU held back while the CAN driver returns CAN_BUSY */
+typedef struct
+{
+    uint32 Priority;                    /* CAN_TX_PRIORITY of CanId, lower wins */
+    Can_IdType CanId;                   /* CAN ID passed to Can_Write */
+    PduIdType TxPduId;                  /* L-PDU, swPduHandle of the frame */
+    uint8 Length;                       /* Payload length */
+    uint8 Data[CANIF_MAX_PDU_LENGTH];   /* Payload copied from the request */
+} CanIf_TxBufferEntryType;
+#endif
+
+#if (CANIF_READ_RX_PDU_DATA_API == STD_ON)
+/* Last received L-SDU of an Rx PDU, published for CanIf_ReadRxPduData. Slot (Sequence & 1U)
+   holds the current data; the writer fills the other slot and then increments Sequence. */
+typedef struct
+{
+    uint8 Data[2][CANIF_MAX_PDU_LENGTH]; /* Two slots, written alternately */
+    PduLengthType Length[2];            /* Length of each slot */
+    volatile uint32 Sequence;           /* Number of receptions published */
+} CanIf_RxBufferType;
+#endif
+
+#if (CANIF_RX_DEFERRED_SUPPORT == STD_ON)
+/* Rx indication held back for CanIf_MainFunction */
+typedef struct
+{
+    PduIdType RxPduId;                  /* Rx PDU to indicate */
+    uint8 ControllerId;                 /* Controller the frame was received on */
+    uint8 Length;                       /* Payload length */
+    uint8 Data[CANIF_MAX_PDU_LENGTH];   /* Payload copied in the reception context */
+} CanIf_RxDeferredEntryType;
+#endif
+
+#if (CANIF_STATISTICS_API == STD_ON)
+/* Counters of a Tx PDU */
+typedef struct
+{
+    uint32 RequestCount;                /* Requests accepted */
+    uint32 ConfirmationCount;           /* Tx confirmations */
+    uint32 OfflineDropCount;            /* Requests refused, Tx path offline */
+    uint32 BufferFullDropCount;         /* Requests refused, no room in the driver or CanIf buffer */
+    uint32 RejectedCount;               /* Requests refused by the driver for any other reason */
+    uint32 NoDataDropCount;             /* Trigger transmit requests dropped, no data from the UL */
+    uint32 LatencyMax;                  /* Longest request-to-confirmation time, cycles */
+    uint32 Latency[CANIF_STATISTICS_LATENCY_BUCKETS]; /* log2 histogram of the same */
+    uint32 RequestTime;                 /* DWT_CYCCNT of the oldest unconfirmed request */
+    uint16 Outstanding;                 /* Accepted requests not yet confirmed, cancelled or dropped */
+    boolean Timing;                     /* RequestTime is valid */
+} CanIf_TxPduStatisticsType;
+
+/* Counters of an Rx PDU */
+typedef struct
+{
+    uint32 IndicationCount;             /* Frames received */
+    uint32 QueueFullDropCount;          /* Indications lost to a full deferred queue */
+} CanIf_RxPduStatisticsType;
+
+/* Rx frames of a controller that reached no Rx PDU */
+typedef struct
+{
+    uint32 OfflineDropCount;            /* Received while the Rx path was offline */
+    uint32 UnknownIdCount;              /* CAN ID of no Rx PDU */
+} CanIf_CtrlStatisticsType;
+#endif
+
 /*==================================================================================================
 *                                       LOCAL MACROS
 ==================================================================================================*/
@@ -66,12 +142,54 @@
 #define CANIF_UNINIT            (0U)
 #define CANIF_INIT              (1U)
 
-/* Invalid PDU ID */
-#define CANIF_INVALID_PDU_ID    (0xFFFFU)
-
 /* Maximum DLC */
 #define CANIF_MAX_DLC           (8U)
 
+/* Software filter lookup */
+#define CANIF_RX_STD_ID_COUNT   (2048U)
+#define CANIF_RX_HASH_MASK      (CANIF_RX_HASH_TABLE_SIZE - 1U)
+#define CANIF_RX_HASH(CanId, ControllerId) \
+    ((uint16)((((uint32)(CanId) ^ ((uint32)(ControllerId) << 29U)) * 0x9E3779B1UL) >> 16U) & CANIF_RX_HASH_MASK)
+
+#if ((CANIF_RX_HASH_TABLE_SIZE & CANIF_RX_HASH_MASK) != 0U)
+    #error "CANIF_RX_HASH_TABLE_SIZE must be a power of two"
+#endif
+
+#if ((CANIF_TX_BUFFERING == STD_ON) && (CANIF_CFG_TX_BUFFER_SIZE == 0U))
+    #error "CANIF_TX_BUFFERING requires CANIF_CFG_TX_BUFFER_SIZE > 0"
+#endif
+
+#if ((CAN_TRIGGER_TRANSMIT_SUPPORT == STD_ON) && (CANIF_TRIGGER_TRANSMIT_SUPPORT == STD_OFF))
+    #error "CAN_TRIGGER_TRANSMIT_SUPPORT requires CANIF_TRIGGER_TRANSMIT_SUPPORT"
+#endif
+
+#if ((CAN_CANCEL_TX_API == STD_ON) && (CANIF_CANCEL_TX_SUPPORT_API == STD_OFF))
+    #error "CAN_CANCEL_TX_API requires CANIF_CANCEL_TX_SUPPORT_API"
+#endif
+
+/* Deferred Rx queue, indices run freely and are masked on access */
+#if (CANIF_RX_DEFERRED_SUPPORT == STD_ON)
+#define CANIF_RX_DEFERRED_MASK  (CANIF_RX_DEFERRED_QUEUE_SIZE - 1U)
+
+#if (((CANIF_RX_DEFERRED_QUEUE_SIZE & CANIF_RX_DEFERRED_MASK) != 0U) || (CANIF_RX_DEFERRED_QUEUE_SIZE > 32768U))
+    #error "CANIF_RX_DEFERRED_QUEUE_SIZE must be a power of two up to 32768"
+#endif
+
+#if (CANIF_RX_DEFERRED_FRAME_BUDGET == 0U)
+    #error "CANIF_RX_DEFERRED_FRAME_BUDGET must be at least 1"
+#endif
+#endif
+
+#if (CANIF_STATISTICS_API == STD_ON)
+#if ((CANIF_STATISTICS_LATENCY_BUCKETS < 2U) || ((CANIF_STATISTICS_LATENCY_SHIFT + CANIF_STATISTICS_LATENCY_BUCKETS) > 33U))
+    #error "CANIF_STATISTICS_LATENCY_BUCKETS must be at least 2 and cover no more than 32 bits"
+#endif
+#endif
+
+/* Filter match indices per Rx FIFO: at most 4 elements (16-bit list) per filter bank */
+#define CANIF_RX_FIFO_COUNT     (2U)
+#define CANIF_RX_FMI_COUNT      (CAN_MAX_FILTER_COUNT * 4U)
+
 /*==================================================================================================
 *                                      LOCAL CONSTANTS
 ==================================================================================================*/
@@ -92,15 +210,23 @@ static CanIf_ControllerModeType CanIf_ControllerStates[CANIF_CFG_MAX_CONTROLLERS
 /* PDU channel modes */
 static CanIf_PduModeType CanIf_PduChannelModes[CANIF_CFG_MAX_CONTROLLERS];
 
-/* Tx buffer for storing Tx PDU data */
-#if (CANIF_CFG_TX_BUFFER_SIZE > 0U)
-static uint8 CanIf_TxBuffer[CANIF_CFG_MAX_TX_PDUS][CANIF_MAX_DLC];
+/* Tx buffers of all HTHs, each HTH owns TxBufferSize entries from CanIf_TxBufferFirst on. The
+   entries in use are sorted by priority, the next one to send is the last. */
+#if (CANIF_TX_BUFFERING == STD_ON)
+static CanIf_TxBufferEntryType CanIf_TxBuffer[CANIF_CFG_TX_BUFFER_SIZE];
+static uint16 CanIf_TxBufferFirst[CANIF_CFG_MAX_TX_HTHS];
+static uint8 CanIf_TxBufferCount[CANIF_CFG_MAX_TX_HTHS];
+static uint16 CanIf_TxBufferPending[CANIF_CFG_MAX_CONTROLLERS];
+#endif
+
+/* Set by CanIf_TriggerTransmit when the upper layer had no data and the driver drops the frame */
+#if ((CANIF_TX_BUFFERING == STD_ON) && (CANIF_TRIGGER_TRANSMIT_SUPPORT == STD_ON))
+static boolean CanIf_TxNoData;
 #endif
 
 /* Rx buffer for storing Rx PDU data */
 #if (CANIF_READ_RX_PDU_DATA_API == STD_ON)
-static uint8 CanIf_RxBuffer[CANIF_CFG_MAX_RX_PDUS][CANIF_MAX_DLC];
-static PduLengthType CanIf_RxBufferLength[CANIF_CFG_MAX_RX_PDUS];
+static CanIf_RxBufferType CanIf_RxBuffer[CANIF_CFG_MAX_RX_PDUS];
 #endif
 
 /* Tx notification status */
@@ -113,11 +239,40 @@ static CanIf_NotifStatusType CanIf_TxNotificationStatus[CANIF_CFG_MAX_TX_PDUS];
 static CanIf_NotifStatusType CanIf_RxNotificationStatus[CANIF_CFG_MAX_RX_PDUS];
 #endif
 
+/* Software filter index built at CanIf_Init */
+#if (CANIF_PRIVATE_SOFTWARE_FILTER == STD_ON)
+#if (CANIF_RX_DIRECT_TABLE_SUPPORT == STD_ON)
+static PduIdType CanIf_RxDirectTable[CANIF_CFG_MAX_CONTROLLERS][CANIF_RX_STD_ID_COUNT];
+#endif
+static CanIf_RxHashEntryType CanIf_RxHashTable[CANIF_RX_HASH_TABLE_SIZE];
+#endif
+
+/* Rx PDU per filter match index, CANIF_INVALID_PDU_ID where the element is not a single PDU */
+#if (CAN_RX_FILTER_API == STD_ON)
+static PduIdType CanIf_RxFmiTable[CANIF_CFG_MAX_CONTROLLERS][CANIF_RX_FIFO_COUNT][CANIF_RX_FMI_COUNT];
+#endif
+
 /* Dynamic CAN IDs */
 #if (CANIF_SET_DYNAMIC_TX_ID_API == STD_ON)
 static Can_IdType CanIf_DynamicTxIds[CANIF_CFG_MAX_TX_PDUS];
 #endif
 
+/* Rx indications of the bulk lane PDUs waiting for CanIf_MainFunction. Can_MainFunction_Read
+   alone writes at Head, CanIf_MainFunction alone reads at Tail. */
+#if (CANIF_RX_DEFERRED_SUPPORT == STD_ON)
+static CanIf_RxDeferredEntryType CanIf_RxDeferredQueue[CANIF_RX_DEFERRED_QUEUE_SIZE];
+static volatile uint16 CanIf_RxDeferredHead;
+static volatile uint16 CanIf_RxDeferredTail;
+#endif
+
+/* Statistics since CanIf_Init, read with CanIf_GetStatisticsSnapshot. The Rx and controller
+   counters are written from Can_MainFunction_Read only and take a plain increment. */
+#if (CANIF_STATISTICS_API == STD_ON)
+static CanIf_TxPduStatisticsType CanIf_TxPduStatistics[CANIF_CFG_MAX_TX_PDUS];
+static CanIf_RxPduStatisticsType CanIf_RxPduStatistics[CANIF_CFG_MAX_RX_PDUS];
+static CanIf_CtrlStatisticsType CanIf_CtrlStatistics[CANIF_CFG_MAX_CONTROLLERS];
+#endif
+
 /*==================================================================================================
 *                                      GLOBAL CONSTANTS
 ==================================================================================================*/
@@ -136,8 +291,47 @@ static Std_ReturnType CanIf_ValidateTxPduId(PduIdType TxPduId);
 static Std_ReturnType CanIf_ValidateRxPduId(PduIdType RxPduId);
 static boolean CanIf_IsInitialized(void);
 static PduIdType CanIf_FindRxPduByCanId(Can_IdType CanId, uint8 ControllerId);
+#if (CANIF_PRIVATE_SOFTWARE_FILTER == STD_ON)
+static void CanIf_BuildRxLookup(void);
+#endif
+static boolean CanIf_IsRxOnline(uint8 ControllerId);
+static const PduIdType* CanIf_GetRxFmiRow(const Can_HwType* Mailbox);
+static void CanIf_RxDispatch(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr, const PduIdType* FmiRow);
+#if (CANIF_READ_RX_PDU_DATA_API == STD_ON)
+static inline void CanIf_RxBufferWrite(PduIdType RxPduId, const PduInfoType* PduInfoPtr);
+#endif
+#if (CANIF_RX_DEFERRED_SUPPORT == STD_ON)
+static void CanIf_RxDeferredPut(PduIdType RxPduId, uint8 ControllerId, const PduInfoType* PduInfoPtr);
+static void CanIf_RxDeferredProcess(void);
+#endif
+#if (CANIF_STATISTICS_API == STD_ON)
+static void CanIf_StatsInit(void);
+static inline boolean CanIf_StatsTxStart(PduIdType TxPduId);
+static inline void CanIf_StatsTxEnd(PduIdType TxPduId, boolean Started, Std_ReturnType DriverRetVal, Std_ReturnType RetVal,
+                                    uint32 NoDataDropCount);
+static inline void CanIf_StatsTxConfirm(PduIdType TxPduId);
+static inline void CanIf_StatsTxDrop(PduIdType TxPduId, uint16 Count);
+static void CanIf_StatsTxStop(uint8 ControllerId);
+static uint8* CanIf_StatsPut(uint8* BufferPtr, uint32 Value);
+#endif
 static void CanIf_InitializeNotificationStatus(void);
 static void CanIf_InitializeBuffers(void);
+static inline uint32 CanIf_EnterCritical(void);
+static inline void CanIf_ExitCritical(uint32 PriMask);
+static Std_ReturnType CanIf_WriteCanPdu(Can_HwHandleType Hoh, const Can_PduType* CanPduInfo);
+#if (CANIF_TX_BUFFERING == STD_ON)
+static Std_ReturnType CanIf_TxBufferStore(uint8 HthIndex, const Can_PduType* CanPduInfo);
+static boolean CanIf_TxBufferRemove(uint8 HthIndex, PduIdType TxPduId);
+static void CanIf_TxBufferDrain(uint8 ControllerId);
+static void CanIf_TxBufferClear(uint8 ControllerId);
+#endif
+#if (CAN_RX_FILTER_API == STD_ON)
+static void CanIf_ConfigureRxFilters(void);
+static Can_HwHandleType CanIf_GetRxLaneHoh(const CanIf_CtrlConfigType* CtrlConfig,
+                                           const CanIf_HrhConfigType* HrhConfig,
+                                           CanIf_RxPriorityType Priority);
+static void CanIf_BuildRxFmiTable(const CanIf_CtrlConfigType* CtrlConfig);
+#endif
 
 /*==================================================================================================
 *                                       LOCAL FUNCTIONS
@@ -203,6 +397,133 @@ static boolean CanIf_IsInitialized(void)
     return (CanIf_ModuleState == CANIF_INIT) ? TRUE : FALSE;
 }
 
+#if (CANIF_PRIVATE_SOFTWARE_FILTER == STD_ON)
+/**
+ * @brief   Builds the software filter index from the Rx PDU table
+ * @details Standard CAN IDs go to the direct table of their controller (if enabled), all
+ *          other Rx PDUs to the open-addressing hash table with linear probing. When several
+ *          Rx PDUs share a CAN ID on one controller the lowest PDU ID wins, as with a linear scan.
+ */
+static void CanIf_BuildRxLookup(void)
+{
+    const CanIf_RxPduConfigType* RxPduConfig;
+    Can_IdType CanId;
+    PduIdType PduIndex;
+    uint16 Slot;
+    uint16 Probe;
+    uint8 ControllerId;
+
+#if (CANIF_RX_DIRECT_TABLE_SUPPORT == STD_ON)
+    for (ControllerId = 0U; ControllerId < CANIF_CFG_MAX_CONTROLLERS; ControllerId++)
+    {
+        for (Slot = 0U; Slot < CANIF_RX_STD_ID_COUNT; Slot++)
+        {
+            CanIf_RxDirectTable[ControllerId][Slot] = CANIF_INVALID_PDU_ID;
+        }
+    }
+#endif
+
+    for (Slot = 0U; Slot < CANIF_RX_HASH_TABLE_SIZE; Slot++)
+    {
+        CanIf_RxHashTable[Slot].RxPduId = CANIF_INVALID_PDU_ID;
+    }
+
+    for (PduIndex = 0U; PduIndex <= CanIf_ConfigPtr_Local->CanIfMaxRxPduId; PduIndex++)
+    {
+        RxPduConfig = &CanIf_ConfigPtr_Local->CanIfRxPduConfig[PduIndex];
+        ControllerId = CanIf_ConfigPtr_Local->CanIfHrhConfig[RxPduConfig->RxPduHrhId].ControllerId;
+        CanId = RxPduConfig->RxPduCanId;
+
+#if (CANIF_RX_DIRECT_TABLE_SUPPORT == STD_ON)
+        if (RxPduConfig->RxPduCanIdType != CANIF_EXTENDED)
+        {
+            if (CanIf_RxDirectTable[ControllerId][CanId & CAN_STD_ID_MASK] == CANIF_INVALID_PDU_ID)
+            {
+                CanIf_RxDirectTable[ControllerId][CanId & CAN_STD_ID_MASK] = PduIndex;
+            }
+            continue;
+        }
+#endif
+
+        if (RxPduConfig->RxPduCanIdType == CANIF_EXTENDED)
+        {
+            CanId |= CAN_ID_EXTENDED_FLAG;
+        }
+
+        Slot = CANIF_RX_HASH(CanId, ControllerId);
+        for (Probe = 0U; Probe < CANIF_RX_HASH_TABLE_SIZE; Probe++)
+        {
+            if (CanIf_RxHashTable[Slot].RxPduId == CANIF_INVALID_PDU_ID)
+            {
+                CanIf_RxHashTable[Slot].CanId = CanId;
+                CanIf_RxHashTable[Slot].ControllerId = ControllerId;
+                CanIf_RxHashTable[Slot].RxPduId = PduIndex;
+                break;
+            }
+
+            if ((CanIf_RxHashTable[Slot].CanId == CanId) && (CanIf_RxHashTable[Slot].ControllerId == ControllerId))
+            {
+                break;
+            }
+
+            Slot = (Slot + 1U) & CANIF_RX_HASH_MASK;
+        }
+
+#if (CANIF_DEV_ERROR_DETECT == STD_ON)
+        if (Probe == CANIF_RX_HASH_TABLE_SIZE)
+        {
+            /* CANIF_RX_HASH_TABLE_SIZE too small, the PDU will not be received */
+            Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_INIT, CANIF_E_PARAM_LPDU);
+        }
+#endif
+    }
+}
+
+/**
+ * @brief   Finds Rx PDU by CAN ID
+ * @details Constant-time lookup in the index built by CanIf_BuildRxLookup.
+ * @param[in] CanId - CAN ID to search for, CAN_ID_EXTENDED_FLAG set for extended IDs
+ * @param[in] ControllerId - Controller ID
+ * @return  PduIdType - PDU ID or CANIF_INVALID_PDU_ID if not found
+ */
+static PduIdType CanIf_FindRxPduByCanId(Can_IdType CanId, uint8 ControllerId)
+{
+    const CanIf_RxHashEntryType* Entry;
+    uint16 Slot;
+    uint16 Probe;
+
+    if (ControllerId >= CANIF_CFG_MAX_CONTROLLERS)
+    {
+        return CANIF_INVALID_PDU_ID;
+    }
+
+#if (CANIF_RX_DIRECT_TABLE_SUPPORT == STD_ON)
+    if ((CanId & CAN_ID_EXTENDED_FLAG) == 0U)
+    {
+        return CanIf_RxDirectTable[ControllerId][CanId & CAN_STD_ID_MASK];
+    }
+#endif
+
+    Slot = CANIF_RX_HASH(CanId, ControllerId);
+    for (Probe = 0U; Probe < CANIF_RX_HASH_TABLE_SIZE; Probe++)
+    {
+        Entry = &CanIf_RxHashTable[Slot];
+        if (Entry->RxPduId == CANIF_INVALID_PDU_ID)
+        {
+            break;
+        }
+
+        if ((Entry->CanId == CanId) && (Entry->ControllerId == ControllerId))
+        {
+            return Entry->RxPduId;
+        }
+
+        Slot = (Slot + 1U) & CANIF_RX_HASH_MASK;
+    }
+
+    return CANIF_INVALID_PDU_ID;
+}
+#else
 /**
  * @brief   Finds Rx PDU by CAN ID
  * @param[in] CanId - CAN ID to search for
@@ -220,7 +541,7 @@ static PduIdType CanIf_FindRxPduByCanId(Can_IdType CanId, uint8 ControllerId)
         RxPduConfig = &CanIf_ConfigPtr_Local->CanIfRxPduConfig[PduIndex];
         
         /* Check if CAN ID matches and HRH belongs to the controller */
-        if ((RxPduConfig->RxPduCanId == CanId) && 
+        if (((RxPduConfig->RxPduCanId | ((RxPduConfig->RxPduCanIdType == CANIF_EXTENDED) ? CAN_ID_EXTENDED_FLAG : 0U)) == CanId) && 
             (CanIf_ConfigPtr_Local->CanIfHrhConfig[RxPduConfig->RxPduHrhId].ControllerId == ControllerId))
         {
             FoundPduId = PduIndex;
@@ -230,13 +551,461 @@ static PduIdType CanIf_FindRxPduByCanId(Can_IdType CanId, uint8 ControllerId)
     
     return FoundPduId;
 }
+#endif
+
+/**
+ * @brief   Checks whether the PDU mode of a controller lets Rx L-PDUs through
+ * @param[in] ControllerId - Controller ID reported by the CAN driver
+ * @return  boolean - TRUE in CANIF_ONLINE and CANIF_TX_OFFLINE
+ */
+static boolean CanIf_IsRxOnline(uint8 ControllerId)
+{
+    return ((CanIf_PduChannelModes[ControllerId] == CANIF_ONLINE) ||
+            (CanIf_PduChannelModes[ControllerId] == CANIF_TX_OFFLINE)) ? TRUE : FALSE;
+}
+
+/**
+ * @brief   Returns the FMI dispatch row of the HRH a frame was received on
+ * @param[in] Mailbox - Hardware object of the received frame
+ * @return  const PduIdType* - Row indexed by the filter match index, NULL_PTR if there is none
+ */
+static const PduIdType* CanIf_GetRxFmiRow(const Can_HwType* Mailbox)
+{
+    const PduIdType* FmiRow = NULL_PTR;
+
+#if (CAN_RX_FILTER_API == STD_ON)
+    if ((Mailbox->ControllerId < CANIF_CFG_MAX_CONTROLLERS) &&
+        ((Mailbox->Hoh == CAN_HRH_0) || (Mailbox->Hoh == CAN_HRH_1)))
+    {
+        FmiRow = CanIf_RxFmiTable[Mailbox->ControllerId][Mailbox->Hoh - CAN_HRH_0];
+    }
+#else
+    (void)Mailbox;
+#endif
+
+    return FmiRow;
+}
+
+#if (CANIF_READ_RX_PDU_DATA_API == STD_ON)
+/**
+ * @brief   Publishes a received L-SDU for CanIf_ReadRxPduData
+ * @details Fills the slot readers are not using and then flips it current with one word store,
+ *          so the writer never waits. A PDU is received through one HRH, so writes of the same
+ *          PDU never nest.
+ */
+static inline void CanIf_RxBufferWrite(PduIdType RxPduId, const PduInfoType* PduInfoPtr)
+{
+    CanIf_RxBufferType* Buffer = &CanIf_RxBuffer[RxPduId];
+    uint32 Sequence = Buffer->Sequence;
+    uint8 Slot = (uint8)((Sequence + 1U) & 1U);
+    uint8 DataIndex;
+
+    for (DataIndex = 0U; DataIndex < PduInfoPtr->SduLength; DataIndex++)
+    {
+        Buffer->Data[Slot][DataIndex] = PduInfoPtr->SduDataPtr[DataIndex];
+    }
+    Buffer->Length[Slot] = PduInfoPtr->SduLength;
+
+    /* Data before the flip */
+    __DMB();
+    Buffer->Sequence = Sequence + 1U;
+}
+#endif
+
+#if (CANIF_RX_DEFERRED_SUPPORT == STD_ON)
+/**
+ * @brief   Queues the Rx indication of a received L-PDU for CanIf_MainFunction
+ * @details Called from Can_MainFunction_Read, the only producer; the entry is filled before
+ *          Head moves, so CanIf_MainFunction may preempt it or be preempted by it. A full
+ *          queue loses the indication.
+ */
+static void CanIf_RxDeferredPut(PduIdType RxPduId, uint8 ControllerId, const PduInfoType* PduInfoPtr)
+{
+    CanIf_RxDeferredEntryType* Entry;
+    uint8 DataIndex;
+    uint8 Length = (uint8)PduInfoPtr->SduLength;
+
+    if (Length > CANIF_MAX_PDU_LENGTH)
+    {
+        Length = CANIF_MAX_PDU_LENGTH;
+    }
+
+    if ((uint16)(CanIf_RxDeferredHead - CanIf_RxDeferredTail) >= CANIF_RX_DEFERRED_QUEUE_SIZE)
+    {
+#if (CANIF_STATISTICS_API == STD_ON)
+        CanIf_RxPduStatistics[RxPduId].QueueFullDropCount++;
+#endif
+#if (CANIF_DEV_ERROR_DETECT == STD_ON)
+        Det_ReportRuntimeError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_RX_INDICATION, CANIF_E_RX_DEFERRED_QUEUE_FULL);
+#endif
+        return;
+    }
+
+    Entry = &CanIf_RxDeferredQueue[CanIf_RxDeferredHead & CANIF_RX_DEFERRED_MASK];
+    Entry->RxPduId = RxPduId;
+    Entry->ControllerId = ControllerId;
+    Entry->Length = Length;
+    for (DataIndex = 0U; DataIndex < Length; DataIndex++)
+    {
+        Entry->Data[DataIndex] = PduInfoPtr->SduDataPtr[DataIndex];
+    }
+
+    /* Entry before the index */
+    __DMB();
+    CanIf_RxDeferredHead++;
+}
+
+/**
+ * @brief   Dispatches queued Rx indications within the budget of one CanIf_MainFunction call
+ * @details At most CANIF_RX_DEFERRED_FRAME_BUDGET indications, and none once
+ *          CANIF_RX_DEFERRED_CYCLE_BUDGET cycles have passed; what is left stays queued for the
+ *          next call. Receptions keep enqueueing meanwhile, the slot at Tail is theirs again only
+ *          after it has been copied.
+ */
+static void CanIf_RxDeferredProcess(void)
+{
+    CanIf_RxDeferredEntryType Entry;
+    const CanIf_RxPduConfigType* RxPduConfig;
+    PduInfoType PduInfo;
+    uint16 Budget = CANIF_RX_DEFERRED_FRAME_BUDGET;
+#if (CANIF_RX_DEFERRED_CYCLE_BUDGET > 0U)
+    uint32 Start = DWT->CYCCNT;
+#endif
+
+    PduInfo.SduDataPtr = Entry.Data;
+    PduInfo.MetaDataPtr = NULL_PTR;
+
+    while ((Budget > 0U) && (CanIf_RxDeferredTail != CanIf_RxDeferredHead))
+    {
+        /* Index before the entry, entry copied before the slot is released */
+        __DMB();
+        Entry = CanIf_RxDeferredQueue[CanIf_RxDeferredTail & CANIF_RX_DEFERRED_MASK];
+        __DMB();
+        CanIf_RxDeferredTail++;
+        Budget--;
+
+        /* Indications of a controller stopped since the reception are dropped */
+        if (TRUE == CanIf_IsRxOnline(Entry.ControllerId))
+        {
+            RxPduConfig = &CanIf_ConfigPtr_Local->CanIfRxPduConfig[Entry.RxPduId];
+            if (NULL_PTR != RxPduConfig->RxPduUserRxIndicationUL)
+            {
+                PduInfo.SduLength = Entry.Length;
+                RxPduConfig->RxPduUserRxIndicationUL(Entry.RxPduId, &PduInfo);
+            }
+        }
+
+#if (CANIF_RX_DEFERRED_CYCLE_BUDGET > 0U)
+        if ((DWT->CYCCNT - Start) >= CANIF_RX_DEFERRED_CYCLE_BUDGET)
+        {
+            break;
+        }
+#endif
+    }
+}
+#endif
+
+#if (CANIF_STATISTICS_API == STD_ON)
+/**
+ * @brief   Clears the statistics
+ */
+static void CanIf_StatsInit(void)
+{
+    PduIdType PduIndex;
+    uint8 ControllerIndex;
+    uint8 Bucket;
+
+    for (PduIndex = 0U; PduIndex < CANIF_CFG_MAX_TX_PDUS; PduIndex++)
+    {
+        CanIf_TxPduStatistics[PduIndex].RequestCount = 0U;
+        CanIf_TxPduStatistics[PduIndex].ConfirmationCount = 0U;
+        CanIf_TxPduStatistics[PduIndex].OfflineDropCount = 0U;
+        CanIf_TxPduStatistics[PduIndex].BufferFullDropCount = 0U;
+        CanIf_TxPduStatistics[PduIndex].RejectedCount = 0U;
+        CanIf_TxPduStatistics[PduIndex].NoDataDropCount = 0U;
+        CanIf_TxPduStatistics[PduIndex].LatencyMax = 0U;
+        for (Bucket = 0U; Bucket < CANIF_STATISTICS_LATENCY_BUCKETS; Bucket++)
+        {
+            CanIf_TxPduStatistics[PduIndex].Latency[Bucket] = 0U;
+        }
+        CanIf_TxPduStatistics[PduIndex].Outstanding = 0U;
+        CanIf_TxPduStatistics[PduIndex].Timing = FALSE;
+    }
+
+    for (PduIndex = 0U; PduIndex < CANIF_CFG_MAX_RX_PDUS; PduIndex++)
+    {
+        CanIf_RxPduStatistics[PduIndex].IndicationCount = 0U;
+        CanIf_RxPduStatistics[PduIndex].QueueFullDropCount = 0U;
+    }
+
+    for (ControllerIndex = 0U; ControllerIndex < CANIF_CFG_MAX_CONTROLLERS; ControllerIndex++)
+    {
+        CanIf_CtrlStatistics[ControllerIndex].OfflineDropCount = 0U;
+        CanIf_CtrlStatistics[ControllerIndex].UnknownIdCount = 0U;
+    }
+}
+
+/**
+ * @brief   Counts a Tx request as outstanding and times it if no other one is
+ * @details Runs before the request reaches the driver, so its confirmation finds both. A
+ *          request made while others are unconfirmed is not timed: its confirmation could not be
+ *          told apart from theirs.
+ * @return  boolean - TRUE if this request is timed
+ */
+static inline boolean CanIf_StatsTxStart(PduIdType TxPduId)
+{
+    CanIf_TxPduStatisticsType* Stats = &CanIf_TxPduStatistics[TxPduId];
+    boolean Started = FALSE;
+    uint32 PriMask = CanIf_EnterCritical();
+
+    if (0U == Stats->Outstanding)
+    {
+        Stats->RequestTime = DWT->CYCCNT;
+        Stats->Timing = TRUE;
+        Started = TRUE;
+    }
+    Stats->Outstanding++;
+
+    CanIf_ExitCritical(PriMask);
+
+    return Started;
+}
+
+/**
+ * @brief   Counts the outcome of a Tx request
+ * @param[in] Started - CanIf_StatsTxStart timed the request
+ * @param[in] DriverRetVal - Result of the CAN driver
+ * @param[in] RetVal - Result of the request, buffering included
+ * @param[in] NoDataDropCount - NoDataDropCount before the request
+ */
+static inline void CanIf_StatsTxEnd(PduIdType TxPduId, boolean Started, Std_ReturnType DriverRetVal, Std_ReturnType RetVal,
+                                    uint32 NoDataDropCount)
+{
+    CanIf_TxPduStatisticsType* Stats = &CanIf_TxPduStatistics[TxPduId];
+    uint32 PriMask;
+
+    if (E_OK == RetVal)
+    {
+        Stats->RequestCount++;
+        return;
+    }
+
+    /* Fetched without data on the direct path: CanIf_TriggerTransmit already ended it */
+    if (Stats->NoDataDropCount != NoDataDropCount)
+    {
+        return;
+    }
+
+    /* CAN_BUSY, or CAN_BUSY and then a full CanIf buffer */
+    if (CAN_BUSY == DriverRetVal)
+    {
+        Stats->BufferFullDropCount++;
+    }
+    else
+    {
+        Stats->RejectedCount++;
+    }
+
+    PriMask = CanIf_EnterCritical();
+    Stats->Outstanding--;
+    if (TRUE == Started)
+    {
+        Stats->Timing = FALSE;
+    }
+    CanIf_ExitCritical(PriMask);
+}
+
+/**
+ * @brief   Counts a Tx confirmation and files the latency of the timed request
+ * @details The timed request was alone when it was made, so the first confirmation after it
+ *          ends the sample. Bucket 0 below 2^CANIF_STATISTICS_LATENCY_SHIFT cycles, then one
+ *          bucket per power of two, the last one open-ended.
+ */
+static inline void CanIf_StatsTxConfirm(PduIdType TxPduId)
+{
+    CanIf_TxPduStatisticsType* Stats = &CanIf_TxPduStatistics[TxPduId];
+    boolean Timed;
+    uint32 Latency;
+    uint32 Bucket = 0U;
+    uint32 PriMask;
+
+    Stats->ConfirmationCount++;
+
+    /* A request from a higher priority context may update the same fields */
+    PriMask = CanIf_EnterCritical();
+    if (Stats->Outstanding != 0U)
+    {
+        Stats->Outstanding--;
+    }
+    Timed = Stats->Timing;
+    Stats->Timing = FALSE;
+    Latency = DWT->CYCCNT - Stats->RequestTime;
+    CanIf_ExitCritical(PriMask);
+
+    if (TRUE == Timed)
+    {
+        if (Latency > Stats->LatencyMax)
+        {
+            Stats->LatencyMax = Latency;
+        }
+
+        if ((Latency >> CANIF_STATISTICS_LATENCY_SHIFT) != 0U)
+        {
+            Bucket = 32U - (uint32)__CLZ(Latency >> CANIF_STATISTICS_LATENCY_SHIFT);
+            if (Bucket >= CANIF_STATISTICS_LATENCY_BUCKETS)
+            {
+                Bucket = CANIF_STATISTICS_LATENCY_BUCKETS - 1U;
+            }
+        }
+        Stats->Latency[Bucket]++;
+    }
+}
+
+/**
+ * @brief   Ends requests that will never be confirmed
+ * @details Cancelled, replaced or discarded requests are no latency sample. Which of the
+ *          outstanding requests is timed is not known, so the running time is dropped with them.
+ */
+static inline void CanIf_StatsTxDrop(PduIdType TxPduId, uint16 Count)
+{
+    CanIf_TxPduStatisticsType* Stats = &CanIf_TxPduStatistics[TxPduId];
+    uint32 PriMask = CanIf_EnterCritical();
+
+    Stats->Outstanding = (Stats->Outstanding > Count) ? (uint16)(Stats->Outstanding - Count) : 0U;
+    Stats->Timing = FALSE;
+
+    CanIf_ExitCritical(PriMask);
+}
+
+/**
+ * @brief   Ends the requests and pending latencies of a controller
+ * @details The driver discards its requests when the controller stops, no confirmation ends
+ *          them.
+ */
+static void CanIf_StatsTxStop(uint8 ControllerId)
+{
+    PduIdType PduIndex;
+    uint8 HthId;
+    uint32 PriMask = CanIf_EnterCritical();
+
+    for (PduIndex = 0U; PduIndex <= CanIf_ConfigPtr_Local->CanIfMaxTxPduId; PduIndex++)
+    {
+        HthId = CanIf_ConfigPtr_Local->CanIfTxPduConfig[PduIndex].TxPduHthId;
+        if (CanIf_ConfigPtr_Local->CanIfHthConfig[HthId].ControllerId == ControllerId)
+        {
+            CanIf_TxPduStatistics[PduIndex].Outstanding = 0U;
+            CanIf_TxPduStatistics[PduIndex].Timing = FALSE;
+        }
+    }
+
+    CanIf_ExitCritical(PriMask);
+}
+
+/**
+ * @brief   Appends a counter to a snapshot as unsigned LEB128
+ * @return  uint8* - Next free byte
+ */
+static uint8* CanIf_StatsPut(uint8* BufferPtr, uint32 Value)
+{
+    while (Value >= 0x80U)
+    {
+        *BufferPtr = (uint8)((Value & 0x7FU) | 0x80U);
+        BufferPtr++;
+        Value >>= 7U;
+    }
+    *BufferPtr = (uint8)Value;
+
+    return BufferPtr + 1U;
+}
+#endif
+
+/**
+ * @brief   Finds, buffers and indicates one received L-PDU
+ * @details Common part of CanIf_RxIndication and CanIf_RxIndicationBatch, called once the module
+ *          state, the parameters and the PDU mode of the controller have been checked.
+ * @param[in] Mailbox - Hardware object of the received frame
+ * @param[in] PduInfoPtr - Received L-SDU
+ * @param[in] FmiRow - FMI dispatch row of the HRH (CanIf_GetRxFmiRow), NULL_PTR for none
+ */
+static void CanIf_RxDispatch(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr, const PduIdType* FmiRow)
+{
+    PduIdType RxPduId = CANIF_INVALID_PDU_ID;
+    const CanIf_RxPduConfigType* RxPduConfig;
+
+#if (CAN_RX_FILTER_API == STD_ON)
+    /* Constant-time dispatch through the filter element that accepted the frame */
+    if ((NULL_PTR != FmiRow) && (Mailbox->FilterMatchIndex < CANIF_RX_FMI_COUNT))
+    {
+        RxPduId = FmiRow[Mailbox->FilterMatchIndex];
+    }
+#else
+    (void)FmiRow;
+#endif
+
+    /* Masked filter elements: find matching Rx PDU by CAN ID */
+    if (CANIF_INVALID_PDU_ID == RxPduId)
+    {
+        RxPduId = CanIf_FindRxPduByCanId(Mailbox->CanId, Mailbox->ControllerId);
+    }
+
+#if (CANIF_STATISTICS_API == STD_ON)
+    if (CANIF_INVALID_PDU_ID == RxPduId)
+    {
+        CanIf_CtrlStatistics[Mailbox->ControllerId].UnknownIdCount++;
+    }
+#endif
+
+    if (CANIF_INVALID_PDU_ID != RxPduId)
+    {
+        RxPduConfig = &CanIf_ConfigPtr_Local->CanIfRxPduConfig[RxPduId];
+
+#if (CANIF_STATISTICS_API == STD_ON)
+        /* A PDU is received through one HRH, its counter is not shared */
+        CanIf_RxPduStatistics[RxPduId].IndicationCount++;
+#endif
+
+#if (CANIF_READ_RX_PDU_DATA_API == STD_ON)
+        /* Store data in Rx buffer if enabled */
+        if (RxPduConfig->RxPduReadData == STD_ON)
+        {
+            CanIf_RxBufferWrite(RxPduId, PduInfoPtr);
+        }
+#endif
+
+#if (CANIF_READ_RX_PDU_NOTIFY_STATUS_API == STD_ON)
+        /* Set notification status if enabled */
+        if (RxPduConfig->RxPduReadNotifyStatus == STD_ON)
+        {
+            CanIf_RxNotificationStatus[RxPduId] = CANIF_TX_RX_NOTIFICATION;
+        }
+#endif
+
+#if (CANIF_RX_DEFERRED_SUPPORT == STD_ON)
+        /* Bulk lane: upper layer indicated later from CanIf_MainFunction */
+        if (RxPduConfig->RxPduPriority == CANIF_RX_PRIORITY_BULK)
+        {
+            if (NULL_PTR != RxPduConfig->RxPduUserRxIndicationUL)
+            {
+                CanIf_RxDeferredPut(RxPduId, Mailbox->ControllerId, PduInfoPtr);
+            }
+            return;
+        }
+#endif
+
+        /* Call upper layer indication function */
+        if (NULL_PTR != RxPduConfig->RxPduUserRxIndicationUL)
+        {
+            RxPduConfig->RxPduUserRxIndicationUL(RxPduId, PduInfoPtr);
+        }
+    }
+}
 
 /**
  * @brief   Initializes notification status arrays
  */
 static void CanIf_InitializeNotificationStatus(void)
 {
-    uint8 Index;
+    PduIdType Index;
     
 #if (CANIF_READ_TX_PDU_NOTIFY_STATUS_API == STD_ON)
     for (Index = 0U; Index <= CanIf_ConfigPtr_Local->CanIfMaxTxPduId; Index++)
@@ -258,14 +1027,25 @@ static void CanIf_InitializeNotificationStatus(void)
  */
 static void CanIf_InitializeBuffers(void)
 {
-    uint8 PduIndex, DataIndex;
-    
-#if (CANIF_CFG_TX_BUFFER_SIZE > 0U)
-    for (PduIndex = 0U; PduIndex <= CanIf_ConfigPtr_Local->CanIfMaxTxPduId; PduIndex++)
+    PduIdType PduIndex;
+    uint8 DataIndex;
+#if (CANIF_TX_BUFFERING == STD_ON)
+    const CanIf_CtrlConfigType* CtrlConfig;
+    uint16 First = 0U;
+    uint8 ControllerIndex;
+    uint8 HthIndex;
+
+    /* CANIF_CFG_TX_BUFFER_SIZE is the sum of the TxBufferSize of all HTHs */
+    for (ControllerIndex = 0U; ControllerIndex <= CanIf_ConfigPtr_Local->CanIfMaxCtrlId; ControllerIndex++)
     {
-        for (DataIndex = 0U; DataIndex < CANIF_MAX_DLC; DataIndex++)
+        CtrlConfig = &CanIf_ConfigPtr_Local->CanIfCtrlConfig[ControllerIndex];
+        CanIf_TxBufferPending[ControllerIndex] = 0U;
+
+        for (HthIndex = CtrlConfig->FirstHthIndex; HthIndex < (CtrlConfig->FirstHthIndex + CtrlConfig->HthCount); HthIndex++)
         {
-            CanIf_TxBuffer[PduIndex][DataIndex] = 0U;
+            CanIf_TxBufferFirst[HthIndex] = First;
+            CanIf_TxBufferCount[HthIndex] = 0U;
+            First += CanIf_ConfigPtr_Local->CanIfHthConfig[HthIndex].TxBufferSize;
         }
     }
 #endif
@@ -273,10 +1053,13 @@ static void CanIf_InitializeBuffers(void)
 #if (CANIF_READ_RX_PDU_DATA_API == STD_ON)
     for (PduIndex = 0U; PduIndex <= CanIf_ConfigPtr_Local->CanIfMaxRxPduId; PduIndex++)
     {
-        CanIf_RxBufferLength[PduIndex] = 0U;
+        CanIf_RxBuffer[PduIndex].Sequence = 0U;
+        CanIf_RxBuffer[PduIndex].Length[0] = 0U;
+        CanIf_RxBuffer[PduIndex].Length[1] = 0U;
         for (DataIndex = 0U; DataIndex < CANIF_MAX_DLC; DataIndex++)
         {
-            CanIf_RxBuffer[PduIndex][DataIndex] = 0U;
+            CanIf_RxBuffer[PduIndex].Data[0][DataIndex] = 0U;
+            CanIf_RxBuffer[PduIndex].Data[1][DataIndex] = 0U;
         }
     }
 #endif
@@ -287,7 +1070,390 @@ static void CanIf_InitializeBuffers(void)
         CanIf_DynamicTxIds[PduIndex] = CanIf_ConfigPtr_Local->CanIfTxPduConfig[PduIndex].TxPduCanId;
     }
 #endif
+
+#if (CANIF_RX_DEFERRED_SUPPORT == STD_ON)
+    CanIf_RxDeferredHead = 0U;
+    CanIf_RxDeferredTail = 0U;
+#endif
+}
+
+/**
+ * @brief   Enter the CanIf critical section
+ * @details The Tx buffers are shared between CanIf_Transmit and the CAN TX interrupt that calls
+ *          CanIf_TxConfirmation.
+ */
+static inline uint32 CanIf_EnterCritical(void)
+{
+    uint32 PriMask = __get_PRIMASK();
+
+    __disable_irq();
+    return PriMask;
+}
+
+/**
+ * @brief   Leave the CanIf critical section
+ */
+static inline void CanIf_ExitCritical(uint32 PriMask)
+{
+    __set_PRIMASK(PriMask);
+}
+
+/**
+ * @brief   Hands a CAN PDU to the CAN driver
+ * @details 8-byte PDUs take the fixed-length transmit path of the driver.
+ */
+static Std_ReturnType CanIf_WriteCanPdu(Can_HwHandleType Hoh, const Can_PduType* CanPduInfo)
+{
+#if (CAN_WRITE_DLC8_API == STD_ON)
+    if (CanPduInfo->length == CANIF_MAX_DLC)
+    {
+        return Can_WriteDlc8(Hoh, CanPduInfo);
+    }
+#endif
+
+    return Can_Write(Hoh, CanPduInfo);
+}
+
+#if (CANIF_TX_BUFFERING == STD_ON)
+/**
+ * @brief   Buffers an L-PDU the CAN driver has no room for
+ * @details In CANIF_TX_BUFFER_SINGLE mode a pending request of the same L-PDU is replaced, so
+ *          only the newest data is sent. The entry is inserted by priority, behind the entries
+ *          with the same CAN ID, so one L-PDU keeps its request order. A confirmation may have
+ *          freed the driver between its CAN_BUSY and the insertion, so the buffers of the
+ *          controller are drained once more.
+ *
+ * @param[in]   HthIndex        CanIf HTH of the L-PDU
+ * @param[in]   CanPduInfo      Request rejected with CAN_BUSY
+ *
+ * @return  Std_ReturnType  E_OK if buffered, E_NOT_OK if the buffer of the HTH is full
+ */
+static Std_ReturnType CanIf_TxBufferStore(uint8 HthIndex, const Can_PduType* CanPduInfo)
+{
+    const CanIf_HthConfigType* HthConfig = &CanIf_ConfigPtr_Local->CanIfHthConfig[HthIndex];
+    CanIf_TxBufferEntryType* Buffer = &CanIf_TxBuffer[CanIf_TxBufferFirst[HthIndex]];
+    uint32 Priority = CAN_TX_PRIORITY(CanPduInfo->id);
+    uint32 PriMask;
+    uint8 Count;
+    uint8 Index;
+    uint8 DataIndex;
+
+    PriMask = CanIf_EnterCritical();
+
+    if (HthConfig->TxBufferMode == CANIF_TX_BUFFER_SINGLE)
+    {
+        /* Drop the older request; its CAN ID may have changed since (dynamic Tx PDU) */
+        (void)CanIf_TxBufferRemove(HthIndex, CanPduInfo->swPduHandle);
+    }
+
+    Count = CanIf_TxBufferCount[HthIndex];
+    if (Count >= HthConfig->TxBufferSize)
+    {
+        CanIf_ExitCritical(PriMask);
+        return E_NOT_OK;
+    }
+
+    Index = Count;
+    while ((Index > 0U) && (Buffer[Index - 1U].Priority <= Priority))
+    {
+        Buffer[Index] = Buffer[Index - 1U];
+        Index--;
+    }
+    Buffer[Index].Priority = Priority;
+    Buffer[Index].CanId = CanPduInfo->id;
+    Buffer[Index].TxPduId = CanPduInfo->swPduHandle;
+    Buffer[Index].Length = CanPduInfo->length;
+    /* A trigger transmit request has no payload yet, the driver fetches it later. The length is
+       only checked by DET, so the copy is bounded by the entry as well. */
+    if (CanPduInfo->sdu != NULL_PTR)
+    {
+        for (DataIndex = 0U; (DataIndex < CanPduInfo->length) && (DataIndex < CANIF_MAX_PDU_LENGTH); DataIndex++)
+        {
+            Buffer[Index].Data[DataIndex] = CanPduInfo->sdu[DataIndex];
+        }
+    }
+
+    CanIf_TxBufferCount[HthIndex] = Count + 1U;
+    CanIf_TxBufferPending[HthConfig->ControllerId]++;
+
+    CanIf_TxBufferDrain(HthConfig->ControllerId);
+
+    CanIf_ExitCritical(PriMask);
+
+    return E_OK;
+}
+
+/**
+ * @brief   Removes the buffered requests of an L-PDU
+ * @details The remaining entries keep their order.
+ *
+ * @return  boolean         TRUE if a request was removed
+ */
+static boolean CanIf_TxBufferRemove(uint8 HthIndex, PduIdType TxPduId)
+{
+    CanIf_TxBufferEntryType* Buffer = &CanIf_TxBuffer[CanIf_TxBufferFirst[HthIndex]];
+    uint8 ControllerId = CanIf_ConfigPtr_Local->CanIfHthConfig[HthIndex].ControllerId;
+    uint32 PriMask;
+    uint8 Count;
+    uint8 Index;
+    uint8 Kept = 0U;
+
+    PriMask = CanIf_EnterCritical();
+
+    Count = CanIf_TxBufferCount[HthIndex];
+    for (Index = 0U; Index < Count; Index++)
+    {
+        if (Buffer[Index].TxPduId != TxPduId)
+        {
+            if (Kept != Index)
+            {
+                Buffer[Kept] = Buffer[Index];
+            }
+            Kept++;
+        }
+    }
+    CanIf_TxBufferCount[HthIndex] = Kept;
+    CanIf_TxBufferPending[ControllerId] -= (uint16)(Count - Kept);
+#if (CANIF_STATISTICS_API == STD_ON)
+    if (Kept != Count)
+    {
+        CanIf_StatsTxDrop(TxPduId, (uint16)(Count - Kept));
+    }
+#endif
+
+    CanIf_ExitCritical(PriMask);
+
+    return (Kept != Count) ? TRUE : FALSE;
+}
+
+/**
+ * @brief   Hands buffered L-PDUs of a controller to the CAN driver, highest priority first
+ * @details Each HTH stops at the first CAN_BUSY. The driver copies the payload in Can_Write, so
+ *          the entry is free as soon as the call returns.
+ */
+static void CanIf_TxBufferDrain(uint8 ControllerId)
+{
+    const CanIf_CtrlConfigType* CtrlConfig = &CanIf_ConfigPtr_Local->CanIfCtrlConfig[ControllerId];
+    CanIf_TxBufferEntryType* Entry;
+    Can_PduType CanPduInfo;
+    uint32 PriMask;
+    uint8 HthIndex;
+
+    PriMask = CanIf_EnterCritical();
+
+    for (HthIndex = CtrlConfig->FirstHthIndex; HthIndex < (CtrlConfig->FirstHthIndex + CtrlConfig->HthCount); HthIndex++)
+    {
+        while (CanIf_TxBufferCount[HthIndex] > 0U)
+        {
+            Entry = &CanIf_TxBuffer[CanIf_TxBufferFirst[HthIndex] + CanIf_TxBufferCount[HthIndex] - 1U];
+            CanPduInfo.id = Entry->CanId;
+            CanPduInfo.swPduHandle = Entry->TxPduId;
+            CanPduInfo.length = Entry->Length;
+            CanPduInfo.sdu = Entry->Data;
+#if (CANIF_TRIGGER_TRANSMIT_SUPPORT == STD_ON)
+            if (CanIf_ConfigPtr_Local->CanIfTxPduConfig[Entry->TxPduId].TxPduTriggerTransmit == STD_ON)
+            {
+                CanPduInfo.sdu = NULL_PTR;
+            }
+#endif
+
+#if (CANIF_TRIGGER_TRANSMIT_SUPPORT == STD_ON)
+            CanIf_TxNoData = FALSE;
+#endif
+            if (CanIf_WriteCanPdu(CanIf_ConfigPtr_Local->CanIfHthConfig[HthIndex].HohId, &CanPduInfo) != E_OK)
+            {
+#if (CANIF_TRIGGER_TRANSMIT_SUPPORT == STD_ON)
+                /* No data: the request has ended, the next entry may go */
+                if (TRUE == CanIf_TxNoData)
+                {
+                    CanIf_TxBufferCount[HthIndex]--;
+                    CanIf_TxBufferPending[ControllerId]--;
+                    continue;
+                }
+#endif
+                break;
+            }
+
+            CanIf_TxBufferCount[HthIndex]--;
+            CanIf_TxBufferPending[ControllerId]--;
+        }
+    }
+
+    CanIf_ExitCritical(PriMask);
+}
+
+/**
+ * @brief   Discards the buffered L-PDUs of a controller
+ * @details Called when the controller leaves CANIF_CS_STARTED or its Tx path goes offline.
+ */
+static void CanIf_TxBufferClear(uint8 ControllerId)
+{
+    const CanIf_CtrlConfigType* CtrlConfig = &CanIf_ConfigPtr_Local->CanIfCtrlConfig[ControllerId];
+    uint32 PriMask;
+    uint8 HthIndex;
+#if (CANIF_STATISTICS_API == STD_ON)
+    uint8 Index;
+#endif
+
+    PriMask = CanIf_EnterCritical();
+
+    for (HthIndex = CtrlConfig->FirstHthIndex; HthIndex < (CtrlConfig->FirstHthIndex + CtrlConfig->HthCount); HthIndex++)
+    {
+#if (CANIF_STATISTICS_API == STD_ON)
+        for (Index = 0U; Index < CanIf_TxBufferCount[HthIndex]; Index++)
+        {
+            CanIf_StatsTxDrop(CanIf_TxBuffer[CanIf_TxBufferFirst[HthIndex] + Index].TxPduId, 1U);
+        }
+#endif
+        CanIf_TxBufferCount[HthIndex] = 0U;
+    }
+    CanIf_TxBufferPending[ControllerId] = 0U;
+
+    CanIf_ExitCritical(PriMask);
+}
+#endif
+
+#if (CAN_RX_FILTER_API == STD_ON)
+/**
+ * @brief   Programs the hardware filters of every controller from the Rx PDU table
+ * @details HRHs with software filtering request exactly the CAN IDs of their Rx PDUs, all other
+ *          HRHs request their configured CAN ID range. The CAN ID of an Rx PDU is received
+ *          through the HRH of its controller that serves the priority class of the PDU, so high
+ *          priority PDUs get their own hardware FIFO. If the list cannot be compiled the CAN
+ *          driver keeps its accept-all filter and software filtering alone selects the PDUs.
+ */
+static void CanIf_ConfigureRxFilters(void)
+{
+    Can_FilterIdType FilterIdList[CANIF_CFG_MAX_RX_PDUS + CANIF_CFG_MAX_RX_HRHS];
+    const CanIf_CtrlConfigType* CtrlConfig;
+    const CanIf_HrhConfigType* HrhConfig;
+    const CanIf_RxPduConfigType* RxPduConfig;
+    uint16 IdCount;
+    uint8 ControllerIndex;
+    uint8 HrhIndex;
+    PduIdType PduIndex;
+
+    for (ControllerIndex = 0U; ControllerIndex <= CanIf_ConfigPtr_Local->CanIfMaxCtrlId; ControllerIndex++)
+    {
+        CtrlConfig = &CanIf_ConfigPtr_Local->CanIfCtrlConfig[ControllerIndex];
+        IdCount = 0U;
+
+        for (HrhIndex = CtrlConfig->FirstHrhIndex; HrhIndex < (CtrlConfig->FirstHrhIndex + CtrlConfig->HrhCount); HrhIndex++)
+        {
+            HrhConfig = &CanIf_ConfigPtr_Local->CanIfHrhConfig[HrhIndex];
+
+            if (HrhConfig->HrhSoftwareFilter == STD_ON)
+            {
+                for (PduIndex = 0U; PduIndex <= CanIf_ConfigPtr_Local->CanIfMaxRxPduId; PduIndex++)
+                {
+                    RxPduConfig = &CanIf_ConfigPtr_Local->CanIfRxPduConfig[PduIndex];
+                    if (RxPduConfig->RxPduHrhId != HrhIndex)
+                    {
+                        continue;
+                    }
+
+                    if (RxPduConfig->RxPduCanIdType == CANIF_EXTENDED)
+                    {
+                        FilterIdList[IdCount].CanId = RxPduConfig->RxPduCanId | CAN_ID_EXTENDED_FLAG;
+                        FilterIdList[IdCount].Mask = CAN_EXT_ID_MASK;
+                    }
+                    else
+                    {
+                        FilterIdList[IdCount].CanId = RxPduConfig->RxPduCanId;
+                        FilterIdList[IdCount].Mask = CAN_STD_ID_MASK;
+                    }
+                    FilterIdList[IdCount].Hrh = CanIf_GetRxLaneHoh(CtrlConfig, HrhConfig, RxPduConfig->RxPduPriority);
+                    IdCount++;
+                }
+            }
+            else
+            {
+                FilterIdList[IdCount].CanId = HrhConfig->HrhRangeConfig.HrhRangeBaseId;
+                if (HrhConfig->HrhRangeConfig.HrhRangeType == CANIF_EXTENDED)
+                {
+                    FilterIdList[IdCount].CanId |= CAN_ID_EXTENDED_FLAG;
+                }
+                FilterIdList[IdCount].Mask = HrhConfig->HrhRangeConfig.HrhRangeMask;
+                FilterIdList[IdCount].Hrh = HrhConfig->HohId;
+                IdCount++;
+            }
+        }
+
+        /* On failure the table is left empty and every frame takes the CAN ID search */
+        (void)Can_SetRxFilter(CtrlConfig->CanControllerId, FilterIdList, IdCount);
+        CanIf_BuildRxFmiTable(CtrlConfig);
+    }
+}
+
+/**
+ * @brief   Returns the hardware receive object for an Rx PDU of a given priority class
+ * @param[in] CtrlConfig - Controller of the PDU
+ * @param[in] HrhConfig - HRH the PDU is configured on
+ * @param[in] Priority - Priority class of the PDU
+ * @return  Can_HwHandleType - HOH of the first HRH of the controller serving Priority, the HOH of
+ *          HrhConfig if there is none
+ */
+static Can_HwHandleType CanIf_GetRxLaneHoh(const CanIf_CtrlConfigType* CtrlConfig,
+                                           const CanIf_HrhConfigType* HrhConfig,
+                                           CanIf_RxPriorityType Priority)
+{
+    Can_HwHandleType Hoh = HrhConfig->HohId;
+    uint8 HrhIndex;
+
+    if (HrhConfig->HrhPriority != Priority)
+    {
+        for (HrhIndex = CtrlConfig->FirstHrhIndex; HrhIndex < (CtrlConfig->FirstHrhIndex + CtrlConfig->HrhCount); HrhIndex++)
+        {
+            if (CanIf_ConfigPtr_Local->CanIfHrhConfig[HrhIndex].HrhPriority == Priority)
+            {
+                Hoh = CanIf_ConfigPtr_Local->CanIfHrhConfig[HrhIndex].HohId;
+                break;
+            }
+        }
+    }
+
+    return Hoh;
+}
+
+/**
+ * @brief   Maps the filter match indices of a controller to Rx PDUs
+ * @details A filter element that accepts exactly one CAN ID identifies its Rx PDU, so
+ *          CanIf_RxIndication dispatches such frames by table lookup. Masked elements and
+ *          indices beyond the compiled banks keep CANIF_INVALID_PDU_ID and fall back to the
+ *          CAN ID search.
+ */
+static void CanIf_BuildRxFmiTable(const CanIf_CtrlConfigType* CtrlConfig)
+{
+    Can_FilterIdType Element;
+    Can_HwHandleType Hrh;
+    uint8 Fifo;
+    uint8 Fmi;
+
+    for (Fifo = 0U; Fifo < CANIF_RX_FIFO_COUNT; Fifo++)
+    {
+        Hrh = (Can_HwHandleType)(CAN_HRH_0 + Fifo);
+
+        for (Fmi = 0U; Fmi < CANIF_RX_FMI_COUNT; Fmi++)
+        {
+            CanIf_RxFmiTable[CtrlConfig->ControllerId][Fifo][Fmi] = CANIF_INVALID_PDU_ID;
+        }
+
+        for (Fmi = 0U; Fmi < CANIF_RX_FMI_COUNT; Fmi++)
+        {
+            if (Can_GetRxFilterElement(CtrlConfig->CanControllerId, Hrh, Fmi, &Element) != E_OK)
+            {
+                break;
+            }
+
+            if (Element.Mask == (((Element.CanId & CAN_ID_EXTENDED_FLAG) != 0U) ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK))
+            {
+                CanIf_RxFmiTable[CtrlConfig->ControllerId][Fifo][Fmi] =
+                    CanIf_FindRxPduByCanId(Element.CanId, CtrlConfig->ControllerId);
+            }
+        }
+    }
 }
+#endif
 
 /*==================================================================================================
 *                                       GLOBAL FUNCTIONS
@@ -331,6 +1497,27 @@ void CanIf_Init(const CanIf_ConfigType* ConfigPtr)
     /* Initialize notification status and buffers */
     CanIf_InitializeNotificationStatus();
     CanIf_InitializeBuffers();
+
+#if (CANIF_PRIVATE_SOFTWARE_FILTER == STD_ON)
+    /* Index the Rx PDUs for software filtering */
+    CanIf_BuildRxLookup();
+#endif
+
+#if (CAN_RX_FILTER_API == STD_ON)
+    /* Narrow the hardware acceptance filters to the configured Rx PDUs */
+    CanIf_ConfigureRxFilters();
+#endif
+
+#if (CANIF_STATISTICS_API == STD_ON)
+    CanIf_StatsInit();
+#endif
+
+#if (((CANIF_RX_DEFERRED_SUPPORT == STD_ON) && (CANIF_RX_DEFERRED_CYCLE_BUDGET > 0U)) || \
+     (CANIF_STATISTICS_API == STD_ON))
+    /* Cycle counter for the deferred Rx budget and the Tx latency */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
     
     /* Set module state to initialized */
     CanIf_ModuleState = CANIF_INIT;
@@ -425,9 +1612,18 @@ Std_ReturnType CanIf_SetControllerMode(uint8 ControllerId, CanIf_ControllerModeT
 #endif
             return E_NOT_OK;
     }
-    
+
     /* Call CAN driver */
     RetVal = Can_SetControllerMode(CanIf_ConfigPtr_Local->CanIfCtrlConfig[ControllerId].CanControllerId, CanControllerMode);
+
+#if (CANIF_TX_BUFFERING == STD_ON)
+    /* Buffered L-PDUs are not sent once the controller is stopped. A refused transition, such as
+       STOPPED during a bus-off recovery, keeps them along with the frames of the driver. */
+    if ((ControllerMode != CANIF_CS_STARTED) && (E_OK == RetVal))
+    {
+        CanIf_TxBufferClear(ControllerId);
+    }
+#endif
     
     return RetVal;
 }
@@ -548,6 +1744,13 @@ Std_ReturnType CanIf_SetPduMode(uint8 ControllerId, CanIf_PduModeType PduModeReq
         /* Set PDU channel mode */
         CanIf_PduChannelModes[ControllerId] = PduModeRequest;
         RetVal = E_OK;
+
+#if (CANIF_TX_BUFFERING == STD_ON)
+        if ((PduModeRequest == CANIF_OFFLINE) || (PduModeRequest == CANIF_TX_OFFLINE))
+        {
+            CanIf_TxBufferClear(ControllerId);
+        }
+#endif
     }
     else
     {
@@ -607,6 +1810,11 @@ Std_ReturnType CanIf_Transmit(PduIdType TxPduId, const PduInfoType* PduInfoPtr)
     const CanIf_TxPduConfigType* TxPduConfig;
     Can_PduType CanPduInfo;
     uint8 ControllerId;
+#if (CANIF_STATISTICS_API == STD_ON)
+    Std_ReturnType DriverRetVal;
+    uint32 NoDataDropCount;
+    boolean Timed;
+#endif
     
 #if (CANIF_DEV_ERROR_DETECT == STD_ON)
     /* Check if module is initialized */
@@ -652,6 +1860,15 @@ Std_ReturnType CanIf_Transmit(PduIdType TxPduId, const PduInfoType* PduInfoPtr)
         CanPduInfo.swPduHandle = TxPduId;
         CanPduInfo.length = (uint8)PduInfoPtr->SduLength;
         CanPduInfo.sdu = PduInfoPtr->SduDataPtr;
+
+#if (CANIF_TRIGGER_TRANSMIT_SUPPORT == STD_ON)
+        /* Only a mailbox is reserved; the driver fetches the data with CanIf_TriggerTransmit */
+        if (TxPduConfig->TxPduTriggerTransmit == STD_ON)
+        {
+            CanPduInfo.length = TxPduConfig->TxPduDlc;
+            CanPduInfo.sdu = NULL_PTR;
+        }
+#endif
         
 #if (CANIF_SET_DYNAMIC_TX_ID_API == STD_ON)
         /* Check if PDU has dynamic CAN ID */
@@ -665,23 +1882,34 @@ Std_ReturnType CanIf_Transmit(PduIdType TxPduId, const PduInfoType* PduInfoPtr)
             CanPduInfo.id = TxPduConfig->TxPduCanId;
         }
         
+#if (CANIF_STATISTICS_API == STD_ON)
+        Timed = CanIf_StatsTxStart(TxPduId);
+        NoDataDropCount = CanIf_TxPduStatistics[TxPduId].NoDataDropCount;
+#endif
+
         /* Call CAN driver */
-        RetVal = Can_Write(CanIf_ConfigPtr_Local->CanIfHthConfig[TxPduConfig->TxPduHthId].HohId, &CanPduInfo);
-        
-#if (CANIF_CFG_TX_BUFFER_SIZE > 0U)
-        /* Store data in Tx buffer if needed */
-        if (E_OK == RetVal)
+        RetVal = CanIf_WriteCanPdu(CanIf_ConfigPtr_Local->CanIfHthConfig[TxPduConfig->TxPduHthId].HohId, &CanPduInfo);
+#if (CANIF_STATISTICS_API == STD_ON)
+        DriverRetVal = RetVal;
+#endif
+
+#if (CANIF_TX_BUFFERING == STD_ON)
+        /* The driver has no room left: keep the L-PDU until a Tx confirmation frees one */
+        if (CAN_BUSY == RetVal)
         {
-            uint8 DataIndex;
-            for (DataIndex = 0U; DataIndex < PduInfoPtr->SduLength; DataIndex++)
-            {
-                CanIf_TxBuffer[TxPduId][DataIndex] = PduInfoPtr->SduDataPtr[DataIndex];
-            }
+            RetVal = CanIf_TxBufferStore(TxPduConfig->TxPduHthId, &CanPduInfo);
         }
 #endif
+
+#if (CANIF_STATISTICS_API == STD_ON)
+        CanIf_StatsTxEnd(TxPduId, Timed, DriverRetVal, RetVal, NoDataDropCount);
+#endif
     }
     else
     {
+#if (CANIF_STATISTICS_API == STD_ON)
+        CanIf_TxPduStatistics[TxPduId].OfflineDropCount++;
+#endif
 #if (CANIF_DEV_ERROR_DETECT == STD_ON)
         Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_TRANSMIT, CANIF_E_STOPPED);
 #endif
@@ -698,6 +1926,7 @@ Std_ReturnType CanIf_CancelTxRequest(PduIdType TxPduId)
 {
     Std_ReturnType RetVal = E_NOT_OK;
     const CanIf_TxPduConfigType* TxPduConfig;
+    uint32 PriMask;
     
 #if (CANIF_DEV_ERROR_DETECT == STD_ON)
     /* Check if module is initialized */
@@ -717,11 +1946,34 @@ Std_ReturnType CanIf_CancelTxRequest(PduIdType TxPduId)
 
     /* Get Tx PDU configuration */
     TxPduConfig = &CanIf_ConfigPtr_Local->CanIfTxPduConfig[TxPduId];
-    
-    /* Cancel transmission in CAN driver - not supported in basic CAN driver */
-    /* This would require extended CAN driver API */
-    RetVal = E_NOT_OK;
-    
+
+    /* CanIf buffer first, so that no Tx confirmation can move a request into the driver between
+       the two steps */
+    PriMask = CanIf_EnterCritical();
+
+#if (CANIF_TX_BUFFERING == STD_ON)
+    if (CanIf_TxBufferRemove(TxPduConfig->TxPduHthId, TxPduId) == TRUE)
+    {
+        RetVal = E_OK;
+    }
+#endif
+
+#if (CAN_CANCEL_TX_API == STD_ON)
+    /* Driver buffer and mailbox; an aborted mailbox ends with CanIf_CancelTxConfirmation */
+    if (Can_CancelTx(CanIf_ConfigPtr_Local->CanIfHthConfig[TxPduConfig->TxPduHthId].HohId, TxPduId) == E_OK)
+    {
+        RetVal = E_OK;
+#if (CANIF_STATISTICS_API == STD_ON)
+        /* Only aborted mailboxes are left of the L-PDU, each ends with a confirmation */
+        CanIf_TxPduStatistics[TxPduId].Outstanding =
+            Can_GetTxMailboxCount(CanIf_ConfigPtr_Local->CanIfHthConfig[TxPduConfig->TxPduHthId].HohId, TxPduId);
+        CanIf_TxPduStatistics[TxPduId].Timing = FALSE;
+#endif
+    }
+#endif
+
+    CanIf_ExitCritical(PriMask);
+
     return RetVal;
 }
 #endif
@@ -735,6 +1987,10 @@ Std_ReturnType CanIf_CancelTxRequest(PduIdType TxPduId)
 Std_ReturnType CanIf_ReadRxPduData(PduIdType CanRxPduId, PduInfoType* PduInfoPtr)
 {
     Std_ReturnType RetVal = E_NOT_OK;
+    const CanIf_RxBufferType* Buffer;
+    PduLengthType Length;
+    uint32 Sequence;
+    uint8 Slot;
     uint8 DataIndex;
     
 #if (CANIF_DEV_ERROR_DETECT == STD_ON)
@@ -770,14 +2026,24 @@ Std_ReturnType CanIf_ReadRxPduData(PduIdType CanRxPduId, PduInfoType* PduInfoPtr
     /* Check if read data API is enabled for this PDU */
     if (CanIf_ConfigPtr_Local->CanIfRxPduConfig[CanRxPduId].RxPduReadData == STD_ON)
     {
-        /* Copy data from Rx buffer */
-        PduInfoPtr->SduLength = CanIf_RxBufferLength[CanRxPduId];
-        
-        for (DataIndex = 0U; DataIndex < CanIf_RxBufferLength[CanRxPduId]; DataIndex++)
+        Buffer = &CanIf_RxBuffer[CanRxPduId];
+
+        /* Copy the current slot without locking. The writer only touches it once it has
+           published the other slot, so an unchanged Sequence proves the copy is not torn. */
+        do
         {
-            PduInfoPtr->SduDataPtr[DataIndex] = CanIf_RxBuffer[CanRxPduId][DataIndex];
-        }
-        
+            Sequence = Buffer->Sequence;
+            __DMB();
+            Slot = (uint8)(Sequence & 1U);
+            Length = Buffer->Length[Slot];
+            for (DataIndex = 0U; DataIndex < Length; DataIndex++)
+            {
+                PduInfoPtr->SduDataPtr[DataIndex] = Buffer->Data[Slot][DataIndex];
+            }
+            __DMB();
+        } while (Buffer->Sequence != Sequence);
+
+        PduInfoPtr->SduLength = Length;
         RetVal = E_OK;
     }
     
@@ -936,6 +2202,97 @@ Std_ReturnType CanIf_SetBaudrate(uint8 ControllerId, uint16 BaudRateConfigID)
 }
 #endif
 
+/*======================== Services for Statistics ============================*/
+
+/**
+ * @brief   Dumps the CanIf statistics as a compact binary snapshot
+ */
+#if (CANIF_STATISTICS_API == STD_ON)
+Std_ReturnType CanIf_GetStatisticsSnapshot(uint8* BufferPtr, uint16* LengthPtr)
+{
+    CanIf_TxPduStatisticsType TxStats;
+    CanIf_RxPduStatisticsType RxStats;
+    CanIf_CtrlStatisticsType CtrlStats;
+    uint8* Next = BufferPtr;
+    uint32 PriMask;
+    PduIdType PduIndex;
+    uint8 ControllerIndex;
+    uint8 Bucket;
+
+#if (CANIF_DEV_ERROR_DETECT == STD_ON)
+    /* Check if module is initialized */
+    if (FALSE == CanIf_IsInitialized())
+    {
+        Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_GET_STATISTICS_SNAPSHOT, CANIF_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    /* Check pointers */
+    if ((NULL_PTR == BufferPtr) || (NULL_PTR == LengthPtr))
+    {
+        Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_GET_STATISTICS_SNAPSHOT, CANIF_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    /* The worst case fits, so the encoding needs no bounds checks */
+    if (*LengthPtr < CANIF_STATISTICS_SNAPSHOT_SIZE)
+    {
+        return E_NOT_OK;
+    }
+
+    *Next++ = CANIF_STATISTICS_SNAPSHOT_VERSION;
+    *Next++ = (uint8)(CanIf_ConfigPtr_Local->CanIfMaxCtrlId + 1U);
+    *Next++ = (uint8)(CanIf_ConfigPtr_Local->CanIfMaxTxPduId + 1U);
+    *Next++ = (uint8)(CanIf_ConfigPtr_Local->CanIfMaxRxPduId + 1U);
+    *Next++ = CANIF_STATISTICS_LATENCY_BUCKETS;
+    *Next++ = CANIF_STATISTICS_LATENCY_SHIFT;
+
+    for (ControllerIndex = 0U; ControllerIndex <= CanIf_ConfigPtr_Local->CanIfMaxCtrlId; ControllerIndex++)
+    {
+        PriMask = CanIf_EnterCritical();
+        CtrlStats = CanIf_CtrlStatistics[ControllerIndex];
+        CanIf_ExitCritical(PriMask);
+
+        Next = CanIf_StatsPut(Next, CtrlStats.OfflineDropCount);
+        Next = CanIf_StatsPut(Next, CtrlStats.UnknownIdCount);
+    }
+
+    for (PduIndex = 0U; PduIndex <= CanIf_ConfigPtr_Local->CanIfMaxTxPduId; PduIndex++)
+    {
+        PriMask = CanIf_EnterCritical();
+        TxStats = CanIf_TxPduStatistics[PduIndex];
+        CanIf_ExitCritical(PriMask);
+
+        Next = CanIf_StatsPut(Next, TxStats.RequestCount);
+        Next = CanIf_StatsPut(Next, TxStats.ConfirmationCount);
+        Next = CanIf_StatsPut(Next, TxStats.OfflineDropCount);
+        Next = CanIf_StatsPut(Next, TxStats.BufferFullDropCount);
+        Next = CanIf_StatsPut(Next, TxStats.RejectedCount);
+        Next = CanIf_StatsPut(Next, TxStats.NoDataDropCount);
+        Next = CanIf_StatsPut(Next, TxStats.LatencyMax);
+        for (Bucket = 0U; Bucket < CANIF_STATISTICS_LATENCY_BUCKETS; Bucket++)
+        {
+            Next = CanIf_StatsPut(Next, TxStats.Latency[Bucket]);
+        }
+    }
+
+    for (PduIndex = 0U; PduIndex <= CanIf_ConfigPtr_Local->CanIfMaxRxPduId; PduIndex++)
+    {
+        PriMask = CanIf_EnterCritical();
+        RxStats = CanIf_RxPduStatistics[PduIndex];
+        CanIf_ExitCritical(PriMask);
+
+        Next = CanIf_StatsPut(Next, RxStats.IndicationCount);
+        Next = CanIf_StatsPut(Next, RxStats.QueueFullDropCount);
+    }
+
+    *LengthPtr = (uint16)(Next - BufferPtr);
+
+    return E_OK;
+}
+#endif
+
 /*=============================== Callback Functions ==================================*/
 
 /**
@@ -943,10 +2300,6 @@ Std_ReturnType CanIf_SetBaudrate(uint8 ControllerId, uint16 BaudRateConfigID)
  */
 void CanIf_RxIndication(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr)
 {
-    PduIdType RxPduId;
-    uint8 ControllerId;
-    const CanIf_RxPduConfigType* RxPduConfig;
-    
 #if (CANIF_DEV_ERROR_DETECT == STD_ON)
     /* Check if module is initialized */
     if (FALSE == CanIf_IsInitialized())
@@ -963,48 +2316,90 @@ void CanIf_RxIndication(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr
     }
 #endif
 
-    /* Find controller ID from HRH */
-    ControllerId = CanIf_ConfigPtr_Local->CanIfHrhConfig[Mailbox->Hoh].ControllerId;
-    
-    /* Check PDU mode */
-    if ((CanIf_PduChannelModes[ControllerId] == CANIF_ONLINE) || 
-        (CanIf_PduChannelModes[ControllerId] == CANIF_TX_OFFLINE))
+    /* A controller without a CanIf configuration has no PDU mode or statistics entry */
+    if (E_NOT_OK == CanIf_ValidateControllerId(Mailbox->ControllerId))
     {
-        /* Find matching Rx PDU */
-        RxPduId = CanIf_FindRxPduByCanId(Mailbox->CanId, ControllerId);
-        
-        if (CANIF_INVALID_PDU_ID != RxPduId)
-        {
-            RxPduConfig = &CanIf_ConfigPtr_Local->CanIfRxPduConfig[RxPduId];
-            
-#if (CANIF_READ_RX_PDU_DATA_API == STD_ON)
-            /* Store data in Rx buffer if enabled */
-            if (RxPduConfig->RxPduReadData == STD_ON)
-            {
-                uint8 DataIndex;
-                CanIf_RxBufferLength[RxPduId] = PduInfoPtr->SduLength;
-                
-                for (DataIndex = 0U; DataIndex < PduInfoPtr->SduLength; DataIndex++)
-                {
-                    CanIf_RxBuffer[RxPduId][DataIndex] = PduInfoPtr->SduDataPtr[DataIndex];
-                }
-            }
+#if (CANIF_DEV_ERROR_DETECT == STD_ON)
+        Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_RX_INDICATION, CANIF_E_PARAM_CONTROLLERID);
 #endif
+        return;
+    }
 
-#if (CANIF_READ_RX_PDU_NOTIFY_STATUS_API == STD_ON)
-            /* Set notification status if enabled */
-            if (RxPduConfig->RxPduReadNotifyStatus == STD_ON)
-            {
-                CanIf_RxNotificationStatus[RxPduId] = CANIF_TX_RX_NOTIFICATION;
-            }
+    /* Hoh is a CAN driver handle, the controller is reported by the driver */
+    if (TRUE == CanIf_IsRxOnline(Mailbox->ControllerId))
+    {
+        CanIf_RxDispatch(Mailbox, PduInfoPtr, CanIf_GetRxFmiRow(Mailbox));
+    }
+#if (CANIF_STATISTICS_API == STD_ON)
+    else
+    {
+        CanIf_CtrlStatistics[Mailbox->ControllerId].OfflineDropCount++;
+    }
 #endif
+}
 
-            /* Call upper layer indication function */
-            if (NULL_PTR != RxPduConfig->RxPduUserRxIndicationUL)
-            {
-                RxPduConfig->RxPduUserRxIndicationUL(RxPduId, PduInfoPtr);
-            }
+/**
+ * @brief   Indicates the reception of several CAN Rx L-PDUs
+ */
+void CanIf_RxIndicationBatch(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr, uint16 Count)
+{
+    const PduIdType* FmiRow = NULL_PTR;
+    boolean Online = FALSE;
+    uint8 ControllerId = 0U;
+    Can_HwHandleType Hoh = 0U;
+    uint16 Index;
+
+#if (CANIF_DEV_ERROR_DETECT == STD_ON)
+    /* Check if module is initialized */
+    if (FALSE == CanIf_IsInitialized())
+    {
+        Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_RX_INDICATION_BATCH, CANIF_E_UNINIT);
+        return;
+    }
+
+    /* Check parameters */
+    if ((NULL_PTR == Mailbox) || (NULL_PTR == PduInfoPtr))
+    {
+        Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_RX_INDICATION_BATCH, CANIF_E_PARAM_POINTER);
+        return;
+    }
+#endif
+
+    for (Index = 0U; Index < Count; Index++)
+    {
+        /* A controller without a CanIf configuration has no PDU mode or statistics entry */
+        if (E_NOT_OK == CanIf_ValidateControllerId(Mailbox[Index].ControllerId))
+        {
+#if (CANIF_DEV_ERROR_DETECT == STD_ON)
+            Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_RX_INDICATION_BATCH,
+                            CANIF_E_PARAM_CONTROLLERID);
+#endif
+            continue;
+        }
+
+        /* PDU mode and dispatch row are looked up once per run of frames of one HRH */
+        if ((Index == 0U) || (Mailbox[Index].Hoh != Hoh) || (Mailbox[Index].ControllerId != ControllerId))
+        {
+            ControllerId = Mailbox[Index].ControllerId;
+            Hoh = Mailbox[Index].Hoh;
+            Online = CanIf_IsRxOnline(ControllerId);
+            FmiRow = CanIf_GetRxFmiRow(&Mailbox[Index]);
+        }
+
+        if (TRUE == Online)
+        {
+#if (CAN_GET_INGRESS_TIME_STAMP_API == STD_ON)
+            /* Can_GetIngressTimeStamp answers for this frame during its indication */
+            Can_SelectIngressFrame((uint8)Index);
+#endif
+            CanIf_RxDispatch(&Mailbox[Index], &PduInfoPtr[Index], FmiRow);
+        }
+#if (CANIF_STATISTICS_API == STD_ON)
+        else
+        {
+            CanIf_CtrlStatistics[ControllerId].OfflineDropCount++;
         }
+#endif
     }
 }
 
@@ -1014,6 +2409,9 @@ void CanIf_RxIndication(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr
 void CanIf_TxConfirmation(PduIdType CanTxPduId)
 {
     const CanIf_TxPduConfigType* TxPduConfig;
+#if (CANIF_TX_BUFFERING == STD_ON)
+    uint8 ControllerId;
+#endif
     
 #if (CANIF_DEV_ERROR_DETECT == STD_ON)
     /* Check if module is initialized */
@@ -1032,6 +2430,19 @@ void CanIf_TxConfirmation(PduIdType CanTxPduId)
 #endif
 
     TxPduConfig = &CanIf_ConfigPtr_Local->CanIfTxPduConfig[CanTxPduId];
+
+#if (CANIF_STATISTICS_API == STD_ON)
+    CanIf_StatsTxConfirm(CanTxPduId);
+#endif
+
+#if (CANIF_TX_BUFFERING == STD_ON)
+    /* The driver has room again: send buffered L-PDUs before the upper layer is notified */
+    ControllerId = CanIf_ConfigPtr_Local->CanIfHthConfig[TxPduConfig->TxPduHthId].ControllerId;
+    if (CanIf_TxBufferPending[ControllerId] != 0U)
+    {
+        CanIf_TxBufferDrain(ControllerId);
+    }
+#endif
     
     /* Check if Tx confirmation is enabled */
     if (TxPduConfig->TxPduTxConfirmation == STD_ON)
@@ -1052,6 +2463,118 @@ void CanIf_TxConfirmation(PduIdType CanTxPduId)
     }
 }
 
+#if (CANIF_CANCEL_TX_SUPPORT_API == STD_ON)
+/**
+ * @brief   Confirms the cancellation of a CAN TxPDU
+ */
+void CanIf_CancelTxConfirmation(PduIdType CanTxPduId)
+{
+    const CanIf_TxPduConfigType* TxPduConfig;
+#if (CANIF_TX_BUFFERING == STD_ON)
+    uint8 ControllerId;
+#endif
+
+#if (CANIF_DEV_ERROR_DETECT == STD_ON)
+    /* Check if module is initialized */
+    if (FALSE == CanIf_IsInitialized())
+    {
+        Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_CANCEL_TX_CONFIRMATION, CANIF_E_UNINIT);
+        return;
+    }
+
+    /* Validate Tx PDU ID */
+    if (E_NOT_OK == CanIf_ValidateTxPduId(CanTxPduId))
+    {
+        Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_CANCEL_TX_CONFIRMATION, CANIF_E_INVALID_TX_PDU_ID);
+        return;
+    }
+#endif
+
+    TxPduConfig = &CanIf_ConfigPtr_Local->CanIfTxPduConfig[CanTxPduId];
+
+#if (CANIF_STATISTICS_API == STD_ON)
+    CanIf_StatsTxDrop(CanTxPduId, 1U);
+#endif
+
+#if (CANIF_TX_BUFFERING == STD_ON)
+    /* The aborted mailbox is free again */
+    ControllerId = CanIf_ConfigPtr_Local->CanIfHthConfig[TxPduConfig->TxPduHthId].ControllerId;
+    if (CanIf_TxBufferPending[ControllerId] != 0U)
+    {
+        CanIf_TxBufferDrain(ControllerId);
+    }
+#endif
+
+    /* Call upper layer cancellation confirmation function */
+    if (NULL_PTR != TxPduConfig->TxPduUserCancelTxConfirmationUL)
+    {
+        TxPduConfig->TxPduUserCancelTxConfirmationUL(CanTxPduId);
+    }
+}
+#endif
+
+#if (CANIF_TRIGGER_TRANSMIT_SUPPORT == STD_ON)
+/**
+ * @brief   Requests the payload of a trigger transmit L-PDU
+ */
+Std_ReturnType CanIf_TriggerTransmit(PduIdType TxPduId, PduInfoType* PduInfoPtr)
+{
+    const CanIf_TxPduConfigType* TxPduConfig;
+    Std_ReturnType RetVal = E_NOT_OK;
+    PduLengthType Available;
+
+#if (CANIF_DEV_ERROR_DETECT == STD_ON)
+    /* Check if module is initialized */
+    if (FALSE == CanIf_IsInitialized())
+    {
+        Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_TRIGGER_TRANSMIT, CANIF_E_UNINIT);
+        return E_NOT_OK;
+    }
+
+    /* Validate Tx PDU ID */
+    if (E_NOT_OK == CanIf_ValidateTxPduId(TxPduId))
+    {
+        Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_TRIGGER_TRANSMIT, CANIF_E_INVALID_TX_PDU_ID);
+        return E_NOT_OK;
+    }
+
+    /* Check if PduInfoPtr and its buffer are not NULL */
+    if ((NULL_PTR == PduInfoPtr) || (NULL_PTR == PduInfoPtr->SduDataPtr))
+    {
+        Det_ReportError(CANIF_MODULE_ID, CANIF_INSTANCE_ID, CANIF_SID_TRIGGER_TRANSMIT, CANIF_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+#endif
+
+    TxPduConfig = &CanIf_ConfigPtr_Local->CanIfTxPduConfig[TxPduId];
+    Available = PduInfoPtr->SduLength;
+
+    /* The upper layer copies its latest data straight to the buffer of the driver */
+    if ((TxPduConfig->TxPduTriggerTransmit == STD_ON) && (NULL_PTR != TxPduConfig->TxPduUserTriggerTransmitUL))
+    {
+        RetVal = TxPduConfig->TxPduUserTriggerTransmitUL(TxPduId, PduInfoPtr);
+        if (PduInfoPtr->SduLength > Available)
+        {
+            RetVal = E_NOT_OK;
+        }
+    }
+
+    /* The driver drops the frame and no confirmation follows: the request ends here */
+    if (E_OK != RetVal)
+    {
+#if (CANIF_TX_BUFFERING == STD_ON)
+        CanIf_TxNoData = TRUE;
+#endif
+#if (CANIF_STATISTICS_API == STD_ON)
+        CanIf_TxPduStatistics[TxPduId].NoDataDropCount++;
+        CanIf_StatsTxDrop(TxPduId, 1U);
+#endif
+    }
+
+    return RetVal;
+}
+#endif
+
 /**
  * @brief   Indicates a controller state transition referring to the corresponding CAN controller
  */
@@ -1080,10 +2603,23 @@ void CanIf_ControllerModeIndication(uint8 ControllerId, CanIf_ControllerModeType
     if (ControllerMode == CANIF_CS_STARTED)
     {
         CanIf_PduChannelModes[ControllerId] = CANIF_ONLINE;
+#if (CANIF_TX_BUFFERING == STD_ON)
+        /* L-PDUs kept across a bus-off go behind the frames the driver has refilled */
+        if (CanIf_TxBufferPending[ControllerId] != 0U)
+        {
+            CanIf_TxBufferDrain(ControllerId);
+        }
+#endif
     }
     else
     {
         CanIf_PduChannelModes[ControllerId] = CANIF_OFFLINE;
+#if (CANIF_TX_BUFFERING == STD_ON)
+        CanIf_TxBufferClear(ControllerId);
+#endif
+#if (CANIF_STATISTICS_API == STD_ON)
+        CanIf_StatsTxStop(ControllerId);
+#endif
     }
 }
 
@@ -1113,6 +2649,9 @@ void CanIf_ControllerBusOff(uint8 ControllerId)
     
     /* Set PDU mode to offline */
     CanIf_PduChannelModes[ControllerId] = CANIF_OFFLINE;
+
+    /* Like the frames of the driver, buffered L-PDUs are kept until the recovery, which ends
+       with CanIf_ControllerModeIndication(CANIF_CS_STARTED) */
 }
 
 /*=============================== Scheduled Functions ====================================*/
@@ -1122,12 +2661,14 @@ void CanIf_ControllerBusOff(uint8 ControllerId)
  */
 void CanIf_MainFunction(void)
 {
-    /* This function would handle periodic tasks like:
-     * - Wakeup validation
-     * - Mode change handling
-     * - Error handling
-     * - Buffer management
-     * 
-     * For this basic implementation, no periodic processing is needed
-     */
+    /* Called from the scheduler before and after the module is initialized */
+    if (FALSE == CanIf_IsInitialized())
+    {
+        return;
+    }
+
+#if (CANIF_RX_DEFERRED_SUPPORT == STD_ON)
+    /* Rx indications deferred from the reception context */
+    CanIf_RxDeferredProcess();
+#endif
 }
@@ -96,9 +96,13 @@ extern "C" {
 #define CANIF_SID_SET_TRANSCEIVER_WAKEUP_MODE   (0x11U)
 #define CANIF_SID_SET_BAUDRATE                  (0x27U)
 #define CANIF_SID_CONTROLLER_BUSOFF             (0x16U)
+#define CANIF_SID_CANCEL_TX_CONFIRMATION        (0x15U)
 #define CANIF_SID_RX_INDICATION                 (0x14U)
+#define CANIF_SID_RX_INDICATION_BATCH           (0x80U)
 #define CANIF_SID_TX_CONFIRMATION               (0x13U)
+#define CANIF_SID_TRIGGER_TRANSMIT              (0x41U)
 #define CANIF_SID_CONTROLLER_MODE_INDICATION    (0x17U)
+#define CANIF_SID_GET_STATISTICS_SNAPSHOT       (0x81U)
 
 /* DET Error Codes */
 #define CANIF_E_PARAM_CANID                     (0x01U)
@@ -121,6 +125,7 @@ extern "C" {
 #define CANIF_E_STOPPED                         (0x70U)
 #define CANIF_E_NOT_SLEEP                       (0x71U)
 #define CANIF_E_WAKEUP_VALIDATION               (0x72U)
+#define CANIF_E_RX_DEFERRED_QUEUE_FULL          (0x80U)
 
 /*==================================================================================================
 *                                             ENUMS
@@ -259,11 +264,15 @@ Std_ReturnType CanIf_Transmit(PduIdType TxPduId, const PduInfoType* PduInfoPtr);
 
 /**
  * @brief   Cancels the transmission request
- * @details This service cancels a pending transmission request.
+ * @details This service cancels a pending transmission request. Requests in the CanIf and driver
+ *          Tx buffers are dropped at once; a frame already in a mailbox is aborted and ends with
+ *          <User_CancelTxConfirmation>, or with <User_TxConfirmation> if it was already on the
+ *          bus. A CanIf_Transmit that follows is not held back by the stale frame: it takes the
+ *          mailbox as soon as the abort completes.
  * @param[in] TxPduId - L-PDU handle of CAN L-PDU to be cancelled
  * @return  Std_ReturnType
  *          E_OK: Cancellation request has been accepted
- *          E_NOT_OK: Cancellation request has not been accepted
+ *          E_NOT_OK: Cancellation request has not been accepted, no request of the L-PDU pending
  * @note    Synchronous, Reentrant
  * SWS_CANIF_00101
  */
@@ -276,6 +285,9 @@ Std_ReturnType CanIf_CancelTxRequest(PduIdType TxPduId);
 /**
  * @brief   Provides the Data Length and the received data of the requested CanRxPduId
  * @details This service provides the CAN DLC and the received data of the CAN L-PDU specified by CanRxPduId.
+ *          The data and length always belong to one reception, also when a new frame is indicated
+ *          during the copy. Interrupts stay enabled: the copy is repeated if a reception was
+ *          published meanwhile, and the Rx indication never waits for a reader.
  * @param[in] CanRxPduId - L-PDU handle of CAN L-PDU to be received
  * @param[out] PduInfoPtr - Pointer to a structure where the received CAN L-PDU related data will be stored
  * @return  Std_ReturnType
@@ -350,6 +362,51 @@ Std_ReturnType CanIf_SetDynamicTxId(PduIdType CanTxPduId, Can_IdType CanId);
 Std_ReturnType CanIf_SetBaudrate(uint8 ControllerId, uint16 BaudRateConfigID);
 #endif
 
+/*======================== Services for Statistics ============================*/
+
+#if (CANIF_STATISTICS_API == STD_ON)
+/**
+ * @brief   Snapshot format version, first byte of the snapshot
+ */
+#define CANIF_STATISTICS_SNAPSHOT_VERSION       (2U)
+
+/**
+ * @brief   Largest snapshot of the configuration, every counter at its longest encoding
+ */
+#define CANIF_STATISTICS_SNAPSHOT_SIZE \
+    (6U + (5U * ((2U * CANIF_CFG_MAX_CONTROLLERS) + \
+                 ((7U + CANIF_STATISTICS_LATENCY_BUCKETS) * CANIF_CFG_MAX_TX_PDUS) + \
+                 (2U * CANIF_CFG_MAX_RX_PDUS))))
+#endif
+
+/**
+ * @brief   Dumps the CanIf statistics as a compact binary snapshot
+ * @details Header of six bytes: CANIF_STATISTICS_SNAPSHOT_VERSION, number of controllers, Tx PDUs
+ *          and Rx PDUs, CANIF_STATISTICS_LATENCY_BUCKETS and CANIF_STATISTICS_LATENCY_SHIFT. Then
+ *          the counters since CanIf_Init, each an unsigned LEB128 (7 bits per byte, least
+ *          significant first, bit 7 set on all bytes but the last):
+ *          - per controller: Rx frames dropped offline, Rx frames of unknown CAN ID
+ *          - per Tx PDU: requests accepted, confirmations, requests refused offline, requests
+ *            refused for lack of buffer (CAN_BUSY), requests refused by the driver otherwise,
+ *            trigger transmit requests dropped without data, longest latency in cycles,
+ *            latency histogram
+ *          - per Rx PDU: indications, indications lost to a full deferred queue
+ *          The latency runs from a CanIf_Transmit of the PDU to the next CanIf_TxConfirmation,
+ *          in DWT_CYCCNT cycles. Only requests made while no other request of the PDU is
+ *          outstanding are timed.
+ *          Each PDU is copied under the critical section, the snapshot as a whole is not atomic.
+ * @param[out] BufferPtr - Snapshot
+ * @param[inout] LengthPtr - In: size of BufferPtr, at least CANIF_STATISTICS_SNAPSHOT_SIZE.
+ *                           Out: bytes written
+ * @return  Std_ReturnType
+ *          E_OK: Snapshot written
+ *          E_NOT_OK: Buffer too small or NULL pointer
+ * @note    Synchronous, Reentrant, vendor specific
+ */
+#if (CANIF_STATISTICS_API == STD_ON)
+Std_ReturnType CanIf_GetStatisticsSnapshot(uint8* BufferPtr, uint16* LengthPtr);
+#endif
+
 /*=============================== Callback Functions ==================================*/
 
 /**
@@ -365,6 +422,19 @@ Std_ReturnType CanIf_SetBaudrate(uint8 ControllerId, uint16 BaudRateConfigID);
  */
 void CanIf_RxIndication(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr);
 
+/**
+ * @brief   Indicates the reception of several CAN Rx L-PDUs
+ * @details Vendor specific. Same as calling CanIf_RxIndication for each frame in array order, but
+ *          the module state and the parameters are checked once per call, and the PDU mode and
+ *          the filter dispatch row once per run of consecutive frames of the same HRH. A PDU mode
+ *          change made from within an upper layer indication applies from the next run.
+ * @param[in] Mailbox - Count hardware objects of the received frames
+ * @param[in] PduInfoPtr - Count L-SDUs, one per entry of Mailbox
+ * @param[in] Count - Number of frames
+ * @note    Synchronous, Reentrant
+ */
+void CanIf_RxIndicationBatch(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr, uint16 Count);
+
 /**
  * @brief   Confirms the successful transmission of a CAN TxPDU
  * @details This service confirms a successful transmission of a CAN TxPDU in a CAN L-PDU.
@@ -374,6 +444,35 @@ void CanIf_RxIndication(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr
  */
 void CanIf_TxConfirmation(PduIdType CanTxPduId);
 
+/**
+ * @brief   Requests the payload of a trigger transmit L-PDU
+ * @details Called by the CAN driver when the mailbox reserved by CanIf_Transmit is loaded. The
+ *          <User_TriggerTransmit> of the L-PDU copies its latest data to the buffer.
+ * @param[in] TxPduId - L-PDU handle of the CAN L-PDU to be transmitted
+ * @param[inout] PduInfoPtr - Buffer (SduDataPtr) and its size (SduLength); SduLength returns the
+ *          number of bytes copied
+ * @return  Std_ReturnType
+ *          E_OK: Data copied
+ *          E_NOT_OK: No data available, the L-PDU is not transmitted
+ * @note    Synchronous, Reentrant
+ * SWS_CANIF_00883
+ */
+#if (CANIF_TRIGGER_TRANSMIT_SUPPORT == STD_ON)
+Std_ReturnType CanIf_TriggerTransmit(PduIdType TxPduId, PduInfoType* PduInfoPtr);
+#endif
+
+/**
+ * @brief   Confirms the cancellation of a CAN TxPDU
+ * @details Called by the CAN driver when a mailbox aborted for CanIf_CancelTxRequest was emptied
+ *          before the frame went on the bus.
+ * @param[in] CanTxPduId - L-PDU handle of the cancelled CAN L-PDU
+ * @note    Synchronous, Reentrant
+ * SWS_CANIF_00101
+ */
+#if (CANIF_CANCEL_TX_SUPPORT_API == STD_ON)
+void CanIf_CancelTxConfirmation(PduIdType CanTxPduId);
+#endif
+
 /**
  * @brief   Indicates a controller state transition referring to the corresponding CAN controller
  * @details This service indicates a controller state transition referring to the corresponding CAN controller
@@ -399,7 +498,10 @@ void CanIf_ControllerBusOff(uint8 ControllerId);
 /**
  * @brief   This service performs the main function of CanIf
  * @details This function performs the main function of the CanIf for processing mode changes,
- *          wakeup validation, and other periodic tasks.
+ *          wakeup validation, and other periodic tasks. With CANIF_RX_DEFERRED_SUPPORT it
+ *          dispatches the queued Rx indications of the bulk lane PDUs in reception order,
+ *          within CANIF_RX_DEFERRED_FRAME_BUDGET indications and CANIF_RX_DEFERRED_CYCLE_BUDGET
+ *          cycles per call; indications of a controller that is no longer online are dropped.
  * @note    Synchronous, Non-reentrant
  * SWS_CANIF_00001
  */
@@ -76,6 +76,17 @@ extern "C" {
  */
 extern void CanIf_RxIndication(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr);
 
+/**
+ * @brief   Indicates the reception of several CAN Rx L-PDUs
+ * @details Vendor specific batch form of CanIf_RxIndication, called by the CAN driver with the
+ *          frames of one Can_MainFunction_Read pass (CAN_RX_INDICATION_BATCH_SIZE).
+ * @param[in] Mailbox - Count hardware objects of the received frames
+ * @param[in] PduInfoPtr - Count L-SDUs, one per entry of Mailbox
+ * @param[in] Count - Number of frames
+ * @note    Synchronous, Reentrant
+ */
+extern void CanIf_RxIndicationBatch(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr, uint16 Count);
+
 /**
  * @brief   Confirms the successful transmission of a CAN TxPDU
  * @details This service confirms a successful transmission of a CAN TxPDU in a CAN L-PDU.
@@ -86,6 +97,26 @@ extern void CanIf_RxIndication(const Can_HwType* Mailbox, const PduInfoType* Pdu
  */
 extern void CanIf_TxConfirmation(PduIdType CanTxPduId);
 
+/**
+ * @brief   Requests the payload of a trigger transmit L-PDU
+ * @details Called by the CAN driver, with interrupts locked, when it loads the mailbox of a frame
+ *          written with sdu = NULL_PTR.
+ * @param[in] TxPduId - L-PDU handle of the CAN L-PDU to be transmitted
+ * @param[inout] PduInfoPtr - Buffer and its size; SduLength returns the number of bytes copied
+ * @note    Synchronous, Reentrant
+ * @requirements SWS_CANIF_00883
+ */
+extern Std_ReturnType CanIf_TriggerTransmit(PduIdType TxPduId, PduInfoType* PduInfoPtr);
+
+/**
+ * @brief   Confirms the cancellation of a CAN TxPDU
+ * @details Called by the CAN driver when a mailbox aborted with Can_CancelTx was emptied before
+ *          the frame went on the bus. The mailbox is free again.
+ * @param[in] CanTxPduId - L-PDU handle of the cancelled CAN L-PDU
+ * @note    Synchronous, Reentrant
+ */
+extern void CanIf_CancelTxConfirmation(PduIdType CanTxPduId);
+
 /**
  * @brief   Indicates a controller state transition referring to the corresponding CAN controller
  * @details This service indicates a controller state transition referring to the corresponding CAN controller
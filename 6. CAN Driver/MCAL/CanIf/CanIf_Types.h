@@ -120,7 +120,8 @@ typedef enum _CanIf_PduModeType
     CANIF_OFFLINE      = 0x00U,    /**< Transmit and receive path is offline */
     CANIF_TX_OFFLINE   = 0x01U,    /**< Transmit path is offline, receive path is online */
     CANIF_TX_ONLINE    = 0x02U,    /**< Transmit and receive path is online */
-    CANIF_ONLINE       = 0x02U     /**< Alias for CANIF_TX_ONLINE (backward compatibility) */
+    CANIF_ONLINE       = 0x02U,    /**< Alias for CANIF_TX_ONLINE (backward compatibility) */
+    CANIF_TX_OFFLINE_ACTIVE = 0x03U  /**< Transmit path is offline, transmit requests are confirmed */
 } CanIf_PduModeType;
 
 /**
@@ -137,14 +138,15 @@ typedef enum _CanIf_NotifStatusType
 
 /**
  * @brief   CanIf TX Buffer Mode Type
- * @details Defines the type of software filtering that is used for a hardware transmit object.
+ * @details How the TX buffer of a hardware transmit object keeps the L-PDUs the CAN driver could
+ *          not take (CAN_BUSY). Buffered L-PDUs are sent in arbitration order in both modes.
  * @note    Available via CanIf_Types.h
  * SWS_CANIF_00748
  */
 typedef enum _CanIf_TxBufferModeType
 {
-    CANIF_TX_BUFFER_SINGLE     = 0x00U,    /**< Single buffer per HTH */
-    CANIF_TX_BUFFER_FIFO       = 0x01U     /**< FIFO buffer per HTH */
+    CANIF_TX_BUFFER_SINGLE     = 0x00U,    /**< One buffer per L-PDU, a new request overwrites its data */
+    CANIF_TX_BUFFER_FIFO       = 0x01U     /**< Every request is kept, in request order per L-PDU */
 } CanIf_TxBufferModeType;
 
 /**
@@ -161,10 +163,76 @@ typedef enum _CanIf_PrivateSoftwareFilterType
     CANIF_PRIVATE_SW_FILTER_TABLE  = 0x03U     /**< Table software filtering */
 } CanIf_PrivateSoftwareFilterType;
 
+/**
+ * @brief   CanIf CAN ID Type
+ * @details Type of the CAN identifier of an L-PDU or of a hardware object.
+ * @note    Available via CanIf_Types.h
+ */
+typedef enum _CanIf_CanIdTypeType
+{
+    CANIF_STANDARD             = 0x00U,    /**< 11-bit standard CAN identifier */
+    CANIF_EXTENDED             = 0x01U     /**< 29-bit extended CAN identifier */
+} CanIf_CanIdTypeType;
+
+/**
+ * @brief   CanIf Rx Priority Type
+ * @details Reception lane of an Rx L-PDU or of a hardware receive object. High priority frames
+ *          are received through their own hardware FIFO, which has its own RX queue and a
+ *          higher interrupt priority in the CAN driver, so bulk traffic cannot delay or drop them.
+ * @note    Available via CanIf_Types.h
+ */
+typedef enum _CanIf_RxPriorityType
+{
+    CANIF_RX_PRIORITY_BULK     = 0x00U,    /**< Bulk and diagnostic traffic */
+    CANIF_RX_PRIORITY_HIGH     = 0x01U     /**< Control traffic that must not be lost */
+} CanIf_RxPriorityType;
+
+/**
+ * @brief   CanIf TX PDU Type
+ * @details Defines whether the CAN identifier of a Tx L-PDU can be changed at runtime.
+ * @note    Available via CanIf_Types.h
+ */
+typedef enum _CanIf_TxPduTypeType
+{
+    CANIF_STATIC               = 0x00U,    /**< CAN ID is fixed by configuration */
+    CANIF_DYNAMIC              = 0x01U     /**< CAN ID can be changed by CanIf_SetDynamicTxId */
+} CanIf_TxPduTypeType;
+
 /*==================================================================================================
 *                                STRUCTURES AND OTHER TYPEDEFS
 ==================================================================================================*/
 
+/**
+ * @brief   CanIf Upper Layer RX Indication Type
+ * @details Signature of the <User_RxIndication> callback of an Rx L-PDU.
+ */
+typedef void (*CanIf_UserRxIndicationType)(PduIdType RxPduId, const PduInfoType* PduInfoPtr);
+
+/**
+ * @brief   CanIf Upper Layer TX Confirmation Type
+ * @details Signature of the <User_TxConfirmation> callback of a Tx L-PDU.
+ */
+typedef void (*CanIf_UserTxConfirmationType)(PduIdType TxPduId);
+
+/**
+ * @brief   CanIf Upper Layer Trigger Transmit Type
+ * @details Signature of the <User_TriggerTransmit> callback of a Tx L-PDU. The callback copies at
+ *          most SduLength bytes to SduDataPtr and sets SduLength to the number copied.
+ */
+typedef Std_ReturnType (*CanIf_UserTriggerTransmitType)(PduIdType TxPduId, PduInfoType* PduInfoPtr);
+
+/**
+ * @brief   CanIf HRH Range Configuration Type
+ * @details CAN ID range accepted by a hardware receive object.
+ * @note    Available via CanIf_Types.h
+ */
+typedef struct _CanIf_HrhRangeConfigType
+{
+    Can_IdType                      HrhRangeBaseId;             /**< Base CAN ID of the range */
+    Can_IdType                      HrhRangeMask;               /**< CAN ID mask of the range */
+    CanIf_CanIdTypeType             HrhRangeType;               /**< CAN ID type of the range */
+} CanIf_HrhRangeConfigType;
+
 /**
  * @brief   CanIf HRH Configuration Type
  * @details Configuration of a hardware receive object (HRH).
@@ -173,11 +241,12 @@ typedef enum _CanIf_PrivateSoftwareFilterType
  */
 typedef struct _CanIf_HrhConfigType
 {
-    Can_HwHandleType                CanIfHrhIdSymRef;           /**< Hardware object handle */
-    uint8                          CanIfCanControllerIdRef;    /**< Reference to CAN controller */
-    CanIf_PrivateSoftwareFilterType CanIfHrhSoftwareFilter;    /**< Software filter type */
-    uint8                          CanIfHrhRangeRxPduLowerRef; /**< Lower bound of RX PDU range */
-    uint8                          CanIfHrhRangeRxPduUpperRef; /**< Upper bound of RX PDU range */
+    uint8                           ControllerId;               /**< CanIf controller the HRH belongs to */
+    uint8                           HrhId;                      /**< CanIf HRH identifier */
+    Can_HwHandleType                HohId;                      /**< Hardware object handle in the CAN driver */
+    CanIf_HrhRangeConfigType        HrhRangeConfig;             /**< Accepted CAN ID range */
+    uint8                           HrhSoftwareFilter;          /**< Software filtering STD_ON/STD_OFF */
+    CanIf_RxPriorityType            HrhPriority;                /**< Reception lane served by the HRH */
 } CanIf_HrhConfigType;
 
 /**
@@ -188,11 +257,12 @@ typedef struct _CanIf_HrhConfigType
  */
 typedef struct _CanIf_HthConfigType
 {
-    Can_HwHandleType            CanIfHthIdSymRef;           /**< Hardware object handle */
-    uint8                      CanIfCanControllerIdRef;    /**< Reference to CAN controller */
-    CanIf_TxBufferModeType     CanIfTxBufferMode;          /**< TX buffer mode */
-    uint8                      CanIfHthTxPduLowerRef;      /**< Lower bound of TX PDU range */
-    uint8                      CanIfHthTxPduUpperRef;      /**< Upper bound of TX PDU range */
+    uint8                           ControllerId;               /**< CanIf controller the HTH belongs to */
+    uint8                           HthId;                      /**< CanIf HTH identifier */
+    Can_HwHandleType                HohId;                      /**< Hardware object handle in the CAN driver */
+    CanIf_CanIdTypeType             HthCanIdType;               /**< CAN ID type transmitted on this HTH */
+    uint8                           TxBufferSize;               /**< L-PDUs buffered while the driver is busy, 0: none */
+    CanIf_TxBufferModeType          TxBufferMode;               /**< Overwrite or queue requests of an L-PDU */
 } CanIf_HthConfigType;
 
 /**
@@ -203,15 +273,22 @@ typedef struct _CanIf_HthConfigType
  */
 typedef struct _CanIf_TxPduConfigType
 {
-    PduIdType                  CanIfTxPduId;              /**< PDU identifier */
-    Can_IdType                 CanIfTxPduCanId;           /**< CAN identifier */
-    uint8                      CanIfTxPduCanIdType;       /**< CAN ID type (STANDARD/EXTENDED) */
-    uint8                      CanIfTxPduDlc;             /**< Data Length Code */
-    Can_HwHandleType           CanIfTxPduHthRef;          /**< Reference to HTH */
-    PduIdType                  CanIfTxPduUserTxConfirmationPduId;  /**< User TX confirmation PDU ID */
-    boolean                    CanIfTxPduReadNotifyStatus; /**< Read notify status enabled */
-    boolean                    CanIfTxPduTriggerTransmit;  /**< Trigger transmit enabled */
-    boolean                    CanIfTxPduTxConfirmation;   /**< TX confirmation enabled */
+    PduIdType                       TxPduId;                    /**< PDU identifier */
+    Can_IdType                      TxPduCanId;                 /**< CAN identifier */
+    CanIf_CanIdTypeType             TxPduCanIdType;             /**< CAN ID type (STANDARD/EXTENDED) */
+    uint8                           TxPduDlc;                   /**< Data Length Code */
+    uint8                           TxPduHthId;                 /**< Reference to CanIf HTH */
+    CanIf_UserTxConfirmationType    TxPduUserTxConfirmationUL;  /**< Upper layer TX confirmation */
+    const char*                     TxPduUserTxConfirmationName;/**< Upper layer TX confirmation name */
+    uint8                           TxPduTxConfirmation;        /**< TX confirmation STD_ON/STD_OFF */
+    uint8                           TxPduReadNotifyStatus;      /**< Read notify status STD_ON/STD_OFF */
+    uint8                           TxPduTriggerTransmit;       /**< Trigger transmit STD_ON/STD_OFF */
+    CanIf_UserTriggerTransmitType   TxPduUserTriggerTransmitUL; /**< Upper layer trigger transmit */
+    const char*                     TxPduUserTriggerTransmitName;/**< Upper layer trigger transmit name */
+    CanIf_UserTxConfirmationType    TxPduUserCancelTxConfirmationUL;  /**< Upper layer cancellation confirmation */
+    const char*                     TxPduUserCancelTxConfirmationName;/**< Upper layer cancellation confirmation name */
+    uint8                           TxPduTruncation;            /**< Truncation STD_ON/STD_OFF */
+    CanIf_TxPduTypeType             TxPduType;                  /**< Static or dynamic CAN ID */
 } CanIf_TxPduConfigType;
 
 /**
@@ -222,41 +299,36 @@ typedef struct _CanIf_TxPduConfigType
  */
 typedef struct _CanIf_RxPduConfigType
 {
-    PduIdType                  CanIfRxPduId;              /**< PDU identifier */
-    Can_IdType                 CanIfRxPduCanId;           /**< CAN identifier */
-    uint8                      CanIfRxPduCanIdType;       /**< CAN ID type (STANDARD/EXTENDED) */
-    uint8                      CanIfRxPduDlc;             /**< Data Length Code */
-    Can_HwHandleType           CanIfRxPduHrhRef;          /**< Reference to HRH */
-    PduIdType                  CanIfRxPduUserRxIndicationPduId;    /**< User RX indication PDU ID */
-    boolean                    CanIfRxPduReadData;        /**< Read data enabled */
-    boolean                    CanIfRxPduReadNotifyStatus; /**< Read notify status enabled */
+    PduIdType                       RxPduId;                    /**< PDU identifier */
+    Can_IdType                      RxPduCanId;                 /**< CAN identifier */
+    CanIf_CanIdTypeType             RxPduCanIdType;             /**< CAN ID type (STANDARD/EXTENDED) */
+    uint8                           RxPduDlc;                   /**< Data Length Code */
+    uint8                           RxPduHrhId;                 /**< Reference to CanIf HRH */
+    CanIf_UserRxIndicationType      RxPduUserRxIndicationUL;    /**< Upper layer RX indication */
+    const char*                     RxPduUserRxIndicationName;  /**< Upper layer RX indication name */
+    uint8                           RxPduReadNotifyStatus;      /**< Read notify status STD_ON/STD_OFF */
+    uint8                           RxPduReadData;              /**< Read data STD_ON/STD_OFF */
+    CanIf_RxPriorityType            RxPduPriority;              /**< Reception lane of the PDU */
 } CanIf_RxPduConfigType;
 
-/**
- * @brief   CanIf TX Buffer Configuration Type
- * @details Configuration structure for TX buffering.
- * @note    Available via CanIf_Types.h
- * SWS_CANIF_00754
- */
-typedef struct _CanIf_TxBufferConfigType
-{
-    Can_HwHandleType           CanIfBufferHthRef;         /**< Reference to HTH */
-    uint8                      CanIfBufferSize;           /**< Buffer size */
-} CanIf_TxBufferConfigType;
-
 /**
  * @brief   CanIf Controller Configuration Type
  * @details Configuration of CanIf controller.
  * @note    Available via CanIf_Types.h
  * SWS_CANIF_00755
  */
-typedef struct _CanIf_ControllerConfigType
+typedef struct _CanIf_CtrlConfigType
 {
-    uint8                      CanIfCtrlId;               /**< Controller identifier */
-    uint8                      CanIfCtrlCanCtrlRef;       /**< Reference to CAN controller */
-    boolean                    CanIfCtrlWakeupSupport;    /**< Wakeup support enabled */
-    uint32                     CanIfCtrlWakeupSource;     /**< Wakeup source identifier */
-} CanIf_ControllerConfigType;
+    uint8                           ControllerId;               /**< CanIf controller identifier */
+    uint8                           CanControllerId;            /**< Controller ID in the CAN driver */
+    uint8                           WakeupSupport;              /**< Wakeup support STD_ON/STD_OFF */
+    uint32                          WakeupSource;               /**< Wakeup source identifier */
+    uint16                          TxBufferCount;              /**< Number of TX buffers */
+    uint8                           FirstHthIndex;              /**< Index of the first HTH of the controller */
+    uint8                           HthCount;                   /**< Number of HTHs of the controller */
+    uint8                           FirstHrhIndex;              /**< Index of the first HRH of the controller */
+    uint8                           HrhCount;                   /**< Number of HRHs of the controller */
+} CanIf_CtrlConfigType;
 
 /**
  * @brief   CanIf Configuration Type
@@ -266,30 +338,22 @@ typedef struct _CanIf_ControllerConfigType
  */
 typedef struct _CanIf_ConfigType
 {
-    uint8                            ConfigSet;                /**< Configuration set identifier */
-    
-    /* Controller configuration */
-    const CanIf_ControllerConfigType* CanIfControllerConfig;   /**< Pointer to controller configuration array */
-    uint8                            CanIfMaxControllers;     /**< Number of controllers */
-    
-    /* Hardware object configuration */
-    const CanIf_HrhConfigType*       CanIfHrhConfig;          /**< Pointer to HRH configuration array */
-    uint8                            CanIfMaxHrhs;             /**< Number of HRHs */
-    
-    const CanIf_HthConfigType*       CanIfHthConfig;          /**< Pointer to HTH configuration array */
-    uint8                            CanIfMaxHths;             /**< Number of HTHs */
-    
-    /* PDU configuration */
-    const CanIf_TxPduConfigType*     CanIfTxPduConfig;        /**< Pointer to TX PDU configuration array */
-    uint8                            CanIfMaxTxPdus;          /**< Number of TX PDUs */
-    
-    const CanIf_RxPduConfigType*     CanIfRxPduConfig;        /**< Pointer to RX PDU configuration array */
-    uint8                            CanIfMaxRxPdus;          /**< Number of RX PDUs */
-    
-    /* Buffer configuration */
-    const CanIf_TxBufferConfigType*  CanIfTxBufferConfig;     /**< Pointer to TX buffer configuration array */
-    uint8                            CanIfMaxTxBuffers;       /**< Number of TX buffers */
-    
+    const CanIf_CtrlConfigType*     CanIfCtrlConfig;            /**< Controller configuration array */
+    uint8                           CanIfMaxCtrlId;             /**< Highest controller index */
+
+    const CanIf_HrhConfigType*      CanIfHrhConfig;             /**< HRH configuration array */
+    uint8                           CanIfMaxHrhId;              /**< Highest HRH index */
+
+    const CanIf_HthConfigType*      CanIfHthConfig;             /**< HTH configuration array */
+    uint8                           CanIfMaxHthId;              /**< Highest HTH index */
+
+    const CanIf_RxPduConfigType*    CanIfRxPduConfig;           /**< RX PDU configuration array */
+    PduIdType                       CanIfMaxRxPduId;            /**< Highest RX PDU index */
+
+    const CanIf_TxPduConfigType*    CanIfTxPduConfig;           /**< TX PDU configuration array */
+    PduIdType                       CanIfMaxTxPduId;            /**< Highest TX PDU index */
+
+    uint8                           CanIfConfigSet;             /**< Configuration set identifier */
 } CanIf_ConfigType;
 
 /*==================================================================================================
@@ -302,7 +366,6 @@ typedef struct _CanIf_ConfigType
 #define CANIF_MAX_HTHS                          (3U)       /**< Maximum number of HTHs */
 #define CANIF_MAX_TX_PDUS                       (20U)      /**< Maximum number of TX PDUs */
 #define CANIF_MAX_RX_PDUS                       (30U)      /**< Maximum number of RX PDUs */
-#define CANIF_MAX_TX_BUFFERS                    (10U)      /**< Maximum number of TX buffers */
 
 /*==================================================================================================
 *                              VALIDATION MACROS                                                  *
@@ -32,6 +32,51 @@ g_pfnVectors:
     .word   PendSV_Handler          /* 0x38: PendSV Handler */
     .word   SysTick_Handler         /* 0x3C: SysTick Handler */
 
+    /* Ngắt ngoại vi (IRQ 0 .. 42, tới USBWakeUp; TIM2 = IRQ 28 cho lịch TT của CAN) */
+    .word   WWDG_IRQHandler             /* 0x40: IRQ 0 */
+    .word   PVD_IRQHandler              /* 0x44: IRQ 1 */
+    .word   TAMPER_IRQHandler           /* 0x48: IRQ 2 */
+    .word   RTC_IRQHandler              /* 0x4C: IRQ 3 */
+    .word   FLASH_IRQHandler            /* 0x50: IRQ 4 */
+    .word   RCC_IRQHandler              /* 0x54: IRQ 5 */
+    .word   EXTI0_IRQHandler            /* 0x58: IRQ 6 */
+    .word   EXTI1_IRQHandler            /* 0x5C: IRQ 7 */
+    .word   EXTI2_IRQHandler            /* 0x60: IRQ 8 */
+    .word   EXTI3_IRQHandler            /* 0x64: IRQ 9 */
+    .word   EXTI4_IRQHandler            /* 0x68: IRQ 10 */
+    .word   DMA1_Channel1_IRQHandler    /* 0x6C: IRQ 11 */
+    .word   DMA1_Channel2_IRQHandler    /* 0x70: IRQ 12 */
+    .word   DMA1_Channel3_IRQHandler    /* 0x74: IRQ 13 */
+    .word   DMA1_Channel4_IRQHandler    /* 0x78: IRQ 14 */
+    .word   DMA1_Channel5_IRQHandler    /* 0x7C: IRQ 15 */
+    .word   DMA1_Channel6_IRQHandler    /* 0x80: IRQ 16 */
+    .word   DMA1_Channel7_IRQHandler    /* 0x84: IRQ 17 */
+    .word   ADC1_2_IRQHandler           /* 0x88: IRQ 18 */
+    .word   USB_HP_CAN1_TX_IRQHandler   /* 0x8C: IRQ 19 */
+    .word   USB_LP_CAN1_RX0_IRQHandler  /* 0x90: IRQ 20 */
+    .word   CAN1_RX1_IRQHandler         /* 0x94: IRQ 21 */
+    .word   CAN1_SCE_IRQHandler         /* 0x98: IRQ 22 */
+    .word   EXTI9_5_IRQHandler          /* 0x9C: IRQ 23 */
+    .word   TIM1_BRK_IRQHandler         /* 0xA0: IRQ 24 */
+    .word   TIM1_UP_IRQHandler          /* 0xA4: IRQ 25 */
+    .word   TIM1_TRG_COM_IRQHandler     /* 0xA8: IRQ 26 */
+    .word   TIM1_CC_IRQHandler          /* 0xAC: IRQ 27 */
+    .word   TIM2_IRQHandler             /* 0xB0: IRQ 28 */
+    .word   TIM3_IRQHandler             /* 0xB4: IRQ 29 */
+    .word   TIM4_IRQHandler             /* 0xB8: IRQ 30 */
+    .word   I2C1_EV_IRQHandler          /* 0xBC: IRQ 31 */
+    .word   I2C1_ER_IRQHandler          /* 0xC0: IRQ 32 */
+    .word   I2C2_EV_IRQHandler          /* 0xC4: IRQ 33 */
+    .word   I2C2_ER_IRQHandler          /* 0xC8: IRQ 34 */
+    .word   SPI1_IRQHandler             /* 0xCC: IRQ 35 */
+    .word   SPI2_IRQHandler             /* 0xD0: IRQ 36 */
+    .word   USART1_IRQHandler           /* 0xD4: IRQ 37 */
+    .word   USART2_IRQHandler           /* 0xD8: IRQ 38 */
+    .word   USART3_IRQHandler           /* 0xDC: IRQ 39 */
+    .word   EXTI15_10_IRQHandler        /* 0xE0: IRQ 40 */
+    .word   RTCAlarm_IRQHandler         /* 0xE4: IRQ 41 */
+    .word   USBWakeUp_IRQHandler        /* 0xE8: IRQ 42 */
+
 /* ========= Default Handler (vòng lặp vô hạn) ========= */
     .section .text.Default_Handler, "ax", %progbits
     .weak   Default_Handler
@@ -68,6 +113,135 @@ Default_Handler:
     .weak   SysTick_Handler
     .set    SysTick_Handler, Default_Handler
 
+    .weak   WWDG_IRQHandler
+    .set    WWDG_IRQHandler, Default_Handler
+
+    .weak   PVD_IRQHandler
+    .set    PVD_IRQHandler, Default_Handler
+
+    .weak   TAMPER_IRQHandler
+    .set    TAMPER_IRQHandler, Default_Handler
+
+    .weak   RTC_IRQHandler
+    .set    RTC_IRQHandler, Default_Handler
+
+    .weak   FLASH_IRQHandler
+    .set    FLASH_IRQHandler, Default_Handler
+
+    .weak   RCC_IRQHandler
+    .set    RCC_IRQHandler, Default_Handler
+
+    .weak   EXTI0_IRQHandler
+    .set    EXTI0_IRQHandler, Default_Handler
+
+    .weak   EXTI1_IRQHandler
+    .set    EXTI1_IRQHandler, Default_Handler
+
+    .weak   EXTI2_IRQHandler
+    .set    EXTI2_IRQHandler, Default_Handler
+
+    .weak   EXTI3_IRQHandler
+    .set    EXTI3_IRQHandler, Default_Handler
+
+    .weak   EXTI4_IRQHandler
+    .set    EXTI4_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel1_IRQHandler
+    .set    DMA1_Channel1_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel2_IRQHandler
+    .set    DMA1_Channel2_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel3_IRQHandler
+    .set    DMA1_Channel3_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel4_IRQHandler
+    .set    DMA1_Channel4_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel5_IRQHandler
+    .set    DMA1_Channel5_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel6_IRQHandler
+    .set    DMA1_Channel6_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel7_IRQHandler
+    .set    DMA1_Channel7_IRQHandler, Default_Handler
+
+    .weak   ADC1_2_IRQHandler
+    .set    ADC1_2_IRQHandler, Default_Handler
+
+    .weak   USB_HP_CAN1_TX_IRQHandler
+    .set    USB_HP_CAN1_TX_IRQHandler, Default_Handler
+
+    .weak   USB_LP_CAN1_RX0_IRQHandler
+    .set    USB_LP_CAN1_RX0_IRQHandler, Default_Handler
+
+    .weak   CAN1_RX1_IRQHandler
+    .set    CAN1_RX1_IRQHandler, Default_Handler
+
+    .weak   CAN1_SCE_IRQHandler
+    .set    CAN1_SCE_IRQHandler, Default_Handler
+
+    .weak   EXTI9_5_IRQHandler
+    .set    EXTI9_5_IRQHandler, Default_Handler
+
+    .weak   TIM1_BRK_IRQHandler
+    .set    TIM1_BRK_IRQHandler, Default_Handler
+
+    .weak   TIM1_UP_IRQHandler
+    .set    TIM1_UP_IRQHandler, Default_Handler
+
+    .weak   TIM1_TRG_COM_IRQHandler
+    .set    TIM1_TRG_COM_IRQHandler, Default_Handler
+
+    .weak   TIM1_CC_IRQHandler
+    .set    TIM1_CC_IRQHandler, Default_Handler
+
+    .weak   TIM2_IRQHandler
+    .set    TIM2_IRQHandler, Default_Handler
+
+    .weak   TIM3_IRQHandler
+    .set    TIM3_IRQHandler, Default_Handler
+
+    .weak   TIM4_IRQHandler
+    .set    TIM4_IRQHandler, Default_Handler
+
+    .weak   I2C1_EV_IRQHandler
+    .set    I2C1_EV_IRQHandler, Default_Handler
+
+    .weak   I2C1_ER_IRQHandler
+    .set    I2C1_ER_IRQHandler, Default_Handler
+
+    .weak   I2C2_EV_IRQHandler
+    .set    I2C2_EV_IRQHandler, Default_Handler
+
+    .weak   I2C2_ER_IRQHandler
+    .set    I2C2_ER_IRQHandler, Default_Handler
+
+    .weak   SPI1_IRQHandler
+    .set    SPI1_IRQHandler, Default_Handler
+
+    .weak   SPI2_IRQHandler
+    .set    SPI2_IRQHandler, Default_Handler
+
+    .weak   USART1_IRQHandler
+    .set    USART1_IRQHandler, Default_Handler
+
+    .weak   USART2_IRQHandler
+    .set    USART2_IRQHandler, Default_Handler
+
+    .weak   USART3_IRQHandler
+    .set    USART3_IRQHandler, Default_Handler
+
+    .weak   EXTI15_10_IRQHandler
+    .set    EXTI15_10_IRQHandler, Default_Handler
+
+    .weak   RTCAlarm_IRQHandler
+    .set    RTCAlarm_IRQHandler, Default_Handler
+
+    .weak   USBWakeUp_IRQHandler
+    .set    USBWakeUp_IRQHandler, Default_Handler
+
 /* ========= Reset Handler ========= */
     .section .text.Reset_Handler, "ax", %progbits
     .weak   Reset_Handler
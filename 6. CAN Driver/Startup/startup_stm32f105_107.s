@@ -0,0 +1,358 @@
+/*======== startup_stm32f105_107.s ===========
+      - Định nghĩa vector table cho STM32F105/107 (connectivity line, STM32F10X_CL)
+      - CAN1 và CAN2 có vector riêng, không dùng chung với USB như STM32F103
+      - Copy .data từ Flash vào RAM, clear .bss
+      - Gọi main(), vào vòng lặp vô hạn nếu main() trả về
+    ==========================================*/
+
+    .syntax unified
+    .cpu cortex-m3
+    .thumb
+
+/* ========= Vector Table ========= */
+    .section .isr_vector, "a", %progbits
+    .align  2
+    .type   g_pfnVectors, %object
+    .size   g_pfnVectors, .-g_pfnVectors
+
+g_pfnVectors:
+    .word   _estack                 /* 0x00: Initial Stack Pointer */
+    .word   Reset_Handler           /* 0x04: Reset Handler */
+    .word   NMI_Handler             /* 0x08: NMI Handler */
+    .word   HardFault_Handler       /* 0x0C: HardFault Handler */
+    .word   MemManage_Handler       /* 0x10: MemManage Handler */
+    .word   BusFault_Handler        /* 0x14: BusFault Handler */
+    .word   UsageFault_Handler      /* 0x18: UsageFault Handler */
+    .word   0                        /* 0x1C: Reserved */
+    .word   0                        /* 0x20: Reserved */
+    .word   0                        /* 0x24: Reserved */
+    .word   0                        /* 0x28: Reserved */
+    .word   SVC_Handler             /* 0x2C: SVCall Handler */
+    .word   DebugMon_Handler        /* 0x30: DebugMon Handler */
+    .word   0                        /* 0x34: Reserved */
+    .word   PendSV_Handler          /* 0x38: PendSV Handler */
+    .word   SysTick_Handler         /* 0x3C: SysTick Handler */
+
+    /* Ngắt ngoại vi (IRQ 0 .. 67, tới OTG_FS; CAN2 = IRQ 63 .. 66) */
+    .word   WWDG_IRQHandler             /* 0x40: IRQ 0 */
+    .word   PVD_IRQHandler              /* 0x44: IRQ 1 */
+    .word   TAMPER_IRQHandler           /* 0x48: IRQ 2 */
+    .word   RTC_IRQHandler              /* 0x4C: IRQ 3 */
+    .word   FLASH_IRQHandler            /* 0x50: IRQ 4 */
+    .word   RCC_IRQHandler              /* 0x54: IRQ 5 */
+    .word   EXTI0_IRQHandler            /* 0x58: IRQ 6 */
+    .word   EXTI1_IRQHandler            /* 0x5C: IRQ 7 */
+    .word   EXTI2_IRQHandler            /* 0x60: IRQ 8 */
+    .word   EXTI3_IRQHandler            /* 0x64: IRQ 9 */
+    .word   EXTI4_IRQHandler            /* 0x68: IRQ 10 */
+    .word   DMA1_Channel1_IRQHandler    /* 0x6C: IRQ 11 */
+    .word   DMA1_Channel2_IRQHandler    /* 0x70: IRQ 12 */
+    .word   DMA1_Channel3_IRQHandler    /* 0x74: IRQ 13 */
+    .word   DMA1_Channel4_IRQHandler    /* 0x78: IRQ 14 */
+    .word   DMA1_Channel5_IRQHandler    /* 0x7C: IRQ 15 */
+    .word   DMA1_Channel6_IRQHandler    /* 0x80: IRQ 16 */
+    .word   DMA1_Channel7_IRQHandler    /* 0x84: IRQ 17 */
+    .word   ADC1_2_IRQHandler           /* 0x88: IRQ 18 */
+    .word   CAN1_TX_IRQHandler          /* 0x8C: IRQ 19 */
+    .word   CAN1_RX0_IRQHandler         /* 0x90: IRQ 20 */
+    .word   CAN1_RX1_IRQHandler         /* 0x94: IRQ 21 */
+    .word   CAN1_SCE_IRQHandler         /* 0x98: IRQ 22 */
+    .word   EXTI9_5_IRQHandler          /* 0x9C: IRQ 23 */
+    .word   TIM1_BRK_IRQHandler         /* 0xA0: IRQ 24 */
+    .word   TIM1_UP_IRQHandler          /* 0xA4: IRQ 25 */
+    .word   TIM1_TRG_COM_IRQHandler     /* 0xA8: IRQ 26 */
+    .word   TIM1_CC_IRQHandler          /* 0xAC: IRQ 27 */
+    .word   TIM2_IRQHandler             /* 0xB0: IRQ 28 */
+    .word   TIM3_IRQHandler             /* 0xB4: IRQ 29 */
+    .word   TIM4_IRQHandler             /* 0xB8: IRQ 30 */
+    .word   I2C1_EV_IRQHandler          /* 0xBC: IRQ 31 */
+    .word   I2C1_ER_IRQHandler          /* 0xC0: IRQ 32 */
+    .word   I2C2_EV_IRQHandler          /* 0xC4: IRQ 33 */
+    .word   I2C2_ER_IRQHandler          /* 0xC8: IRQ 34 */
+    .word   SPI1_IRQHandler             /* 0xCC: IRQ 35 */
+    .word   SPI2_IRQHandler             /* 0xD0: IRQ 36 */
+    .word   USART1_IRQHandler           /* 0xD4: IRQ 37 */
+    .word   USART2_IRQHandler           /* 0xD8: IRQ 38 */
+    .word   USART3_IRQHandler           /* 0xDC: IRQ 39 */
+    .word   EXTI15_10_IRQHandler        /* 0xE0: IRQ 40 */
+    .word   RTCAlarm_IRQHandler         /* 0xE4: IRQ 41 */
+    .word   OTG_FS_WKUP_IRQHandler      /* 0xE8: IRQ 42 */
+    .word   0                           /* 0xEC: IRQ 43 (Reserved) */
+    .word   0                           /* 0xF0: IRQ 44 (Reserved) */
+    .word   0                           /* 0xF4: IRQ 45 (Reserved) */
+    .word   0                           /* 0xF8: IRQ 46 (Reserved) */
+    .word   0                           /* 0xFC: IRQ 47 (Reserved) */
+    .word   0                           /* 0x100: IRQ 48 (Reserved) */
+    .word   0                           /* 0x104: IRQ 49 (Reserved) */
+    .word   TIM5_IRQHandler             /* 0x108: IRQ 50 */
+    .word   SPI3_IRQHandler             /* 0x10C: IRQ 51 */
+    .word   UART4_IRQHandler            /* 0x110: IRQ 52 */
+    .word   UART5_IRQHandler            /* 0x114: IRQ 53 */
+    .word   TIM6_IRQHandler             /* 0x118: IRQ 54 */
+    .word   TIM7_IRQHandler             /* 0x11C: IRQ 55 */
+    .word   DMA2_Channel1_IRQHandler    /* 0x120: IRQ 56 */
+    .word   DMA2_Channel2_IRQHandler    /* 0x124: IRQ 57 */
+    .word   DMA2_Channel3_IRQHandler    /* 0x128: IRQ 58 */
+    .word   DMA2_Channel4_IRQHandler    /* 0x12C: IRQ 59 */
+    .word   DMA2_Channel5_IRQHandler    /* 0x130: IRQ 60 */
+    .word   ETH_IRQHandler              /* 0x134: IRQ 61 */
+    .word   ETH_WKUP_IRQHandler         /* 0x138: IRQ 62 */
+    .word   CAN2_TX_IRQHandler          /* 0x13C: IRQ 63 */
+    .word   CAN2_RX0_IRQHandler         /* 0x140: IRQ 64 */
+    .word   CAN2_RX1_IRQHandler         /* 0x144: IRQ 65 */
+    .word   CAN2_SCE_IRQHandler         /* 0x148: IRQ 66 */
+    .word   OTG_FS_IRQHandler           /* 0x14C: IRQ 67 */
+
+/* ========= Default Handler (vòng lặp vô hạn) ========= */
+    .section .text.Default_Handler, "ax", %progbits
+    .weak   Default_Handler
+    .type   Default_Handler, %function
+Default_Handler:
+    b   Default_Handler
+
+/* ========= Weak aliases cho tất cả các interrupt handlers ========= */
+/* Nếu user không định nghĩa riêng, chúng sẽ trỏ về Default_Handler */
+    .weak   NMI_Handler
+    .set    NMI_Handler, Default_Handler
+
+    .weak   HardFault_Handler
+    .set    HardFault_Handler, Default_Handler
+
+    .weak   MemManage_Handler
+    .set    MemManage_Handler, Default_Handler
+
+    .weak   BusFault_Handler
+    .set    BusFault_Handler, Default_Handler
+
+    .weak   UsageFault_Handler
+    .set    UsageFault_Handler, Default_Handler
+
+    .weak   SVC_Handler
+    .set    SVC_Handler, Default_Handler
+
+    .weak   DebugMon_Handler
+    .set    DebugMon_Handler, Default_Handler
+
+    .weak   PendSV_Handler
+    .set    PendSV_Handler, Default_Handler
+
+    .weak   SysTick_Handler
+    .set    SysTick_Handler, Default_Handler
+
+    .weak   WWDG_IRQHandler
+    .set    WWDG_IRQHandler, Default_Handler
+
+    .weak   PVD_IRQHandler
+    .set    PVD_IRQHandler, Default_Handler
+
+    .weak   TAMPER_IRQHandler
+    .set    TAMPER_IRQHandler, Default_Handler
+
+    .weak   RTC_IRQHandler
+    .set    RTC_IRQHandler, Default_Handler
+
+    .weak   FLASH_IRQHandler
+    .set    FLASH_IRQHandler, Default_Handler
+
+    .weak   RCC_IRQHandler
+    .set    RCC_IRQHandler, Default_Handler
+
+    .weak   EXTI0_IRQHandler
+    .set    EXTI0_IRQHandler, Default_Handler
+
+    .weak   EXTI1_IRQHandler
+    .set    EXTI1_IRQHandler, Default_Handler
+
+    .weak   EXTI2_IRQHandler
+    .set    EXTI2_IRQHandler, Default_Handler
+
+    .weak   EXTI3_IRQHandler
+    .set    EXTI3_IRQHandler, Default_Handler
+
+    .weak   EXTI4_IRQHandler
+    .set    EXTI4_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel1_IRQHandler
+    .set    DMA1_Channel1_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel2_IRQHandler
+    .set    DMA1_Channel2_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel3_IRQHandler
+    .set    DMA1_Channel3_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel4_IRQHandler
+    .set    DMA1_Channel4_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel5_IRQHandler
+    .set    DMA1_Channel5_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel6_IRQHandler
+    .set    DMA1_Channel6_IRQHandler, Default_Handler
+
+    .weak   DMA1_Channel7_IRQHandler
+    .set    DMA1_Channel7_IRQHandler, Default_Handler
+
+    .weak   ADC1_2_IRQHandler
+    .set    ADC1_2_IRQHandler, Default_Handler
+
+    .weak   CAN1_TX_IRQHandler
+    .set    CAN1_TX_IRQHandler, Default_Handler
+
+    .weak   CAN1_RX0_IRQHandler
+    .set    CAN1_RX0_IRQHandler, Default_Handler
+
+    .weak   CAN1_RX1_IRQHandler
+    .set    CAN1_RX1_IRQHandler, Default_Handler
+
+    .weak   CAN1_SCE_IRQHandler
+    .set    CAN1_SCE_IRQHandler, Default_Handler
+
+    .weak   EXTI9_5_IRQHandler
+    .set    EXTI9_5_IRQHandler, Default_Handler
+
+    .weak   TIM1_BRK_IRQHandler
+    .set    TIM1_BRK_IRQHandler, Default_Handler
+
+    .weak   TIM1_UP_IRQHandler
+    .set    TIM1_UP_IRQHandler, Default_Handler
+
+    .weak   TIM1_TRG_COM_IRQHandler
+    .set    TIM1_TRG_COM_IRQHandler, Default_Handler
+
+    .weak   TIM1_CC_IRQHandler
+    .set    TIM1_CC_IRQHandler, Default_Handler
+
+    .weak   TIM2_IRQHandler
+    .set    TIM2_IRQHandler, Default_Handler
+
+    .weak   TIM3_IRQHandler
+    .set    TIM3_IRQHandler, Default_Handler
+
+    .weak   TIM4_IRQHandler
+    .set    TIM4_IRQHandler, Default_Handler
+
+    .weak   I2C1_EV_IRQHandler
+    .set    I2C1_EV_IRQHandler, Default_Handler
+
+    .weak   I2C1_ER_IRQHandler
+    .set    I2C1_ER_IRQHandler, Default_Handler
+
+    .weak   I2C2_EV_IRQHandler
+    .set    I2C2_EV_IRQHandler, Default_Handler
+
+    .weak   I2C2_ER_IRQHandler
+    .set    I2C2_ER_IRQHandler, Default_Handler
+
+    .weak   SPI1_IRQHandler
+    .set    SPI1_IRQHandler, Default_Handler
+
+    .weak   SPI2_IRQHandler
+    .set    SPI2_IRQHandler, Default_Handler
+
+    .weak   USART1_IRQHandler
+    .set    USART1_IRQHandler, Default_Handler
+
+    .weak   USART2_IRQHandler
+    .set    USART2_IRQHandler, Default_Handler
+
+    .weak   USART3_IRQHandler
+    .set    USART3_IRQHandler, Default_Handler
+
+    .weak   EXTI15_10_IRQHandler
+    .set    EXTI15_10_IRQHandler, Default_Handler
+
+    .weak   RTCAlarm_IRQHandler
+    .set    RTCAlarm_IRQHandler, Default_Handler
+
+    .weak   OTG_FS_WKUP_IRQHandler
+    .set    OTG_FS_WKUP_IRQHandler, Default_Handler
+
+    .weak   TIM5_IRQHandler
+    .set    TIM5_IRQHandler, Default_Handler
+
+    .weak   SPI3_IRQHandler
+    .set    SPI3_IRQHandler, Default_Handler
+
+    .weak   UART4_IRQHandler
+    .set    UART4_IRQHandler, Default_Handler
+
+    .weak   UART5_IRQHandler
+    .set    UART5_IRQHandler, Default_Handler
+
+    .weak   TIM6_IRQHandler
+    .set    TIM6_IRQHandler, Default_Handler
+
+    .weak   TIM7_IRQHandler
+    .set    TIM7_IRQHandler, Default_Handler
+
+    .weak   DMA2_Channel1_IRQHandler
+    .set    DMA2_Channel1_IRQHandler, Default_Handler
+
+    .weak   DMA2_Channel2_IRQHandler
+    .set    DMA2_Channel2_IRQHandler, Default_Handler
+
+    .weak   DMA2_Channel3_IRQHandler
+    .set    DMA2_Channel3_IRQHandler, Default_Handler
+
+    .weak   DMA2_Channel4_IRQHandler
+    .set    DMA2_Channel4_IRQHandler, Default_Handler
+
+    .weak   DMA2_Channel5_IRQHandler
+    .set    DMA2_Channel5_IRQHandler, Default_Handler
+
+    .weak   ETH_IRQHandler
+    .set    ETH_IRQHandler, Default_Handler
+
+    .weak   ETH_WKUP_IRQHandler
+    .set    ETH_WKUP_IRQHandler, Default_Handler
+
+    .weak   CAN2_TX_IRQHandler
+    .set    CAN2_TX_IRQHandler, Default_Handler
+
+    .weak   CAN2_RX0_IRQHandler
+    .set    CAN2_RX0_IRQHandler, Default_Handler
+
+    .weak   CAN2_RX1_IRQHandler
+    .set    CAN2_RX1_IRQHandler, Default_Handler
+
+    .weak   CAN2_SCE_IRQHandler
+    .set    CAN2_SCE_IRQHandler, Default_Handler
+
+    .weak   OTG_FS_IRQHandler
+    .set    OTG_FS_IRQHandler, Default_Handler
+
+/* ========= Reset Handler ========= */
+    .section .text.Reset_Handler, "ax", %progbits
+    .weak   Reset_Handler
+    .type   Reset_Handler, %function
+Reset_Handler:
+    /* 1/ Copy .data từ Flash sang RAM */
+    LDR   R0, =_sidata      /* _sidata = địa chỉ đầu của vùng gốc .data trong Flash */
+    LDR   R1, =_sdata       /* _sdata = địa chỉ đầu vùng .data trong RAM */
+    LDR   R2, =_edata       /* _edata = địa chỉ kết thúc vùng .data trong RAM */
+copy_data_loop:
+    CMP   R1, R2            /* nếu R1 >= R2 thì dừng */
+    ITT   LT
+    LDRLT R3, [R0], #4      /* load 4 byte tại R0, R0 += 4 */
+    STRLT R3, [R1], #4      /* store 4 byte vào R1, R1 += 4 */
+    BLT   copy_data_loop
+
+    /* 2/ Clear .bss (set 0) */
+    LDR   R0, =_sbss        /* _sbss = địa chỉ đầu của vùng .bss trong RAM */
+    LDR   R1, =_ebss        /* _ebss = địa chỉ kết thúc vùng .bss trong RAM */
+    MOV   R2, #0
+clear_bss_loop:
+    CMP   R0, R1            /* nếu R0 >= R1 thì dừng */
+    ITT   LT
+    STRLT R2, [R0], #4      /* store 0 vào [R0], R0 += 4 */
+    BLT   clear_bss_loop
+
+    /* 3/ Gọi hàm main() */
+    BL    main
+
+    /* 4/ Nếu main() trả về, vào vòng lặp vô hạn */
+infinite_loop:
+    B    infinite_loop
+
+    .size Reset_Handler, .-Reset_Handler
\ No newline at end of file